@@ -1730,8 +1730,17 @@ module picorv32 #(
 						latched_store <= 1;
 						reg_out <= timer;
 						`debug($display("LD_RS1: %2d 0x%08x", decoded_rs1, cpuregs_rs1);)
-						timer <= cpuregs_rs1;
-						timer_reload <= cpuregs_rs1;
+						if (decoded_rs2[0]) begin
+							// timer add: move the next expiry by rs1 cycles and keep
+							// timer_reload, so the period and its phase are unchanged.
+							// the count of this cycle is applied as the count logic
+							// above would, a stopped timer stays stopped
+							if (timer)
+								timer <= (timer - 1 == 0 ? timer_reload : timer - 1) + cpuregs_rs1;
+						end else begin
+							timer <= cpuregs_rs1;
+							timer_reload <= cpuregs_rs1;
+						end
 						dbg_rs1val <= cpuregs_rs1;
 						dbg_rs1val_valid <= 1;
 						cpu_state <= cpu_state_fetch;
@@ -2544,7 +2553,20 @@ module picorv32_wb #(
 	parameter [31:0] LATCHED_IRQ = 32'h ffff_ffff,
 	parameter [31:0] PROGADDR_RESET = 32'h 0000_0000,
 	parameter [31:0] PROGADDR_IRQ = 32'h 0000_0010,
-	parameter [31:0] STACKADDR = 32'h ffff_ffff
+	parameter [31:0] STACKADDR = 32'h ffff_ffff,
+	parameter [ 0:0] ICACHE = 0,
+	parameter integer ICACHE_WAYS = 2,
+	parameter integer ICACHE_SETS = 64,
+	parameter integer ICACHE_LINE_WORDS = 8,
+	parameter [31:0] ICACHE_CTRL_ADDR = 32'h a000_0000,
+	parameter [ 0:0] DCACHE = 0,
+	parameter integer DCACHE_SETS = 64,
+	parameter integer DCACHE_LINE_WORDS = 8,
+	parameter [31:0] DCACHE_CTRL_ADDR = 32'h a000_0010,
+	parameter [31:0] DCACHE_RANGE0_BASE = 32'h 0000_0000,
+	parameter [31:0] DCACHE_RANGE0_MASK = 32'h fff8_0000,
+	parameter [31:0] DCACHE_RANGE1_BASE = 32'h 0048_0000,
+	parameter [31:0] DCACHE_RANGE1_MASK = 32'h fffc_0000
 ) (
 	output trap,
 
@@ -2552,14 +2574,16 @@ module picorv32_wb #(
 	input wb_rst_i,
 	input wb_clk_i,
 
-	output reg [31:0] wbm_adr_o,
-	output reg [31:0] wbm_dat_o,
+	output     [31:0] wbm_adr_o,
+	output     [31:0] wbm_dat_o,
 	input      [31:0] wbm_dat_i,
-	output reg        wbm_we_o,
-	output reg [3:0]  wbm_sel_o,
-	output reg        wbm_stb_o,
+	output            wbm_we_o,
+	output     [3:0]  wbm_sel_o,
+	output            wbm_stb_o,
 	input             wbm_ack_i,
-	output reg        wbm_cyc_o,
+	output            wbm_cyc_o,
+	output     [2:0]  wbm_cti_o,
+	output     [1:0]  wbm_bte_o,
 
 	// Pico Co-Processor Interface (PCPI)
 	output        pcpi_valid,
@@ -2614,6 +2638,39 @@ module picorv32_wb #(
 	wire clk;
 	wire resetn;
 
+	// instruction cache, see picorv32_icache.v
+	wire        ic_fetch;
+	wire        ic_ctrl;
+	wire        ic_ready;
+	wire [31:0] ic_rdata;
+	wire [31:0] ic_misses;
+	wire [31:0] ic_adr;
+	wire        ic_stb;
+	wire        ic_cyc;
+	wire [ 2:0] ic_cti;
+
+	// data cache, see picorv32_dcache.v
+	wire        dc_access;
+	wire        dc_ctrl;
+	wire        dc_ready;
+	wire [31:0] dc_rdata;
+	wire [31:0] dc_misses;
+	wire [31:0] dc_writebacks;
+	wire        dc_pending;
+	wire [31:0] dc_adr;
+	wire [31:0] dc_dat;
+	wire        dc_we;
+	wire        dc_stb;
+	wire        dc_cyc;
+	wire [ 2:0] dc_cti;
+
+	reg  [31:0] wb_adr;
+	reg  [31:0] wb_dat;
+	reg         wb_we;
+	reg  [3:0]  wb_sel;
+	reg         wb_stb;
+	reg         wb_cyc;
+
 	assign clk = wb_clk_i;
 	assign resetn = ~wb_rst_i;
 
@@ -2654,8 +2711,8 @@ module picorv32_wb #(
 		.mem_wstrb(mem_wstrb),
 		.mem_rstrb(mem_rstrb),
 		.mem_instr(mem_instr),
-		.mem_ready(mem_ready),
-		.mem_rdata(mem_rdata),
+		.mem_ready(mem_ready | ic_ready | dc_ready),
+		.mem_rdata(ic_ready ? ic_rdata : dc_ready ? dc_rdata : mem_rdata),
 
 		.pcpi_valid(pcpi_valid),
 		.pcpi_insn (pcpi_insn ),
@@ -2699,48 +2756,171 @@ module picorv32_wb #(
 	localparam WBSTART = 2'b01;
 	localparam WBEND   = 2'b10;
 
+	localparam [2:0] CTI_CLASSIC = 3'b000;
+	localparam [1:0] BTE_LINEAR  = 2'b00;
+
 	reg [1:0] state;
 
 	wire we;
 	assign we = (mem_wstrb[0] | mem_wstrb[1] | mem_wstrb[2] | mem_wstrb[3]);
 
+	// the cache fills own the bus while ic_cyc or dc_cyc, the state machine
+	// below is idle then: the core has a single request outstanding. the
+	// write back of the dcache write buffer may run after the request is
+	// done, nothing else starts on the bus while dc_pending
+	assign wbm_adr_o = ic_cyc ? ic_adr : dc_cyc ? dc_adr : wb_adr;
+	assign wbm_dat_o = dc_cyc ? dc_dat : wb_dat;
+	assign wbm_we_o  = dc_cyc ? dc_we  : wb_we;
+	assign wbm_sel_o = (ic_cyc | dc_cyc) ? 4'b1111 : wb_sel;
+	assign wbm_stb_o = ic_cyc ? ic_stb : dc_cyc ? dc_stb : wb_stb;
+	assign wbm_cyc_o = ic_cyc | dc_cyc | wb_cyc;
+	assign wbm_cti_o = ic_cyc ? ic_cti : dc_cyc ? dc_cti : CTI_CLASSIC;
+	assign wbm_bte_o = BTE_LINEAR;
+
+	generate if (ICACHE) begin : gen_icache
+		// fetches go to the cache, ICACHE_CTRL_ADDR is decoded here with
+		// no bus cycle: a read returns the miss count, a write invalidates
+		// the cache and clears the miss count
+		assign ic_fetch = mem_valid && mem_instr;
+		assign ic_ctrl  = mem_valid && !mem_instr && mem_addr == ICACHE_CTRL_ADDR;
+
+		picorv32_icache #(
+			.WAYS      (ICACHE_WAYS      ),
+			.SETS      (ICACHE_SETS      ),
+			.LINE_WORDS(ICACHE_LINE_WORDS)
+		) icache (
+			.clk        (clk   ),
+			.resetn     (resetn),
+			.invalidate (ic_ctrl && we && state == IDLE),
+			.misses     (ic_misses),
+			.fetch_valid(ic_fetch && !dc_pending),
+			.fetch_addr (mem_addr ),
+			.fetch_ready(ic_ready ),
+			.fetch_rdata(ic_rdata ),
+			.wbm_adr_o  (ic_adr   ),
+			.wbm_stb_o  (ic_stb   ),
+			.wbm_cyc_o  (ic_cyc   ),
+			.wbm_cti_o  (ic_cti   ),
+			.wbm_bte_o  (         ),
+			.wbm_dat_i  (wbm_dat_i),
+			.wbm_ack_i  (wbm_ack_i)
+		);
+	end else begin
+		assign ic_fetch  = 0;
+		assign ic_ctrl   = 0;
+		assign ic_ready  = 0;
+		assign ic_rdata  = 0;
+		assign ic_misses = 0;
+		assign ic_adr    = 0;
+		assign ic_stb    = 0;
+		assign ic_cyc    = 0;
+		assign ic_cti    = CTI_CLASSIC;
+	end endgenerate
+
+	generate if (DCACHE) begin : gen_dcache
+		// the loads and stores of the two ranges go to the cache, the rest
+		// (uart) is a classic cycle. DCACHE_CTRL_ADDR is the maintenance:
+		// a write of bit 0 writes back every dirty line, of bit 1 drops every
+		// line. a write of an address to DCACHE_CTRL_ADDR + 4 writes back and
+		// drops its line. a read returns the miss count, at + 4 the count of
+		// the lines written back
+		assign dc_access = mem_valid && !mem_instr &&
+				((mem_addr & DCACHE_RANGE0_MASK) == DCACHE_RANGE0_BASE ||
+				 (mem_addr & DCACHE_RANGE1_MASK) == DCACHE_RANGE1_BASE);
+		assign dc_ctrl   = mem_valid && !mem_instr && (mem_addr & ~32'h 4) == DCACHE_CTRL_ADDR;
+
+		picorv32_dcache #(
+			.SETS      (DCACHE_SETS      ),
+			.LINE_WORDS(DCACHE_LINE_WORDS)
+		) dcache (
+			.clk         (clk   ),
+			.resetn      (resetn),
+			.misses      (dc_misses    ),
+			.writebacks  (dc_writebacks),
+			.req_valid   (dc_access    ),
+			.req_addr    (mem_addr     ),
+			.req_wdata   (mem_wdata    ),
+			.req_wstrb   (mem_wstrb    ),
+			.ctl_valid   (dc_ctrl && we),
+			.ctl_all     (mem_addr[2] ? 2'b00 : mem_wdata[1:0]),
+			.ctl_line    (mem_addr[2]  ),
+			.ctl_addr    (mem_wdata    ),
+			.req_ready   (dc_ready     ),
+			.req_rdata   (dc_rdata     ),
+			.wbm_adr_o   (dc_adr       ),
+			.wbm_dat_o   (dc_dat       ),
+			.wbm_we_o    (dc_we        ),
+			.wbm_stb_o   (dc_stb       ),
+			.wbm_cyc_o   (dc_cyc       ),
+			.wbm_cti_o   (dc_cti       ),
+			.wbm_bte_o   (             ),
+			.wbm_dat_i   (wbm_dat_i    ),
+			.wbm_ack_i   (wbm_ack_i    ),
+			.wbuf_pending(dc_pending   ),
+			.bus_free    (!ic_cyc && !wb_cyc)
+		);
+	end else begin
+		assign dc_access     = 0;
+		assign dc_ctrl       = 0;
+		assign dc_ready      = 0;
+		assign dc_rdata      = 0;
+		assign dc_misses     = 0;
+		assign dc_writebacks = 0;
+		assign dc_pending    = 0;
+		assign dc_adr        = 0;
+		assign dc_dat        = 0;
+		assign dc_we         = 0;
+		assign dc_stb        = 0;
+		assign dc_cyc        = 0;
+		assign dc_cti        = CTI_CLASSIC;
+	end endgenerate
+
 	always @(posedge wb_clk_i) begin
 		if (wb_rst_i) begin
-			wbm_adr_o <= 0;
-			wbm_dat_o <= 0;
-			wbm_we_o  <= 0;
-			wbm_sel_o <= 0;
-			wbm_stb_o <= 0;
-			wbm_cyc_o <= 0;
+			wb_adr    <= 0;
+			wb_dat    <= 0;
+			wb_we     <= 0;
+			wb_sel    <= 0;
+			wb_stb    <= 0;
+			wb_cyc    <= 0;
 			state     <= IDLE;
 		end else begin
 			case (state)
 				IDLE: begin
-					if (mem_valid) begin
-						wbm_adr_o <= mem_addr;
-						wbm_dat_o <= mem_wdata;
-						wbm_we_o  <= we;
+					if (ic_ctrl || (dc_ctrl && !we)) begin
+						if (ic_ctrl)
+							mem_rdata <= ic_misses;
+						else if (mem_addr[2])
+							mem_rdata <= dc_writebacks;
+						else
+							mem_rdata <= dc_misses;
+						mem_ready <= 1'b1;
+						state     <= WBEND;
+					end else if (mem_valid && !ic_fetch && !dc_access && !dc_ctrl && !dc_pending) begin
+						wb_adr    <= mem_addr;
+						wb_dat    <= mem_wdata;
+						wb_we     <= we;
 						if (we)
-							wbm_sel_o <= mem_wstrb;
+							wb_sel <= mem_wstrb;
 						else
-							wbm_sel_o <= mem_rstrb;
-						wbm_stb_o <= 1'b1;
-						wbm_cyc_o <= 1'b1;
+							wb_sel <= mem_rstrb;
+						wb_stb    <= 1'b1;
+						wb_cyc    <= 1'b1;
 						state     <= WBSTART;
 					end else begin
 						mem_ready <= 1'b0;
-						wbm_stb_o <= 1'b0;
-						wbm_cyc_o <= 1'b0;
-						wbm_we_o  <= 1'b0;
+						wb_stb    <= 1'b0;
+						wb_cyc    <= 1'b0;
+						wb_we     <= 1'b0;
 					end
 				end
 				WBSTART:begin
 					if (wbm_ack_i) begin
 						mem_rdata <= wbm_dat_i;
 						mem_ready <= 1'b1;
-						wbm_stb_o <= 1'b0;
-						wbm_cyc_o <= 1'b0;
-						wbm_we_o  <= 1'b0;
+						wb_stb    <= 1'b0;
+						wb_cyc    <= 1'b0;
+						wb_we     <= 1'b0;
 						state     <= WBEND;
 					end
 				end
@@ -0,0 +1,297 @@
+/*
+ *  picorv32_dcache -- write-back data cache for picorv32_wb
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+`timescale 1 ns / 1 ps
+
+/***************************************************************
+ * picorv32_dcache
+ *
+ * Direct mapped, write-back, write-allocate cache of the data
+ * accesses, SETS lines of LINE_WORDS 32-bit words. picorv32_wb
+ * only sends the accesses of the cacheable ranges here. A hit,
+ * load or store, is done one cycle after the request.
+ *
+ * A miss fills the line with a Wishbone B3 incrementing burst.
+ * If the line replaced is dirty, its words are moved to the
+ * write buffer during the fill, as each is overwritten, and the
+ * access is done right after the fill. The write buffer is then
+ * written back with one burst as soon as the bus is free, while
+ * the core goes on with hits: all the stores of a line reach
+ * the memory in one burst. wbuf_pending asks picorv32_wb to
+ * start no other bus cycle until the write buffer is empty, a
+ * miss waits for it too.
+ *
+ * Maintenance requests (ctl_valid), done in order with the
+ * accesses and the write buffer written back first:
+ * - ctl_all[0]: write back every dirty line
+ * - ctl_all[1]: then drop every line
+ * - ctl_line:   write back the line of ctl_addr if dirty and
+ *               drop it
+ ***************************************************************/
+
+module picorv32_dcache #(
+	parameter integer SETS = 64,
+	parameter integer LINE_WORDS = 8
+) (
+	input clk,
+	input resetn,
+
+	output reg [31:0] misses,
+	output reg [31:0] writebacks,
+
+	// access from the core, held until req_ready
+	input             req_valid,
+	input      [31:0] req_addr,
+	input      [31:0] req_wdata,
+	input      [ 3:0] req_wstrb,
+
+	// maintenance request, held until req_ready
+	input             ctl_valid,
+	input      [ 1:0] ctl_all,
+	input             ctl_line,
+	input      [31:0] ctl_addr,
+
+	output reg        req_ready,
+	output reg [31:0] req_rdata,
+
+	// Wishbone master for the fills and write backs
+	output reg [31:0] wbm_adr_o,
+	output reg [31:0] wbm_dat_o,
+	output reg        wbm_we_o,
+	output reg        wbm_stb_o,
+	output reg        wbm_cyc_o,
+	output reg [ 2:0] wbm_cti_o,
+	output     [ 1:0] wbm_bte_o,
+	input      [31:0] wbm_dat_i,
+	input             wbm_ack_i,
+
+	// write buffer arbitration with the other bus cycles of picorv32_wb
+	output reg        wbuf_pending,
+	input             bus_free
+);
+	function integer log2;
+		input integer value;
+		begin
+			value = value - 1;
+			for (log2 = 0; value > 0; log2 = log2 + 1)
+				value = value >> 1;
+		end
+	endfunction
+
+	localparam [2:0] CTI_CLASSIC      = 3'b000;
+	localparam [2:0] CTI_INC_BURST    = 3'b010;
+	localparam [2:0] CTI_END_OF_BURST = 3'b111;
+	localparam [1:0] BTE_LINEAR       = 2'b00;
+
+	localparam integer OFFSET_BITS = log2(LINE_WORDS);
+	localparam integer INDEX_BITS  = log2(SETS);
+	localparam integer TAG_BITS    = 30 - OFFSET_BITS - INDEX_BITS;
+
+	localparam IDLE = 2'b00;
+	localparam FILL = 2'b01;
+	localparam WALK = 2'b10;	// maintenance, one line after the other
+	localparam WB   = 2'b11;	// write back of a line by a maintenance
+
+	reg [31:0]         data  [0:SETS*LINE_WORDS-1];
+	reg [TAG_BITS-1:0] tags  [0:SETS-1];
+	reg [SETS-1:0]     valid;
+	reg [SETS-1:0]     dirty;
+
+	reg [31:0]         wbuf  [0:LINE_WORDS-1];
+	reg [31:0]         wbuf_adr;
+	reg                draining;
+
+	reg [1:0]             state;
+	reg [OFFSET_BITS-1:0] cnt;
+	reg [OFFSET_BITS-1:0] drain_cnt;
+	reg                   victim_dirty;
+	reg [31:0]            victim_adr;
+
+	reg [INDEX_BITS-1:0]  walk_index;
+	reg [INDEX_BITS-1:0]  walk_last;
+	reg                   walk_check;	// only the line of walk_tag
+	reg [TAG_BITS-1:0]    walk_tag;
+	reg                   walk_flush;
+	reg                   walk_inval;
+
+	wire [OFFSET_BITS-1:0] offset = req_addr[2 +: OFFSET_BITS];
+	wire [INDEX_BITS-1:0]  index  = req_addr[2 + OFFSET_BITS +: INDEX_BITS];
+	wire [TAG_BITS-1:0]    tag    = req_addr[31 -: TAG_BITS];
+
+	wire hit = valid[index] && tags[index] == tag;
+
+	wire walk_sel = valid[walk_index] && (!walk_check || tags[walk_index] == walk_tag);
+
+	assign wbm_bte_o = BTE_LINEAR;
+
+	integer i;
+
+	always @(posedge clk) begin
+		if (!resetn) begin
+			valid        <= 0;
+			dirty        <= 0;
+			misses       <= 0;
+			writebacks   <= 0;
+			req_ready    <= 0;
+			wbuf_pending <= 0;
+			draining     <= 0;
+			wbm_we_o     <= 0;
+			wbm_stb_o    <= 0;
+			wbm_cyc_o    <= 0;
+			wbm_cti_o    <= CTI_CLASSIC;
+			state        <= IDLE;
+		end else begin
+			case (state)
+				IDLE: begin
+					req_ready <= 0;
+					if (ctl_valid && !req_ready && !wbuf_pending) begin
+						if (ctl_line) begin
+							walk_index <= ctl_addr[2 + OFFSET_BITS +: INDEX_BITS];
+							walk_last  <= ctl_addr[2 + OFFSET_BITS +: INDEX_BITS];
+							walk_check <= 1;
+							walk_tag   <= ctl_addr[31 -: TAG_BITS];
+							walk_flush <= 1;
+							walk_inval <= 1;
+						end else begin
+							walk_index <= 0;
+							walk_last  <= SETS - 1;
+							walk_check <= 0;
+							walk_flush <= ctl_all[0];
+							walk_inval <= ctl_all[1];
+						end
+						state <= WALK;
+					end else if (req_valid && !req_ready) begin
+						if (hit) begin
+							req_rdata <= data[{index, offset}];
+							for (i = 0; i < 4; i = i + 1)
+								if (req_wstrb[i])
+									data[{index, offset}][i*8 +: 8] <= req_wdata[i*8 +: 8];
+							if (|req_wstrb)
+								dirty[index] <= 1;
+							req_ready <= 1;
+						end else if (!wbuf_pending) begin
+							// the access is done by the hit path once the line is in
+							misses        <= misses + 1;
+							victim_dirty  <= valid[index] && dirty[index];
+							victim_adr    <= {tags[index], index, {OFFSET_BITS{1'b0}}, 2'b00};
+							valid[index]  <= 0;
+							dirty[index]  <= 0;
+							cnt           <= 0;
+							wbm_adr_o     <= {req_addr[31:2 + OFFSET_BITS], {OFFSET_BITS{1'b0}}, 2'b00};
+							wbm_we_o      <= 0;
+							wbm_cti_o     <= CTI_INC_BURST;
+							wbm_stb_o     <= 1;
+							wbm_cyc_o     <= 1;
+							state         <= FILL;
+						end
+					end
+				end
+				FILL: begin
+					if (wbm_ack_i) begin
+						wbuf[cnt] <= data[{index, cnt}];
+						data[{index, cnt}] <= wbm_dat_i;
+						cnt       <= cnt + 1;
+						wbm_adr_o <= wbm_adr_o + 4;
+						if (cnt == LINE_WORDS - 2)
+							wbm_cti_o <= CTI_END_OF_BURST;
+						if (cnt == LINE_WORDS - 1) begin
+							tags[index]  <= tag;
+							valid[index] <= 1;
+							wbuf_pending <= victim_dirty;
+							wbuf_adr     <= victim_adr;
+							wbm_stb_o    <= 0;
+							wbm_cyc_o    <= 0;
+							wbm_cti_o    <= CTI_CLASSIC;
+							state        <= IDLE;
+						end
+					end
+				end
+				WALK: begin
+					if (walk_sel && walk_flush && dirty[walk_index]) begin
+						cnt       <= 0;
+						wbm_adr_o <= {tags[walk_index], walk_index, {OFFSET_BITS{1'b0}}, 2'b00};
+						wbm_dat_o <= data[{walk_index, {OFFSET_BITS{1'b0}}}];
+						wbm_we_o  <= 1;
+						wbm_cti_o <= CTI_INC_BURST;
+						wbm_stb_o <= 1;
+						wbm_cyc_o <= 1;
+						state     <= WB;
+					end else begin
+						if (walk_sel && walk_inval)
+							valid[walk_index] <= 0;
+						if (walk_index == walk_last) begin
+							req_ready <= 1;
+							state     <= IDLE;
+						end else begin
+							walk_index <= walk_index + 1;
+						end
+					end
+				end
+				WB: begin
+					if (wbm_ack_i) begin
+						cnt       <= cnt + 1;
+						wbm_adr_o <= wbm_adr_o + 4;
+						wbm_dat_o <= data[{walk_index, cnt + 1'b1}];
+						if (cnt == LINE_WORDS - 2)
+							wbm_cti_o <= CTI_END_OF_BURST;
+						if (cnt == LINE_WORDS - 1) begin
+							dirty[walk_index] <= 0;
+							writebacks <= writebacks + 1;
+							wbm_we_o   <= 0;
+							wbm_stb_o  <= 0;
+							wbm_cyc_o  <= 0;
+							wbm_cti_o  <= CTI_CLASSIC;
+							state      <= WALK;
+						end
+					end
+				end
+			endcase
+
+			// write buffer, only pending while the state machine above
+			// keeps off the bus
+			if (wbuf_pending) begin
+				if (!draining) begin
+					if (bus_free) begin
+						drain_cnt <= 0;
+						draining  <= 1;
+						wbm_adr_o <= wbuf_adr;
+						wbm_dat_o <= wbuf[0];
+						wbm_we_o  <= 1;
+						wbm_cti_o <= CTI_INC_BURST;
+						wbm_stb_o <= 1;
+						wbm_cyc_o <= 1;
+					end
+				end else if (wbm_ack_i) begin
+					drain_cnt <= drain_cnt + 1;
+					wbm_adr_o <= wbm_adr_o + 4;
+					wbm_dat_o <= wbuf[drain_cnt + 1'b1];
+					if (drain_cnt == LINE_WORDS - 2)
+						wbm_cti_o <= CTI_END_OF_BURST;
+					if (drain_cnt == LINE_WORDS - 1) begin
+						writebacks   <= writebacks + 1;
+						wbuf_pending <= 0;
+						draining     <= 0;
+						wbm_we_o     <= 0;
+						wbm_stb_o    <= 0;
+						wbm_cyc_o    <= 0;
+						wbm_cti_o    <= CTI_CLASSIC;
+					end
+				end
+			end
+		end
+	end
+endmodule
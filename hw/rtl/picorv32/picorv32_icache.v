@@ -0,0 +1,181 @@
+/*
+ *  picorv32_icache -- instruction cache for picorv32_wb
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+`timescale 1 ns / 1 ps
+
+/***************************************************************
+ * picorv32_icache
+ *
+ * Direct mapped (WAYS = 1) or 2-way set associative (WAYS = 2)
+ * cache of the instruction fetches, SETS lines of LINE_WORDS
+ * 32-bit words. A hit is returned one cycle after the request.
+ * A miss fills the whole line with a Wishbone B3 incrementing
+ * burst from the line start, the last beat is marked with
+ * CTI_END_OF_BURST, then the fetched word is returned. A slave
+ * without burst support acks every beat as a classic cycle.
+ *
+ * The 2-way cache replaces the least recently used way. A line
+ * is invalid while it is filled, so an aborted fill (reset)
+ * never leaves a stale line behind.
+ *
+ * invalidate clears every line and the miss count in one
+ * cycle, for code loaded or modified by stores.
+ ***************************************************************/
+
+module picorv32_icache #(
+	parameter integer WAYS = 2,
+	parameter integer SETS = 64,
+	parameter integer LINE_WORDS = 8
+) (
+	input clk,
+	input resetn,
+
+	input             invalidate,
+	output reg [31:0] misses,
+
+	// fetch request from the core, held until fetch_ready
+	input             fetch_valid,
+	input      [31:0] fetch_addr,
+	output reg        fetch_ready,
+	output reg [31:0] fetch_rdata,
+
+	// Wishbone master for the line fills, read only
+	output reg [31:0] wbm_adr_o,
+	output reg        wbm_stb_o,
+	output reg        wbm_cyc_o,
+	output reg [ 2:0] wbm_cti_o,
+	output     [ 1:0] wbm_bte_o,
+	input      [31:0] wbm_dat_i,
+	input             wbm_ack_i
+);
+	function integer log2;
+		input integer value;
+		begin
+			value = value - 1;
+			for (log2 = 0; value > 0; log2 = log2 + 1)
+				value = value >> 1;
+		end
+	endfunction
+
+	localparam [2:0] CTI_CLASSIC      = 3'b000;
+	localparam [2:0] CTI_INC_BURST    = 3'b010;
+	localparam [2:0] CTI_END_OF_BURST = 3'b111;
+	localparam [1:0] BTE_LINEAR       = 2'b00;
+
+	localparam integer OFFSET_BITS = log2(LINE_WORDS);
+	localparam integer INDEX_BITS  = log2(SETS);
+	localparam integer TAG_BITS    = 30 - OFFSET_BITS - INDEX_BITS;
+
+	localparam IDLE = 1'b0;
+	localparam FILL = 1'b1;
+
+	// way 1 is never hit nor filled with WAYS = 1 and is optimised out
+	reg [31:0]         data0 [0:SETS*LINE_WORDS-1];
+	reg [31:0]         data1 [0:SETS*LINE_WORDS-1];
+	reg [TAG_BITS-1:0] tag0  [0:SETS-1];
+	reg [TAG_BITS-1:0] tag1  [0:SETS-1];
+	reg [SETS-1:0]     valid0;
+	reg [SETS-1:0]     valid1;
+	reg [SETS-1:0]     lru;		// way to replace next
+
+	reg                   state;
+	reg                   fill_way;
+	reg [OFFSET_BITS-1:0] fill_cnt;
+
+	wire [OFFSET_BITS-1:0] offset = fetch_addr[2 +: OFFSET_BITS];
+	wire [INDEX_BITS-1:0]  index  = fetch_addr[2 + OFFSET_BITS +: INDEX_BITS];
+	wire [TAG_BITS-1:0]    tag    = fetch_addr[31 -: TAG_BITS];
+
+	wire hit0 = valid0[index] && tag0[index] == tag;
+	wire hit1 = WAYS > 1 && valid1[index] && tag1[index] == tag;
+	wire victim = WAYS > 1 && lru[index];
+
+	assign wbm_bte_o = BTE_LINEAR;
+
+	always @(posedge clk) begin
+		if (!resetn) begin
+			valid0      <= 0;
+			valid1      <= 0;
+			lru         <= 0;
+			misses      <= 0;
+			fetch_ready <= 0;
+			wbm_stb_o   <= 0;
+			wbm_cyc_o   <= 0;
+			wbm_cti_o   <= CTI_CLASSIC;
+			state       <= IDLE;
+		end else begin
+			case (state)
+				IDLE: begin
+					fetch_ready <= 0;
+					if (invalidate) begin
+						valid0 <= 0;
+						valid1 <= 0;
+						misses <= 0;
+					end else if (fetch_valid && !fetch_ready) begin
+						if (hit0 || hit1) begin
+							fetch_rdata <= hit1 ? data1[{index, offset}] : data0[{index, offset}];
+							fetch_ready <= 1;
+							lru[index]  <= hit0;
+						end else begin
+							if (victim)
+								valid1[index] <= 0;
+							else
+								valid0[index] <= 0;
+							misses    <= misses + 1;
+							fill_way  <= victim;
+							fill_cnt  <= 0;
+							wbm_adr_o <= {fetch_addr[31:2 + OFFSET_BITS], {OFFSET_BITS{1'b0}}, 2'b00};
+							wbm_cti_o <= CTI_INC_BURST;
+							wbm_stb_o <= 1;
+							wbm_cyc_o <= 1;
+							state     <= FILL;
+						end
+					end
+				end
+				FILL: begin
+					if (wbm_ack_i) begin
+						if (fill_way)
+							data1[{index, fill_cnt}] <= wbm_dat_i;
+						else
+							data0[{index, fill_cnt}] <= wbm_dat_i;
+						if (fill_cnt == offset)
+							fetch_rdata <= wbm_dat_i;
+						fill_cnt  <= fill_cnt + 1;
+						wbm_adr_o <= wbm_adr_o + 4;
+						if (fill_cnt == LINE_WORDS - 2)
+							wbm_cti_o <= CTI_END_OF_BURST;
+						if (fill_cnt == LINE_WORDS - 1) begin
+							if (fill_way) begin
+								tag1[index]   <= tag;
+								valid1[index] <= 1;
+							end else begin
+								tag0[index]   <= tag;
+								valid0[index] <= 1;
+							end
+							lru[index]  <= !fill_way;
+							fetch_ready <= 1;
+							wbm_stb_o   <= 0;
+							wbm_cyc_o   <= 0;
+							wbm_cti_o   <= CTI_CLASSIC;
+							state       <= IDLE;
+						end
+					end
+				end
+			endcase
+		end
+	end
+endmodule
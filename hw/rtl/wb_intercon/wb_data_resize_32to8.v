@@ -55,8 +55,12 @@ module wb_data_resize_32to8
    assign wbs_cyc_o = wbm_cyc_i;
    assign wbs_stb_o = wbm_stb_i;
    assign wbs_we_o  = wbm_we_i;
-   assign wbs_cti_o = wbm_cti_i;
-   assign wbs_bte_o = wbm_bte_i;
+   // a burst of 32-bit words is not a burst of the 8-bit slave addresses
+   // above, each beat is passed on as a classic cycle. the master keeps
+   // the address of every beat valid as B3 requires, so a burst from a
+   // B3 master still completes, one classic cycle per beat
+   assign wbs_cti_o = 3'b000; // CTI_CLASSIC
+   assign wbs_bte_o = 2'b00;  // BTE_LINEAR
    // compose 32-bit data from 8-bit data
    assign wbm_dat_o = (wbm_we_i | ~wbs_ack_i) ? {32'b0} : (
                          wbm_sel_i[3] ? {wbs_dat_i, 24'b0       } :
@@ -121,6 +121,10 @@ endfunction
    wire support_burst;
    wire valid_phase;
    reg  valid_phase_r;
+   wire new_phase;
+   wire [AW-1:0] radr;
+   wire [AW-1:0] wadr;
+   wire [AW-1:0] next_burst_adr;
    reg [AW-1:0] burst_adr_r;
 
    assign valid_phase = wb_cyc_i & wb_stb_i;
@@ -144,7 +148,12 @@ endfunction
    // 3. start of end of burst (used for single xfer, where wb_ack_o is 0)
    assign new_phase = (valid_phase & !valid_phase_r) | (valid_phase & ((classic | end_of_burst) & ~wb_ack_o));
    assign next_burst_adr = wb_next_burst_adr(burst_adr_r, wb_cti_i, wb_bte_i);
-   assign adr = (new_phase) ? wb_adr_i : (burst) ? next_burst_adr : wb_adr_i;
+   assign radr = (new_phase) ? wb_adr_i : (burst) ? next_burst_adr : wb_adr_i;
+   // radr is one beat ahead during a burst (the read of the next beat),
+   // the data of the beat acked now belongs to burst_adr_r. the ram has a
+   // single port, a write cycle uses the write address only
+   assign wadr = (classic) ? wb_adr_i : burst_adr_r;
+   assign adr = (wb_we_i) ? wadr : radr;
    assign sram_we = wb_we_i & valid_phase & wb_ack_o;
 
    always @(posedge wb_clk_i)
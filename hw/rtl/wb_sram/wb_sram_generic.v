@@ -138,7 +138,9 @@ endfunction
    wire support_burst;
    wire valid_phase;
    reg  valid_phase_r;
+   wire new_phase;
    wire [AW-1:0] adr;
+   wire [AW-1:0] next_burst_adr;
    reg [AW-1:0] burst_adr_r;
 
    assign valid_phase = wb_cyc_i & wb_stb_i;
@@ -165,7 +167,9 @@ endfunction
    assign adr = (new_phase) ? wb_adr_i : ((burst) ? next_burst_adr : wb_adr_i);
    assign sram_we = wb_we_i & valid_phase & wb_ack_o;
    assign radr = adr;
-   assign wadr = adr;
+   // adr is one beat ahead during a burst (the read of the next beat),
+   // the data of the beat acked now belongs to burst_adr_r
+   assign wadr = (classic) ? wb_adr_i : burst_adr_r;
 
    always @(posedge wb_clk_i)
       if (wb_rst_i) begin
@@ -0,0 +1,365 @@
+`timescale 1ns/1ps
+
+// picorv32_dcache test
+//
+// A bus functional core loads and stores through picorv32_dcache, the line
+// fills and write backs go to a wb_sram_generic. Two lanes run the same
+// access stream, against a B3 sram (WB_B3 = 1) and a classic one. bus_free,
+// the other bus cycles of picorv32_wb, drops at random. Every load is checked
+// against a model of the memory as the core sees it, the stores have random
+// byte enables.
+//
+// The stream is a copy of 4 KB (twice the cache), random accesses in 8 KB
+// with one store in four, then the maintenance: after writing back every
+// dirty line the sram must match the model, a line written back and dropped
+// must be read again from the sram (a dma write), and so must every line
+// after dropping them all.
+//
+// Each lane prints the accesses, misses, write backs and cycles of every part
+// of the stream.
+//
+// run with SIM_TOP=dcache_tb, e.g. in sim/ncsim:
+// make clean; make run_ncsim SIM_TOP=dcache_tb
+
+module dcache_tb();
+
+reg		clk;
+reg		rst;
+
+wire		done_b3, done_cl;
+wire [31:0]	errors_b3, errors_cl;
+
+initial begin
+	clk = 1'b0;
+	forever #5 clk = ~clk;
+end
+
+dcache_tb_lane #(.WB_B3(1)) lane_b3 (.clk(clk), .rst(rst), .done(done_b3), .errors(errors_b3));
+dcache_tb_lane #(.WB_B3(0)) lane_cl (.clk(clk), .rst(rst), .done(done_cl), .errors(errors_cl));
+
+initial begin
+	rst = 1'b1;
+	repeat (4) @(posedge clk);
+	#1 rst = 1'b0;
+	wait (done_b3 && done_cl);
+	if (errors_b3 + errors_cl == 0)
+		$display("dcache_tb: PASS");
+	else
+		$display("dcache_tb: FAIL, %0d errors", errors_b3 + errors_cl);
+	$finish;
+end
+
+endmodule
+
+// one cache, its sram and an access stream
+module dcache_tb_lane #(
+	parameter WB_B3 = 0
+) (
+	input		clk,
+	input		rst,
+	output reg	done,
+	output reg [31:0] errors
+);
+
+localparam AW = 12;			// words of the sram, 16 KB
+localparam WORDS = (1 << AW);
+localparam TIMEOUT = 256;		// cycles without req_ready
+
+reg		req_valid;
+reg  [31:0]	req_addr;
+reg  [31:0]	req_wdata;
+reg   [3:0]	req_wstrb;
+reg		ctl_valid;
+reg   [1:0]	ctl_all;
+reg		ctl_line;
+reg  [31:0]	ctl_addr;
+wire		req_ready;
+wire [31:0]	req_rdata;
+wire [31:0]	misses;
+wire [31:0]	writebacks;
+wire		wbuf_pending;
+reg		bus_free;
+
+wire [31:0]	wb_adr;
+wire [31:0]	wb_dat_w;
+wire		wb_we;
+wire		wb_stb;
+wire		wb_cyc;
+wire  [2:0]	wb_cti;
+wire  [1:0]	wb_bte;
+wire [31:0]	wb_dat_r;
+wire		wb_ack;
+wire		wb_err;
+wire		wb_rty;
+
+// model of the memory seen by the core, word addressed
+reg  [31:0]	model [0:WORDS-1];
+
+integer		accesses;
+integer		cycles;
+integer		bus_seed;
+
+picorv32_dcache #(
+	.SETS      (64),
+	.LINE_WORDS(8)
+) dcache (
+	.clk         (clk),
+	.resetn      (!rst),
+	.misses      (misses),
+	.writebacks  (writebacks),
+	.req_valid   (req_valid),
+	.req_addr    (req_addr),
+	.req_wdata   (req_wdata),
+	.req_wstrb   (req_wstrb),
+	.ctl_valid   (ctl_valid),
+	.ctl_all     (ctl_all),
+	.ctl_line    (ctl_line),
+	.ctl_addr    (ctl_addr),
+	.req_ready   (req_ready),
+	.req_rdata   (req_rdata),
+	.wbm_adr_o   (wb_adr),
+	.wbm_dat_o   (wb_dat_w),
+	.wbm_we_o    (wb_we),
+	.wbm_stb_o   (wb_stb),
+	.wbm_cyc_o   (wb_cyc),
+	.wbm_cti_o   (wb_cti),
+	.wbm_bte_o   (wb_bte),
+	.wbm_dat_i   (wb_dat_r),
+	.wbm_ack_i   (wb_ack),
+	.wbuf_pending(wbuf_pending),
+	.bus_free    (bus_free)
+);
+
+wb_sram_generic #(
+	.AW    (AW),
+	.WB_B3 (WB_B3)
+) sram (
+	.wb_clk_i (clk),
+	.wb_rst_i (rst),
+	.wb_adr_i (wb_adr[AW+1:2]),
+	.wb_dat_i (wb_dat_w),
+	.wb_sel_i (4'hf),
+	.wb_we_i  (wb_we),
+	.wb_bte_i (wb_bte),
+	.wb_cti_i (wb_cti),
+	.wb_cyc_i (wb_cyc),
+	.wb_stb_i (wb_stb),
+	.wb_dat_o (wb_dat_r),
+	.wb_ack_o (wb_ack),
+	.wb_rty_o (wb_rty),
+	.wb_err_o (wb_err)
+);
+
+always @(posedge clk)
+	cycles <= cycles + 1;
+
+// the other bus cycles of picorv32_wb hold the write buffer back now and then
+always @(posedge clk) begin
+	bus_seed <= bus_seed * 1103515245 + 12345;
+	bus_free <= bus_seed[20:19] != 2'b00;
+end
+
+task wait_ready;
+	input [31:0] adr;
+	integer      wait_cycles;
+	begin
+		wait_cycles = 0;
+		@(posedge clk);
+		while (!req_ready) begin
+			wait_cycles = wait_cycles + 1;
+			if (wait_cycles > TIMEOUT) begin
+				$display("%t : ERROR!!! %m no req_ready, adr %h", $time, adr);
+				errors = errors + 1;
+				$finish;
+			end
+			@(posedge clk);
+		end
+	end
+endtask
+
+task load;
+	input [31:0] adr;
+	begin
+		#1;
+		req_valid = 1'b1;
+		req_addr  = adr;
+		req_wstrb = 4'h0;
+		wait_ready(adr);
+		if (req_rdata !== model[adr[AW+1:2]]) begin
+			$display("%t : ERROR!!! %m adr %h read %h expected %h",
+				$time, adr, req_rdata, model[adr[AW+1:2]]);
+			errors = errors + 1;
+		end
+		accesses = accesses + 1;
+		#1;
+		req_valid = 1'b0;
+	end
+endtask
+
+task store;
+	input [31:0] adr;
+	input [31:0] dat;
+	input  [3:0] strb;
+	integer      b;
+	begin
+		#1;
+		req_valid = 1'b1;
+		req_addr  = adr;
+		req_wdata = dat;
+		req_wstrb = strb;
+		wait_ready(adr);
+		for (b = 0; b < 4; b = b + 1)
+			if (strb[b])
+				model[adr[AW+1:2]][b*8 +: 8] = dat[b*8 +: 8];
+		accesses = accesses + 1;
+		#1;
+		req_valid = 1'b0;
+		req_wstrb = 4'h0;
+	end
+endtask
+
+task maintenance;
+	input  [1:0] all;
+	input        line;
+	input [31:0] adr;
+	begin
+		#1;
+		ctl_valid = 1'b1;
+		ctl_all   = all;
+		ctl_line  = line;
+		ctl_addr  = adr;
+		wait_ready(adr);
+		#1;
+		ctl_valid = 1'b0;
+		// the write buffer of the last miss may still be going out
+		while (wbuf_pending)
+			@(posedge clk);
+	end
+endtask
+
+// every word of the sram must match the model
+task check_sram;
+	input [8*8-1:0] name;
+	integer         k;
+	begin
+		for (k = 0; k < WORDS; k = k + 1)
+			if (sram.mem[k] !== model[k]) begin
+				if (errors < 10)
+					$display("%t : ERROR!!! %m %0s word %h sram %h expected %h",
+						$time, name, k << 2, sram.mem[k], model[k]);
+				errors = errors + 1;
+			end
+	end
+endtask
+
+integer i, seed;
+integer last_accesses, last_misses, last_writebacks, last_cycles;
+reg [31:0] adr, dat;
+
+task report;
+	input [8*8-1:0] name;
+	begin
+		$display("%m: %0s %0d accesses, %0d misses, %0d write backs, %0d cycles", name,
+			accesses - last_accesses, misses - last_misses,
+			writebacks - last_writebacks, cycles - last_cycles);
+		last_accesses   = accesses;
+		last_misses     = misses;
+		last_writebacks = writebacks;
+		last_cycles     = cycles;
+	end
+endtask
+
+initial begin
+	done      = 1'b0;
+	errors    = 0;
+	accesses  = 0;
+	cycles    = 0;
+	bus_seed  = 7;
+	req_valid = 1'b0;
+	req_addr  = 0;
+	req_wdata = 0;
+	req_wstrb = 4'h0;
+	ctl_valid = 1'b0;
+	ctl_all   = 2'b00;
+	ctl_line  = 1'b0;
+	ctl_addr  = 0;
+	seed      = 1;
+	for (i = 0; i < WORDS; i = i + 1) begin
+		model[i]    = {i[15:0] ^ 16'h5a5a, ~i[15:0]};
+		sram.mem[i] = model[i];
+	end
+	wait (!rst);
+	@(posedge clk);
+	last_accesses   = 0;
+	last_misses     = 0;
+	last_writebacks = 0;
+	last_cycles     = cycles;
+
+	// memcpy of 4 KB, 0x0000 to 0x2400, source and destination lines in
+	// different sets
+	for (i = 0; i < 1024; i = i + 1) begin
+		load(i << 2);
+		store(32'h2400 + (i << 2), model[i], 4'hf);
+	end
+	report("copy");
+
+	// random loads and stores in the first 8 KB, the same on both lanes
+	for (i = 0; i < 4000; i = i + 1) begin
+		seed = seed * 1103515245 + 12345;
+		adr = seed[23:13] << 2;
+		if (seed[27:26] == 2'b00) begin
+			dat = {seed[15:0], seed[31:16]} ^ i;
+			store(adr, dat, seed[11:8] == 4'h0 ? 4'hf : seed[11:8]);
+		end else begin
+			load(adr);
+		end
+	end
+	report("random");
+
+	// write back every dirty line, the sram must match
+	maintenance(2'b01, 1'b0, 0);
+	report("flush");
+	check_sram("flush");
+	if (misses != last_misses || writebacks == 0) begin
+		$display("%t : ERROR!!! %m flush, %0d write backs", $time, writebacks);
+		errors = errors + 1;
+	end
+
+	// dirty one line, drop it and change it behind the cache: the write
+	// back must reach the sram and the next load miss
+	load(32'h2100);
+	store(32'h2104, 32'h12345678, 4'hf);
+	maintenance(2'b00, 1'b1, 32'h2100);
+	check_sram("line");
+	for (i = 'h2100 >> 2; i < ('h2100 >> 2) + 8; i = i + 1) begin
+		model[i]    = ~model[i];
+		sram.mem[i] = model[i];
+	end
+	adr = misses;
+	for (i = 0; i < 8; i = i + 1)
+		load(32'h2100 + (i << 2));
+	if (misses != adr + 1) begin
+		$display("%t : ERROR!!! %m %0d misses reading a dropped line", $time, misses - adr);
+		errors = errors + 1;
+	end
+	report("line");
+
+	// write back and drop everything, then change the whole sram
+	maintenance(2'b11, 1'b0, 0);
+	report("drop");
+	check_sram("drop");
+	for (i = 0; i < WORDS; i = i + 1) begin
+		model[i]    = model[i] ^ 32'h0f0f_0f0f;
+		sram.mem[i] = model[i];
+	end
+	for (i = 0; i < 512; i = i + 1)
+		load(i << 2);
+	if (misses != last_misses + 64) begin
+		$display("%t : ERROR!!! %m %0d misses reading 2 KB after a drop", $time, misses - last_misses);
+		errors = errors + 1;
+	end
+	report("reload");
+	done = 1'b1;
+end
+
+endmodule
@@ -0,0 +1,251 @@
+`timescale 1ns/1ps
+
+// picorv32_icache test
+//
+// A bus functional core fetches through picorv32_icache, the line fills go
+// to a wb_sram_generic. Four lanes run the same fetch stream: the direct
+// mapped and the 2-way cache, each against a B3 sram (WB_B3 = 1) and a
+// classic one. The stream is a loop, two loops 2 KB apart (the same set of
+// both ways), a straight run longer than the cache and random fetches. Every
+// word fetched is checked against a model of the sram. Then the words of the
+// first loop are changed in the sram and the cache invalidated, the new
+// words must be fetched and the miss count must restart from 0.
+//
+// Each lane prints the fetches, misses and cycles of every part of the
+// stream.
+//
+// run with SIM_TOP=icache_tb, e.g. in sim/ncsim:
+// make clean; make run_ncsim SIM_TOP=icache_tb
+
+module icache_tb();
+
+reg		clk;
+reg		rst;
+
+wire		done_dm_b3, done_dm_cl, done_2w_b3, done_2w_cl;
+wire [31:0]	errors_dm_b3, errors_dm_cl, errors_2w_b3, errors_2w_cl;
+
+initial begin
+	clk = 1'b0;
+	forever #5 clk = ~clk;
+end
+
+icache_tb_lane #(.WAYS(1), .WB_B3(1)) lane_dm_b3 (.clk(clk), .rst(rst), .done(done_dm_b3), .errors(errors_dm_b3));
+icache_tb_lane #(.WAYS(1), .WB_B3(0)) lane_dm_cl (.clk(clk), .rst(rst), .done(done_dm_cl), .errors(errors_dm_cl));
+icache_tb_lane #(.WAYS(2), .WB_B3(1)) lane_2w_b3 (.clk(clk), .rst(rst), .done(done_2w_b3), .errors(errors_2w_b3));
+icache_tb_lane #(.WAYS(2), .WB_B3(0)) lane_2w_cl (.clk(clk), .rst(rst), .done(done_2w_cl), .errors(errors_2w_cl));
+
+initial begin
+	rst = 1'b1;
+	repeat (4) @(posedge clk);
+	#1 rst = 1'b0;
+	wait (done_dm_b3 && done_dm_cl && done_2w_b3 && done_2w_cl);
+	if (errors_dm_b3 + errors_dm_cl + errors_2w_b3 + errors_2w_cl == 0)
+		$display("icache_tb: PASS");
+	else
+		$display("icache_tb: FAIL, %0d errors",
+			errors_dm_b3 + errors_dm_cl + errors_2w_b3 + errors_2w_cl);
+	$finish;
+end
+
+endmodule
+
+// one cache, its sram and a fetch stream
+module icache_tb_lane #(
+	parameter WAYS = 1,
+	parameter WB_B3 = 0
+) (
+	input		clk,
+	input		rst,
+	output reg	done,
+	output reg [31:0] errors
+);
+
+localparam AW = 12;			// words of the sram, 16 KB
+localparam WORDS = (1 << AW);
+localparam TIMEOUT = 256;		// cycles without fetch_ready
+
+reg		fetch_valid;
+reg  [31:0]	fetch_addr;
+wire		fetch_ready;
+wire [31:0]	fetch_rdata;
+reg		invalidate;
+wire [31:0]	misses;
+
+wire [31:0]	wb_adr;
+wire		wb_stb;
+wire		wb_cyc;
+wire  [2:0]	wb_cti;
+wire  [1:0]	wb_bte;
+wire [31:0]	wb_dat_r;
+wire		wb_ack;
+wire		wb_err;
+wire		wb_rty;
+
+// model of the sram, word addressed
+reg  [31:0]	model [0:WORDS-1];
+
+integer		fetches;
+integer		cycles;
+
+picorv32_icache #(
+	.WAYS      (WAYS),
+	.SETS      (64),
+	.LINE_WORDS(8)
+) icache (
+	.clk        (clk),
+	.resetn     (!rst),
+	.invalidate (invalidate),
+	.misses     (misses),
+	.fetch_valid(fetch_valid),
+	.fetch_addr (fetch_addr),
+	.fetch_ready(fetch_ready),
+	.fetch_rdata(fetch_rdata),
+	.wbm_adr_o  (wb_adr),
+	.wbm_stb_o  (wb_stb),
+	.wbm_cyc_o  (wb_cyc),
+	.wbm_cti_o  (wb_cti),
+	.wbm_bte_o  (wb_bte),
+	.wbm_dat_i  (wb_dat_r),
+	.wbm_ack_i  (wb_ack)
+);
+
+wb_sram_generic #(
+	.AW    (AW),
+	.WB_B3 (WB_B3)
+) sram (
+	.wb_clk_i (clk),
+	.wb_rst_i (rst),
+	.wb_adr_i (wb_adr[AW+1:2]),
+	.wb_dat_i (32'h0),
+	.wb_sel_i (4'h0),
+	.wb_we_i  (1'b0),
+	.wb_bte_i (wb_bte),
+	.wb_cti_i (wb_cti),
+	.wb_cyc_i (wb_cyc),
+	.wb_stb_i (wb_stb),
+	.wb_dat_o (wb_dat_r),
+	.wb_ack_o (wb_ack),
+	.wb_rty_o (wb_rty),
+	.wb_err_o (wb_err)
+);
+
+always @(posedge clk)
+	cycles <= cycles + 1;
+
+task fetch;
+	input [31:0] adr;
+	integer      wait_cycles;
+	begin
+		#1;
+		fetch_valid = 1'b1;
+		fetch_addr  = adr;
+		wait_cycles = 0;
+		@(posedge clk);
+		while (!fetch_ready) begin
+			wait_cycles = wait_cycles + 1;
+			if (wait_cycles > TIMEOUT) begin
+				$display("%t : ERROR!!! %m no fetch_ready, adr %h", $time, adr);
+				errors = errors + 1;
+				$finish;
+			end
+			@(posedge clk);
+		end
+		if (fetch_rdata !== model[adr[AW+1:2]]) begin
+			$display("%t : ERROR!!! %m adr %h read %h expected %h",
+				$time, adr, fetch_rdata, model[adr[AW+1:2]]);
+			errors = errors + 1;
+		end
+		fetches = fetches + 1;
+		#1;
+		fetch_valid = 1'b0;
+	end
+endtask
+
+// a loop of words instructions from adr, run n times
+task run_loop;
+	input [31:0] adr;
+	input integer words;
+	input integer n;
+	integer       i, j;
+	begin
+		for (j = 0; j < n; j = j + 1)
+			for (i = 0; i < words; i = i + 1)
+				fetch(adr + (i << 2));
+	end
+endtask
+
+integer i, j, seed;
+integer last_fetches, last_misses, last_cycles;
+
+task report;
+	input [8*8-1:0] name;
+	begin
+		$display("%m: %0s %0d fetches, %0d misses, %0d cycles", name,
+			fetches - last_fetches, misses - last_misses, cycles - last_cycles);
+		last_fetches = fetches;
+		last_misses  = misses;
+		last_cycles  = cycles;
+	end
+endtask
+
+initial begin
+	done        = 1'b0;
+	errors      = 0;
+	fetches     = 0;
+	cycles      = 0;
+	fetch_valid = 1'b0;
+	fetch_addr  = 0;
+	invalidate  = 1'b0;
+	seed        = 1;
+	for (i = 0; i < WORDS; i = i + 1) begin
+		model[i]    = {i[15:0] ^ 16'h5a5a, ~i[15:0]};
+		sram.mem[i] = model[i];
+	end
+	wait (!rst);
+	@(posedge clk);
+	last_fetches = 0;
+	last_misses  = 0;
+	last_cycles  = cycles;
+
+	// a loop of 24 words
+	run_loop(32'h0100, 24, 20);
+	report("loop");
+	// two loops 2 KB apart, called in turn
+	for (j = 0; j < 10; j = j + 1) begin
+		run_loop(32'h1000, 16, 2);
+		run_loop(32'h1800, 16, 2);
+	end
+	report("2 loops");
+	// straight code longer than the cache
+	run_loop(32'h2000, 1024, 1);
+	report("straight");
+	// random fetches in the first 8 KB, the same on every lane
+	for (i = 0; i < 2000; i = i + 1) begin
+		seed = seed * 1103515245 + 12345;
+		fetch(seed[23:13] << 2);
+	end
+	report("random");
+
+	// new code in the first loop, then invalidate
+	for (i = 'h40; i < 'h40 + 24; i = i + 1) begin
+		model[i]    = ~model[i];
+		sram.mem[i] = model[i];
+	end
+	#1 invalidate = 1'b1;
+	@(posedge clk);
+	#1 invalidate = 1'b0;
+	@(posedge clk);
+	if (misses != 0) begin
+		$display("%t : ERROR!!! %m misses %0d after invalidate", $time, misses);
+		errors = errors + 1;
+	end
+	run_loop(32'h0100, 24, 2);
+	if (misses != 3) begin
+		$display("%t : ERROR!!! %m %0d misses refetching 3 lines", $time, misses);
+		errors = errors + 1;
+	end
+	done = 1'b1;
+end
+
+endmodule
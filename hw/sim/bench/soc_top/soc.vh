@@ -28,8 +28,29 @@
 
 `define PICORV32_COMPRESS_ISA 0
 
+// B3 burst support (CTI/BTE) in the srams: the cache line fills and write
+// backs of picorv32_wb are acked back-to-back, every other cycle without.
+// run sim/bench/wb_burst_tb before turning it on
 //`define SOC_BUS_WB_B3
 
+// instruction cache in picorv32_wb, 1 or 2 ways, line fills are B3 bursts.
+// ICACHE_CTRL_BASE is decoded in picorv32_wb: read the miss count, write to
+// invalidate
+//`define ICACHE_ENABLE
+`define ICACHE_WAYS       2
+`define ICACHE_SETS       64
+`define ICACHE_LINE_WORDS 8
+`define ICACHE_CTRL_BASE  32'hA0000000
+
+// write-back data cache in picorv32_wb, direct mapped, only SRAM0 and SRAM1
+// are cached. an evicted dirty line is written back with one burst from a
+// write buffer. DCACHE_CTRL_BASE (+ 4) is decoded in picorv32_wb: flush and
+// invalidate, see picorv32_dcache.v
+//`define DCACHE_ENABLE
+`define DCACHE_SETS       64
+`define DCACHE_LINE_WORDS 8
+`define DCACHE_CTRL_BASE  32'hA0000010
+
 `define SRAM0_TECH_GENERIC
 //`define SRAM0_TECH_ALTERA
 
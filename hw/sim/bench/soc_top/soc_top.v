@@ -181,7 +181,28 @@ wire        picorv32_mem_instr;
 picorv32_wb #(
 	.PROGADDR_RESET (`BOOT_PC),
 	.PROGADDR_IRQ   (`IRQ_PC),
-	.COMPRESSED_ISA (`PICORV32_COMPRESS_ISA)
+	.COMPRESSED_ISA (`PICORV32_COMPRESS_ISA),
+`ifdef ICACHE_ENABLE
+	.ICACHE           (1),
+	.ICACHE_WAYS      (`ICACHE_WAYS),
+	.ICACHE_SETS      (`ICACHE_SETS),
+	.ICACHE_LINE_WORDS(`ICACHE_LINE_WORDS),
+	.ICACHE_CTRL_ADDR (`ICACHE_CTRL_BASE),
+`else
+	.ICACHE           (0),
+`endif
+`ifdef DCACHE_ENABLE
+	.DCACHE            (1),
+	.DCACHE_SETS       (`DCACHE_SETS),
+	.DCACHE_LINE_WORDS (`DCACHE_LINE_WORDS),
+	.DCACHE_CTRL_ADDR  (`DCACHE_CTRL_BASE),
+	.DCACHE_RANGE0_BASE(`SRAM0_BASE),
+	.DCACHE_RANGE0_MASK(`SRAM0_MASK),
+	.DCACHE_RANGE1_BASE(`SRAM1_BASE),
+	.DCACHE_RANGE1_MASK(`SRAM1_MASK)
+`else
+	.DCACHE            (0)
+`endif
 ) picorv32_wb (
 	.wb_clk_i(wb_clk),
 	.wb_rst_i(wb_rst),
@@ -192,6 +213,8 @@ picorv32_wb #(
 	.wbm_dat_o(wb_m2s_picorv32_dat),
 	.wbm_we_o (wb_m2s_picorv32_we ),
 	.wbm_sel_o(wb_m2s_picorv32_sel),
+	.wbm_cti_o(wb_m2s_picorv32_cti),
+	.wbm_bte_o(wb_m2s_picorv32_bte),
 	.wbm_ack_i(wb_s2m_picorv32_ack),
 	.wbm_dat_i(wb_s2m_picorv32_dat),
 
@@ -204,10 +227,6 @@ picorv32_wb #(
 	.mem_instr(picorv32_mem_instr)
 );
 
-localparam [2:0] BTE_LINEAR = 2'b00;
-localparam [2:0] CTI_CLASSIC = 3'b000;
-assign wb_m2s_picorv32_bte = BTE_LINEAR;
-assign wb_m2s_picorv32_cti = CTI_CLASSIC;
 
 assign picorv32_irq[0]  = 0; // picorv32 timer irq
 assign picorv32_irq[1]  = 0; // ebreak/ecall/illegal insn
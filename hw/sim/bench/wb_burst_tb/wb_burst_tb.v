@@ -0,0 +1,324 @@
+`timescale 1ns/1ps
+
+// Wishbone B3 burst test
+//
+// A bus functional master drives wb_mux, like the picorv32_wb master of
+// soc_top, with two wb_sram_generic slaves behind it: sram_b3 (WB_B3 = 1)
+// and sram_classic (WB_B3 = 0). Every CTI (classic, constant burst,
+// incrementing burst, single end of burst) with every BTE (linear, wrap4,
+// wrap8, wrap16) is written then read back on both slaves, from a start
+// address that is not wrap aligned. The data read is checked against a
+// model of the memories, the B3 slave must also ack every burst beat
+// back-to-back.
+//
+// run with SIM_TOP=wb_burst_tb, e.g. in sim/ncsim:
+// make clean; make run_ncsim SIM_TOP=wb_burst_tb
+
+module wb_burst_tb();
+
+localparam [2:0] CTI_CLASSIC      = 3'b000;
+localparam [2:0] CTI_CONST_BURST  = 3'b001;
+localparam [2:0] CTI_INC_BURST    = 3'b010;
+localparam [2:0] CTI_END_OF_BURST = 3'b111;
+localparam [1:0] BTE_LINEAR       = 2'b00;
+localparam [1:0] BTE_WRAP4        = 2'b01;
+localparam [1:0] BTE_WRAP8        = 2'b10;
+localparam [1:0] BTE_WRAP16       = 2'b11;
+
+localparam AW = 8;			// words of each sram
+localparam WORDS = (1 << AW);
+localparam [31:0] SRAM_B3_BASE      = 32'h00000000;
+localparam [31:0] SRAM_CLASSIC_BASE = 32'h00000400;
+localparam [31:0] SRAM_MASK         = 32'hfffffc00;
+
+localparam TIMEOUT = 64;		// cycles without ack
+
+reg		clk;
+reg		rst;
+
+reg  [31:0]	wbm_adr;
+reg  [31:0]	wbm_dat;
+reg   [3:0]	wbm_sel;
+reg		wbm_we;
+reg		wbm_cyc;
+reg		wbm_stb;
+reg   [2:0]	wbm_cti;
+reg   [1:0]	wbm_bte;
+wire [31:0]	wbm_dat_i;
+wire		wbm_ack;
+wire		wbm_err;
+wire		wbm_rty;
+
+wire [31:0]	b3_adr,     cl_adr;
+wire [31:0]	b3_dat_w,   cl_dat_w;
+wire  [3:0]	b3_sel,     cl_sel;
+wire		b3_we,      cl_we;
+wire		b3_cyc,     cl_cyc;
+wire		b3_stb,     cl_stb;
+wire  [2:0]	b3_cti,     cl_cti;
+wire  [1:0]	b3_bte,     cl_bte;
+wire [31:0]	b3_dat_r,   cl_dat_r;
+wire		b3_ack,     cl_ack;
+wire		b3_err,     cl_err;
+wire		b3_rty,     cl_rty;
+
+// model of the two srams, word addressed
+reg  [31:0]	mem [0:2*WORDS-1];
+
+integer		errors;
+integer		bursts;
+
+initial begin
+	clk = 1'b0;
+	forever #5 clk = ~clk;
+end
+
+wb_mux #(
+	.NUM_SLAVES (2),
+	.MATCH_ADDR ({SRAM_B3_BASE, SRAM_CLASSIC_BASE}),
+	.MATCH_MASK ({SRAM_MASK, SRAM_MASK})
+) wb_mux0 (
+	.wb_clk_i  (clk),
+	.wb_rst_i  (rst),
+	.wbm_adr_i (wbm_adr),
+	.wbm_dat_i (wbm_dat),
+	.wbm_sel_i (wbm_sel),
+	.wbm_we_i  (wbm_we ),
+	.wbm_cyc_i (wbm_cyc),
+	.wbm_stb_i (wbm_stb),
+	.wbm_cti_i (wbm_cti),
+	.wbm_bte_i (wbm_bte),
+	.wbm_dat_o (wbm_dat_i),
+	.wbm_ack_o (wbm_ack),
+	.wbm_err_o (wbm_err),
+	.wbm_rty_o (wbm_rty),
+	.wbs_adr_o ({b3_adr,   cl_adr  }),
+	.wbs_dat_o ({b3_dat_w, cl_dat_w}),
+	.wbs_sel_o ({b3_sel,   cl_sel  }),
+	.wbs_we_o  ({b3_we,    cl_we   }),
+	.wbs_cyc_o ({b3_cyc,   cl_cyc  }),
+	.wbs_stb_o ({b3_stb,   cl_stb  }),
+	.wbs_cti_o ({b3_cti,   cl_cti  }),
+	.wbs_bte_o ({b3_bte,   cl_bte  }),
+	.wbs_dat_i ({b3_dat_r, cl_dat_r}),
+	.wbs_ack_i ({b3_ack,   cl_ack  }),
+	.wbs_err_i ({b3_err,   cl_err  }),
+	.wbs_rty_i ({b3_rty,   cl_rty  })
+);
+
+wb_sram_generic #(
+	.AW    (AW),
+	.WB_B3 (1)
+) sram_b3 (
+	.wb_clk_i (clk),
+	.wb_rst_i (rst),
+	.wb_adr_i (b3_adr[AW+1:2]),
+	.wb_dat_i (b3_dat_w),
+	.wb_sel_i (b3_sel),
+	.wb_we_i  (b3_we ),
+	.wb_bte_i (b3_bte),
+	.wb_cti_i (b3_cti),
+	.wb_cyc_i (b3_cyc),
+	.wb_stb_i (b3_stb),
+	.wb_dat_o (b3_dat_r),
+	.wb_ack_o (b3_ack),
+	.wb_rty_o (b3_rty),
+	.wb_err_o (b3_err)
+);
+
+wb_sram_generic #(
+	.AW    (AW),
+	.WB_B3 (0)
+) sram_classic (
+	.wb_clk_i (clk),
+	.wb_rst_i (rst),
+	.wb_adr_i (cl_adr[AW+1:2]),
+	.wb_dat_i (cl_dat_w),
+	.wb_sel_i (cl_sel),
+	.wb_we_i  (cl_we ),
+	.wb_bte_i (cl_bte),
+	.wb_cti_i (cl_cti),
+	.wb_cyc_i (cl_cyc),
+	.wb_stb_i (cl_stb),
+	.wb_dat_o (cl_dat_r),
+	.wb_ack_o (cl_ack),
+	.wb_rty_o (cl_rty),
+	.wb_err_o (cl_err)
+);
+
+// word address of beat n of a burst starting at word w
+function [31:0] beat_adr;
+	input [31:0] w;
+	input [2:0]  cti;
+	input [1:0]  bte;
+	input integer n;
+	reg   [31:0] len;
+	begin
+		case (bte)
+		BTE_WRAP4:  len = 4;
+		BTE_WRAP8:  len = 8;
+		BTE_WRAP16: len = 16;
+		default:    len = 0;
+		endcase
+		if (cti == CTI_CONST_BURST)
+			beat_adr = w;
+		else if (cti != CTI_INC_BURST || len == 0)
+			beat_adr = w + n;
+		else
+			beat_adr = (w & ~(len - 1)) | ((w + n) & (len - 1));
+	end
+endfunction
+
+// model index of a bus byte address
+function integer mem_index;
+	input [31:0] adr;
+	begin
+		mem_index = adr[AW+1:2] + (((adr & SRAM_MASK) == SRAM_CLASSIC_BASE) ? WORDS : 0);
+	end
+endfunction
+
+// one Wishbone cycle of beats transfers starting at byte address adr. a
+// classic (or single end of burst) transfer is a cycle per beat, a burst
+// is one cycle with CTI_END_OF_BURST on the last beat, as picorv32_wb does
+task xfer;
+	input        we;
+	input [2:0]  cti;
+	input [1:0]  bte;
+	input [31:0] adr;
+	input integer beats;
+	input        back_to_back;	// a burst must be acked every cycle
+	integer      n;
+	integer      wait_cycles;
+	integer      acked;
+	reg   [31:0] a;
+	reg   [31:0] d;
+	begin
+		n = 0;
+		acked = 0;
+		while (n < beats) begin
+			a = beat_adr(adr >> 2, cti, bte, n) << 2;
+			d = {adr[15:0] ^ {cti, bte, 11'h0}, n[7:0], 7'h0, we} ^ bursts;
+			#1;
+			wbm_adr = a;
+			wbm_dat = d;
+			wbm_we  = we;
+			wbm_sel = 4'hf;
+			wbm_cyc = 1'b1;
+			wbm_stb = 1'b1;
+			if (cti == CTI_CLASSIC || cti == CTI_END_OF_BURST || n == beats - 1)
+				wbm_cti = (cti == CTI_CLASSIC) ? CTI_CLASSIC : CTI_END_OF_BURST;
+			else
+				wbm_cti = cti;
+			wbm_bte = bte;
+
+			wait_cycles = 0;
+			@(posedge clk);
+			while (!wbm_ack) begin
+				wait_cycles = wait_cycles + 1;
+				if (wait_cycles > TIMEOUT) begin
+					$display("%t : ERROR!!! no ack, cti %b bte %b adr %h beat %0d", $time, cti, bte, a, n);
+					errors = errors + 1;
+					$finish;
+				end
+				if (back_to_back && acked && (cti == CTI_CONST_BURST || cti == CTI_INC_BURST)) begin
+					$display("%t : ERROR!!! burst beat not back-to-back, cti %b bte %b adr %h beat %0d", $time, cti, bte, a, n);
+					errors = errors + 1;
+					acked = 0;
+				end
+				@(posedge clk);
+			end
+			acked = 1;
+
+			if (we) begin
+				mem[mem_index(a)] = d;
+			end else if (wbm_dat_i !== mem[mem_index(a)]) begin
+				$display("%t : ERROR!!! cti %b bte %b adr %h beat %0d read %h expected %h",
+					$time, cti, bte, a, n, wbm_dat_i, mem[mem_index(a)]);
+				errors = errors + 1;
+			end
+
+			// a classic cycle ends with every transfer
+			if (cti == CTI_CLASSIC || cti == CTI_END_OF_BURST || n == beats - 1) begin
+				#1;
+				wbm_cyc = 1'b0;
+				wbm_stb = 1'b0;
+				wbm_we  = 1'b0;
+				wbm_cti = CTI_CLASSIC;
+				wbm_bte = BTE_LINEAR;
+				@(posedge clk);
+				acked = 0;
+			end
+			n = n + 1;
+		end
+		bursts = bursts + 1;
+	end
+endtask
+
+integer i, c, b, s;
+reg [2:0]  cti;
+reg [1:0]  bte;
+reg [31:0] base;
+reg [31:0] start;
+integer    beats;
+
+initial begin
+	errors  = 0;
+	bursts  = 0;
+	wbm_adr = 0;
+	wbm_dat = 0;
+	wbm_sel = 0;
+	wbm_we  = 0;
+	wbm_cyc = 0;
+	wbm_stb = 0;
+	wbm_cti = CTI_CLASSIC;
+	wbm_bte = BTE_LINEAR;
+	rst     = 1'b1;
+	repeat (4) @(posedge clk);
+	#1 rst  = 1'b0;
+	@(posedge clk);
+
+	// known contents for both srams
+	for (i = 0; i < WORDS; i = i + 1) begin
+		xfer(1, CTI_CLASSIC, BTE_LINEAR, SRAM_B3_BASE + (i << 2), 1, 0);
+		xfer(1, CTI_CLASSIC, BTE_LINEAR, SRAM_CLASSIC_BASE + (i << 2), 1, 0);
+	end
+
+	for (s = 0; s < 2; s = s + 1) begin
+		base = s ? SRAM_CLASSIC_BASE : SRAM_B3_BASE;
+		for (c = 0; c < 4; c = c + 1) begin
+			case (c)
+			0: cti = CTI_CLASSIC;
+			1: cti = CTI_CONST_BURST;
+			2: cti = CTI_INC_BURST;
+			3: cti = CTI_END_OF_BURST;
+			endcase
+			for (b = 0; b < 4; b = b + 1) begin
+				bte = b;
+				case (bte)
+				BTE_WRAP4:  beats = 4;
+				BTE_WRAP8:  beats = 8;
+				BTE_WRAP16: beats = 16;
+				default:    beats = 11;
+				endcase
+				// only an incrementing burst wraps, the others must
+				// stay in the 16 word block
+				if (cti != CTI_INC_BURST && beats > 13)
+					beats = 13;
+				// not wrap aligned, so the wrapping bursts wrap
+				start = base + ((16 * (c * 4 + b) + 3) << 2);
+				xfer(1, cti, bte, start, beats, s == 0);
+				xfer(0, cti, bte, start, beats, s == 0);
+				// the other words of the block must be untouched
+				xfer(0, CTI_CLASSIC, BTE_LINEAR, start & ~32'h3f, 16, 0);
+			end
+		end
+	end
+
+	if (errors == 0)
+		$display("wb_burst_tb: PASS, %0d cycles checked", bursts);
+	else
+		$display("wb_burst_tb: FAIL, %0d errors", errors);
+	$finish;
+end
+
+endmodule
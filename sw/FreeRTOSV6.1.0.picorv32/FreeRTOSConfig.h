@@ -71,7 +71,7 @@
 /*----------------------------------------------------------*/
 
 #define configUSE_PREEMPTION			1
-#define configUSE_IDLE_HOOK			0
+#define configUSE_IDLE_HOOK			1
 #define configUSE_TICK_HOOK			1
 #define configCPU_CLOCK_HZ			( ( unsigned portLONG ) IN_CLK )
 #define configTICK_RATE_HZ			( ( portTickType ) HZ )
@@ -82,10 +82,66 @@
 #define configUSE_TRACE_FACILITY		0
 #define configUSE_16_BIT_TICKS			0
 #define configIDLE_SHOULD_YIELD			0
-#define configUSE_MUTEXE			1
-
-/* Co-routine definitions. */
-#define configUSE_CO_ROUTINES 			0
+#define configUSE_MUTEXES			1
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION	1
+#define configUSE_TASK_NOTIFICATIONS		1
+#define configSUPPORT_STATIC_ALLOCATION		1
+#define configUSE_QUEUE_SETS			1
+
+/* Stop the tick while every task is blocked and sleep in waitirq, see
+vPortSuppressTicksAndSleep() in port.c.  Needs the timer add instruction of
+hw/rtl/picorv32/picorv32.v.  The tick hook is not called for the ticks
+skipped by a sleep. */
+#define configUSE_TICKLESS_IDLE			0
+#define configEXPECTED_IDLE_TIME_BEFORE_SLEEP	2
+
+/* Keep the delayed tasks in a two level timing wheel of 2^configDELAY_WHEEL_BITS
+slots per level instead of a sorted list: delaying a task no longer walks the
+other delayed tasks.  See demo/dbench.c. */
+#define configUSE_DELAY_WHEEL			0
+#define configDELAY_WHEEL_BITS			6
+
+/* Per task cycle counts, see CPU_STATS_ENABLE in board.h. */
+#ifdef CPU_STATS_ENABLE
+#define configGENERATE_CYCLE_STATS		1
+#else
+#define configGENERATE_CYCLE_STATS		0
+#endif
+
+/* Stack depth and high water mark of every task, see STACK_STATS_ENABLE in
+board.h.  The stacks are always painted.  The overflow check run at every
+switch compares the saved stack pointer with the stack limit; with the stack
+stats the painted bytes at the limit are checked as well. */
+#ifdef STACK_STATS_ENABLE
+#define configGENERATE_STACK_STATS		1
+#define configCHECK_FOR_STACK_OVERFLOW		2
+#else
+#define configGENERATE_STACK_STATS		0
+#define configCHECK_FOR_STACK_OVERFLOW		1
+#endif
+
+/* Acquisition counts, hold and wait times of every mutex, see
+LOCK_STATS_ENABLE in board.h.  The report names the mutexes added to the
+queue registry with vQueueAddToRegistry(). */
+#ifdef LOCK_STATS_ENABLE
+#define configGENERATE_LOCK_STATS		1
+#define configQUEUE_REGISTRY_SIZE		8
+#else
+#define configGENERATE_LOCK_STATS		0
+#endif
+
+/* The task that sets the event group bits for the interrupts, see
+event_groups.h.  It runs above the tasks it wakes. */
+#define configEVENT_GROUP_DAEMON_PRIORITY	( configMAX_PRIORITIES - 1 )
+#define configEVENT_GROUP_DAEMON_STACK_DEPTH	( ( unsigned portSHORT ) 256 )
+#define configEVENT_GROUP_QUEUE_LENGTH		8
+
+/* Co-routine definitions.  The co-routines run from the idle hook in main.c,
+on the stack of the idle task, so a delayed co-routine is only woken while
+no task is ready.  With configUSE_TICKLESS_IDLE the idle task does not sleep
+past the wake time of a delayed co-routine, see
+xCoRoutineGetExpectedIdleTime(). */
+#define configUSE_CO_ROUTINES 			1
 #define configMAX_CO_ROUTINE_PRIORITIES		( 2 )
 
 /* Set the following definitions to 1 to include the API function, or zero
@@ -99,7 +155,9 @@ to exclude the API function. */
 #define INCLUDE_vTaskDelayUntil			0 /* for saving image space, I disable it */
 #define INCLUDE_vTaskDelay			1
 
-#define INCLUDE_xTaskGetCurrentTaskHandle	0 //for debug only
-#define INCLUDE_uxTaskGetStackHighWaterMark	0 //for debug only
+#define INCLUDE_xTaskGetCurrentTaskHandle	1 //used by the profiler
+#define INCLUDE_pcTaskGetTaskName		1 //used by the profiler
+#define INCLUDE_xEventGroupSetBitsFromISR	1 //starts the event group daemon
+#define INCLUDE_uxTaskGetStackHighWaterMark	1 //used by the stack stats
 
 #endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,183 @@
+/*
+ * Co-routine benchmark.
+ *
+ * cbenchCOROUTINES co-routines wake every 1 to cbenchMAX_PERIOD ticks with
+ * crDELAY() and count their runs.  Their control blocks are static, a
+ * co-routine has no stack of its own and runs on the stack of the idle task,
+ * which calls vCoRoutineSchedule() from the idle hook.  The memory they take
+ * is compared with what the same number of tasks with configMINIMAL_STACK_SIZE
+ * words of stack would take.
+ *
+ * Two higher priority co-routines then exchange cbenchSWITCHES messages
+ * through two queues of length 1 (crQUEUE_SEND() and crQUEUE_RECEIVE()), each
+ * send readies the other co-routine and yields to it.  The cycles per switch
+ * are measured with the cycle counter, the tick irqs and the tasks that run
+ * in between included, compare with the task switches of demo/ybench.c.
+ *
+ * The bench task starts the exchange by sending to a co-routine queue with
+ * crQUEUE_SEND_FROM_ISR() in a critical section and gets the result from a
+ * co-routine through a task queue, the two ways tasks and co-routines can
+ * exchange data.
+ *
+ * Output:
+ *
+ * CBENCH <n> coroutines <bytes> bytes, <n> tasks <bytes> bytes
+ * CBENCH switch <cycles/switch> periodic runs <runs>
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "croutine.h"
+
+/* Hardware specific definitions. */
+#include "system.h"
+
+#include "cbench.h"
+
+#define cbenchCOROUTINES		( 48 )
+#define cbenchMAX_PERIOD		( 8 )
+#define cbenchSWITCHES			( 10000UL )
+#define cbenchSTACK_SIZE		configMINIMAL_STACK_SIZE
+
+/* The ping and pong co-routines run before the periodic ones. */
+#define cbenchPERIODIC_PRIORITY	( 0 )
+#define cbenchPING_PRIORITY		( 1 )
+
+static void prvPeriodicCoRoutine( xCoRoutineHandle xHandle, unsigned portBASE_TYPE uxIndex );
+static void prvPingCoRoutine( xCoRoutineHandle xHandle, unsigned portBASE_TYPE uxIndex );
+static void prvPongCoRoutine( xCoRoutineHandle xHandle, unsigned portBASE_TYPE uxIndex );
+static void prvBenchTask( void *pvParameters );
+
+static corCRCB xPeriodicCRCB[ cbenchCOROUTINES ];
+static corCRCB xPingCRCB, xPongCRCB;
+static volatile unsigned long ulPeriodicRuns = 0;
+
+/* Start is sent by the bench task to the ping co-routine, ping and pong
+between the co-routines, the result by the ping co-routine to the task. */
+static xQueueHandle xStartQueue, xPingQueue, xPongQueue, xResultQueue;
+
+/*-----------------------------------------------------------*/
+
+void vStartCoRoutineBench( unsigned portBASE_TYPE uxPriority )
+{
+unsigned portBASE_TYPE ux;
+
+	xStartQueue = xQueueCreate( 1, sizeof( unsigned long ) );
+	xPingQueue = xQueueCreate( 1, sizeof( unsigned long ) );
+	xPongQueue = xQueueCreate( 1, sizeof( unsigned long ) );
+	xResultQueue = xQueueCreate( 1, sizeof( unsigned long ) );
+
+	/* Co-routines are created before the scheduler is started, the idle task
+	walks their lists once it runs. */
+	for( ux = 0; ux < cbenchCOROUTINES; ux++ )
+	{
+		xCoRoutineCreateStatic( prvPeriodicCoRoutine, cbenchPERIODIC_PRIORITY, ux, &xPeriodicCRCB[ ux ] );
+	}
+	xCoRoutineCreateStatic( prvPingCoRoutine, cbenchPING_PRIORITY, 0, &xPingCRCB );
+	xCoRoutineCreateStatic( prvPongCoRoutine, cbenchPING_PRIORITY, 0, &xPongCRCB );
+
+	xTaskCreate( prvBenchTask, ( signed char * ) "CBench", cbenchSTACK_SIZE, NULL, uxPriority, NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvPeriodicCoRoutine( xCoRoutineHandle xHandle, unsigned portBASE_TYPE uxIndex )
+{
+	crSTART( xHandle );
+
+	for( ;; )
+	{
+		ulPeriodicRuns++;
+		crDELAY( xHandle, ( portTickType ) ( 1 + ( uxIndex % cbenchMAX_PERIOD ) ) );
+	}
+
+	crEND();
+}
+/*-----------------------------------------------------------*/
+
+static void prvPingCoRoutine( xCoRoutineHandle xHandle, unsigned portBASE_TYPE uxIndex )
+{
+/* Co-routines have no stack of their own, everything that must survive a
+block is static. */
+static unsigned long ulRound, ulValue, ulCycles;
+static unsigned long long ullStart;
+static portBASE_TYPE xResult;
+
+	( void ) uxIndex;
+
+	crSTART( xHandle );
+
+	for( ;; )
+	{
+		crQUEUE_RECEIVE( xHandle, xStartQueue, &ulValue, portMAX_DELAY, &xResult );
+
+		ullStart = get_cycles64();
+		for( ulRound = 0; ulRound < cbenchSWITCHES / 2; ulRound++ )
+		{
+			crQUEUE_SEND( xHandle, xPingQueue, &ulRound, 0, &xResult );
+			crQUEUE_RECEIVE( xHandle, xPongQueue, &ulValue, portMAX_DELAY, &xResult );
+		}
+		ulCycles = ( unsigned long ) ( ( get_cycles64() - ullStart ) / cbenchSWITCHES );
+
+		/* A co-routine must not block on a task queue. */
+		xQueueSend( xResultQueue, &ulCycles, 0 );
+	}
+
+	crEND();
+}
+/*-----------------------------------------------------------*/
+
+static void prvPongCoRoutine( xCoRoutineHandle xHandle, unsigned portBASE_TYPE uxIndex )
+{
+static unsigned long ulValue;
+static portBASE_TYPE xResult;
+
+	( void ) uxIndex;
+
+	crSTART( xHandle );
+
+	for( ;; )
+	{
+		crQUEUE_RECEIVE( xHandle, xPingQueue, &ulValue, portMAX_DELAY, &xResult );
+		crQUEUE_SEND( xHandle, xPongQueue, &ulValue, 0, &xResult );
+	}
+
+	crEND();
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchTask( void *pvParameters )
+{
+unsigned long ulStart = 0, ulCycles;
+
+	/* Stop warnings. */
+	( void ) pvParameters;
+
+	printf( "CBENCH %u coroutines %u bytes, %u tasks %u bytes\n",
+			( unsigned int ) cbenchCOROUTINES,
+			( unsigned int ) ( cbenchCOROUTINES * sizeof( corCRCB ) ),
+			( unsigned int ) cbenchCOROUTINES,
+			( unsigned int ) ( cbenchCOROUTINES * ( sizeof( xStaticTask ) + cbenchSTACK_SIZE * sizeof( portSTACK_TYPE ) ) ) );
+
+	/* Give the periodic co-routines a second to run. */
+	vTaskDelay( configTICK_RATE_HZ );
+
+	/* A task sends to a co-routine queue the way an interrupt does. */
+	taskENTER_CRITICAL();
+	{
+		( void ) crQUEUE_SEND_FROM_ISR( xStartQueue, &ulStart, pdFALSE );
+	}
+	taskEXIT_CRITICAL();
+
+	xQueueReceive( xResultQueue, &ulCycles, portMAX_DELAY );
+
+	printf( "CBENCH switch %u periodic runs %u\n", ( unsigned int ) ulCycles, ( unsigned int ) ulPeriodicRuns );
+
+	/* Nothing left to do. */
+	vTaskSuspend( NULL );
+	for( ;; );
+}
@@ -0,0 +1,11 @@
+#ifndef CBENCH_H
+#define CBENCH_H
+
+/*
+ * Runs a few dozen periodic co-routines from the idle hook, measures the
+ * memory of a co-routine against a task and the cycles of a switch between
+ * two co-routines, and prints the results on the console.
+ */
+void vStartCoRoutineBench( unsigned portBASE_TYPE uxPriority );
+
+#endif /* CBENCH_H */
@@ -0,0 +1,152 @@
+/*
+ * Delayed task list benchmark.
+ *
+ * dbenchTASKS tasks wake every 1 to dbenchMAX_PERIOD ticks with vTaskDelay()
+ * and go straight back to sleep, a few of them with a period longer than the
+ * delay wheel, so the kernel time is spent adding tasks to the delayed list
+ * and waking them from it.  A lower priority task spins on the cycle counter
+ * and adds up the gaps, which is the time taken by everything else, over
+ * dbenchTICKS ticks before the periodic tasks are created and again with
+ * them running.
+ *
+ * Build with configUSE_DELAY_WHEEL set to 0 and to 1 and compare:
+ *
+ * DBENCH idle <cycles/tick>
+ * DBENCH <tasks> tasks <wakeups/tick> wakeups/tick <cycles/tick> cycles/tick <cycles/wakeup> cycles/wakeup
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Hardware specific definitions. */
+#include "system.h"
+
+#include "dbench.h"
+
+#define dbenchTASKS				( 192 )
+#define dbenchMAX_PERIOD		( 100 )
+#define dbenchFAR_PERIOD		( 5000 )
+#define dbenchTICKS				( ( portTickType ) 200 )
+#define dbenchSTACK_SIZE		( 256 )
+
+/* A gap in the spin loop longer than this was taken by another task or an
+interrupt. */
+#define dbenchGAP_CYCLES		( 400UL )
+
+static void prvPeriodicTask( void *pvParameters );
+static void prvMeasureTask( void *pvParameters );
+static unsigned long prvMeasure( portTickType xTicks );
+
+static unsigned portBASE_TYPE uxPeriodicPriority;
+static xTaskHandle xPeriodic[ dbenchTASKS ];
+static volatile unsigned long ulWakeups = 0;
+
+/* Too big for the heap, the TCBs and stacks are placed in SRAM1. */
+static xStaticTask xPeriodicTCB[ dbenchTASKS ] __sram1;
+static portSTACK_TYPE xPeriodicStack[ dbenchTASKS ][ dbenchSTACK_SIZE ] __sram1;
+
+/*-----------------------------------------------------------*/
+
+void vStartDelayBench( unsigned portBASE_TYPE uxPriority )
+{
+	uxPeriodicPriority = uxPriority + 1;
+	xTaskCreate( prvMeasureTask, ( signed char * ) "DBench", configMINIMAL_STACK_SIZE, NULL, uxPriority, NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvMeasureTask( void *pvParameters )
+{
+unsigned long ulIdle, ulLoaded, ulWakeupsPerTick, ulPerWakeup;
+portTickType xPeriod;
+unsigned portBASE_TYPE ux;
+
+	/* Stop warnings. */
+	( void ) pvParameters;
+
+	ulIdle = prvMeasure( dbenchTICKS );
+	printf( "DBENCH idle %u\n", ( unsigned int ) ulIdle );
+
+	for( ux = 0; ux < dbenchTASKS; ux++ )
+	{
+		if( ( ux % 32 ) == 31 )
+		{
+			xPeriod = dbenchFAR_PERIOD;
+		}
+		else
+		{
+			xPeriod = 1 + ( ( ux * 37 ) % dbenchMAX_PERIOD );
+		}
+		xTaskCreateStatic( prvPeriodicTask, ( signed char * ) "DBenchP", dbenchSTACK_SIZE, ( void * ) xPeriod, uxPeriodicPriority, &( xPeriodic[ ux ] ), xPeriodicStack[ ux ], &( xPeriodicTCB[ ux ] ) );
+	}
+
+	/* Let the periods spread before measuring. */
+	vTaskDelay( dbenchMAX_PERIOD );
+
+	ulWakeups = 0;
+	ulLoaded = prvMeasure( dbenchTICKS );
+	ulWakeupsPerTick = ulWakeups / dbenchTICKS;
+
+	for( ux = 0; ux < dbenchTASKS; ux++ )
+	{
+		vTaskSuspend( xPeriodic[ ux ] );
+	}
+
+	ulPerWakeup = 0;
+	if( ( ulWakeupsPerTick != 0 ) && ( ulLoaded > ulIdle ) )
+	{
+		ulPerWakeup = ( ulLoaded - ulIdle ) / ulWakeupsPerTick;
+	}
+	printf( "DBENCH %u tasks %u wakeups/tick %u cycles/tick %u cycles/wakeup, delay wheel %s\n",
+			( unsigned int ) dbenchTASKS, ( unsigned int ) ulWakeupsPerTick, ( unsigned int ) ulLoaded,
+			( unsigned int ) ulPerWakeup, configUSE_DELAY_WHEEL ? "on" : "off" );
+
+	/* Nothing left to do. */
+	vTaskSuspend( NULL );
+	for( ;; );
+}
+/*-----------------------------------------------------------*/
+
+/* Returns the cycles per tick not given to the calling task. */
+static unsigned long prvMeasure( portTickType xTicks )
+{
+unsigned long long ullTaken = 0;
+unsigned long ulLast, ulNow;
+portTickType xStart;
+
+	/* Start on a tick. */
+	xStart = xTaskGetTickCount();
+	while( xTaskGetTickCount() == xStart );
+	xStart++;
+
+	ulLast = rdcycle();
+	while( ( xTaskGetTickCount() - xStart ) < xTicks )
+	{
+		ulNow = rdcycle();
+		if( ( ulNow - ulLast ) > dbenchGAP_CYCLES )
+		{
+			ullTaken += ulNow - ulLast;
+		}
+		ulLast = ulNow;
+	}
+
+	return ( unsigned long ) ( ullTaken / xTicks );
+}
+/*-----------------------------------------------------------*/
+
+static void prvPeriodicTask( void *pvParameters )
+{
+portTickType xPeriod = ( portTickType ) pvParameters;
+
+	for( ;; )
+	{
+		vTaskDelay( xPeriod );
+
+		portENTER_CRITICAL();
+		ulWakeups++;
+		portEXIT_CRITICAL();
+	}
+}
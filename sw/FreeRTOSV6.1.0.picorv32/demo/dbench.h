@@ -0,0 +1,11 @@
+#ifndef DBENCH_H
+#define DBENCH_H
+
+/*
+ * Measures the kernel time taken by a few hundred periodic tasks, to compare
+ * the sorted delayed lists with the delay wheel (configUSE_DELAY_WHEEL), and
+ * prints the results on the console.
+ */
+void vStartDelayBench( unsigned portBASE_TYPE uxPriority );
+
+#endif /* DBENCH_H */
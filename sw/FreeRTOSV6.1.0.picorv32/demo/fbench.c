@@ -0,0 +1,128 @@
+/*
+ * Instruction fetch benchmark.
+ *
+ * Measures the code paths that the instruction cache (ICACHE_ENABLE, see
+ * board.h and hw/rtl/picorv32/picorv32_icache.v) should speed up, to be run
+ * once on a core built without the cache and once with it:
+ *
+ * - loop: the cycles of one iteration of an empty loop, four instructions
+ *   fetched again and again.
+ * - crc: the cycles of a bitwise CRC-32 of fbenchBUF_SIZE bytes, a short
+ *   loop with a call per byte.
+ * - cold: the same CRC-32 right after icache_invalidate(), every line of
+ *   the code is fetched from the SRAM once.  misses is the count of line
+ *   fills of that run, 0 without the cache.
+ *
+ * The runs are made with irq off so the tick handler does not evict lines
+ * or add its cycles.
+ *
+ * Output:
+ *
+ * FBENCH fetch loop <cycles> crc <cycles> cold <cycles> misses <count>
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Hardware specific definitions. */
+#include "system.h"
+#include "cache.h"
+
+#include "fbench.h"
+
+#define fbenchLOOPS				( 10000UL )
+#define fbenchCRC_RUNS			( 16UL )
+#define fbenchBUF_SIZE			( 256 )
+#define fbenchSTACK_SIZE		configMINIMAL_STACK_SIZE
+
+static void prvFetchBenchTask( void *pvParameters );
+
+static unsigned char ucBuffer[ fbenchBUF_SIZE ];
+
+/*-----------------------------------------------------------*/
+
+static unsigned long __attribute__ ((noinline)) prvCrc32Byte( unsigned long ulCrc, unsigned char ucByte )
+{
+unsigned long ulBit;
+
+	ulCrc ^= ucByte;
+	for( ulBit = 0; ulBit < 8; ulBit++ )
+	{
+		ulCrc = ( ulCrc >> 1 ) ^ ( 0xedb88320UL & -( ulCrc & 1UL ) );
+	}
+
+	return ulCrc;
+}
+
+static unsigned long __attribute__ ((noinline)) prvCrc32( const unsigned char *pucData, unsigned long ulLength )
+{
+unsigned long ulCrc = 0xffffffffUL;
+
+	while( ulLength-- > 0 )
+	{
+		ulCrc = prvCrc32Byte( ulCrc, *pucData++ );
+	}
+
+	return ~ulCrc;
+}
+/*-----------------------------------------------------------*/
+
+void vStartFetchBench( unsigned portBASE_TYPE uxPriority )
+{
+	xTaskCreate( prvFetchBenchTask, ( signed char * ) "FBench", fbenchSTACK_SIZE, NULL, uxPriority, NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvFetchBenchTask( void *pvParameters )
+{
+unsigned long ulStart, ulLoop, ulCrc, ulCold, ulMisses, ul;
+volatile unsigned long ulSum = 0;
+
+	/* Stop warnings. */
+	( void ) pvParameters;
+
+	for( ul = 0; ul < fbenchBUF_SIZE; ul++ )
+	{
+		ucBuffer[ ul ] = ( unsigned char ) ( ul * 7 + 3 );
+	}
+
+	portENTER_CRITICAL();
+	{
+		/* The empty asm keeps the loop from being removed. */
+		ulStart = rdcycle();
+		for( ul = 0; ul < fbenchLOOPS; ul++ )
+		{
+			__asm__ __volatile__ ( "" : : : "memory" );
+		}
+		ulLoop = rdcycle() - ulStart;
+
+		/* Cold first: nothing of the CRC code has been fetched yet. */
+		icache_invalidate();
+		ulStart = rdcycle();
+		ulSum += prvCrc32( ucBuffer, fbenchBUF_SIZE );
+		ulCold = rdcycle() - ulStart;
+		ulMisses = icache_misses();
+
+		ulStart = rdcycle();
+		for( ul = 0; ul < fbenchCRC_RUNS; ul++ )
+		{
+			ulSum += prvCrc32( ucBuffer, fbenchBUF_SIZE );
+		}
+		ulCrc = rdcycle() - ulStart;
+	}
+	portEXIT_CRITICAL();
+
+	printf( "FBENCH fetch loop %u crc %u cold %u misses %u\n",
+			( unsigned int ) ( ulLoop / fbenchLOOPS ),
+			( unsigned int ) ( ulCrc / fbenchCRC_RUNS ),
+			( unsigned int ) ulCold,
+			( unsigned int ) ulMisses );
+
+	/* Nothing left to do. */
+	vTaskSuspend( NULL );
+	for( ;; );
+}
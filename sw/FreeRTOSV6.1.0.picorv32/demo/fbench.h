@@ -0,0 +1,10 @@
+#ifndef FBENCH_H
+#define FBENCH_H
+
+/*
+ * Measures the cycles of an empty loop and of a CRC-32, warm and right after
+ * an instruction cache invalidate, and prints the results on the console.
+ */
+void vStartFetchBench( unsigned portBASE_TYPE uxPriority );
+
+#endif /* FBENCH_H */
@@ -0,0 +1,124 @@
+/*
+ * Critical section benchmark.
+ *
+ * Enters and leaves an empty critical section ibenchLOOPS times three ways:
+ *
+ * - inline: portENTER_CRITICAL()/portEXIT_CRITICAL(), the ctlirq instruction
+ *   and the nesting count inlined at the call site.
+ * - call: vPortEnterCritical()/vPortExitCritical(), one call on each side.
+ * - old: the path before the irq functions were inlined, a call to the
+ *   critical section function which calls the one instruction irq function.
+ *
+ * The cycles of the loop itself are measured first and subtracted.  The run
+ * is in a task with the tick irq on, the irqs that land between two critical
+ * sections are included.
+ *
+ * Output:
+ *
+ * IBENCH critical inline <cycles> call <cycles> old <cycles>
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Hardware specific definitions. */
+#include "system.h"
+
+#include "ibench.h"
+
+#define ibenchLOOPS				( 100000UL )
+#define ibenchSTACK_SIZE		configMINIMAL_STACK_SIZE
+
+static void prvCriticalBenchTask( void *pvParameters );
+
+/*-----------------------------------------------------------*/
+
+/* The out of line irq functions as start.S had them. */
+static void __attribute__ ((noinline)) prvOldIrqDisable( void )
+{
+	picorv32_ctlirq( 0 );
+}
+
+static void __attribute__ ((noinline)) prvOldIrqEnable( void )
+{
+	picorv32_ctlirq( 1 );
+}
+
+static void __attribute__ ((noinline)) prvOldEnterCritical( void )
+{
+	prvOldIrqDisable();
+	ulCriticalNesting++;
+}
+
+static void __attribute__ ((noinline)) prvOldExitCritical( void )
+{
+	if( ulCriticalNesting > 0UL )
+	{
+		ulCriticalNesting--;
+		if( ulCriticalNesting == 0UL )
+		{
+			prvOldIrqEnable();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vStartCriticalBench( unsigned portBASE_TYPE uxPriority )
+{
+	xTaskCreate( prvCriticalBenchTask, ( signed char * ) "IBench", ibenchSTACK_SIZE, NULL, uxPriority, NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCriticalBenchTask( void *pvParameters )
+{
+unsigned long long ullStart, ullLoop, ullInline, ullCall, ullOld;
+unsigned long ul;
+
+	/* Stop warnings. */
+	( void ) pvParameters;
+
+	/* The empty asm keeps the loop from being removed. */
+	ullStart = get_cycles64();
+	for( ul = 0; ul < ibenchLOOPS; ul++ )
+	{
+		__asm__ __volatile__ ( "" : : : "memory" );
+	}
+	ullLoop = get_cycles64() - ullStart;
+
+	ullStart = get_cycles64();
+	for( ul = 0; ul < ibenchLOOPS; ul++ )
+	{
+		portENTER_CRITICAL();
+		portEXIT_CRITICAL();
+	}
+	ullInline = get_cycles64() - ullStart - ullLoop;
+
+	ullStart = get_cycles64();
+	for( ul = 0; ul < ibenchLOOPS; ul++ )
+	{
+		vPortEnterCritical();
+		vPortExitCritical();
+	}
+	ullCall = get_cycles64() - ullStart - ullLoop;
+
+	ullStart = get_cycles64();
+	for( ul = 0; ul < ibenchLOOPS; ul++ )
+	{
+		prvOldEnterCritical();
+		prvOldExitCritical();
+	}
+	ullOld = get_cycles64() - ullStart - ullLoop;
+
+	printf( "IBENCH critical inline %u call %u old %u\n",
+			( unsigned int ) ( ullInline / ibenchLOOPS ),
+			( unsigned int ) ( ullCall / ibenchLOOPS ),
+			( unsigned int ) ( ullOld / ibenchLOOPS ) );
+
+	/* Nothing left to do. */
+	vTaskSuspend( NULL );
+	for( ;; );
+}
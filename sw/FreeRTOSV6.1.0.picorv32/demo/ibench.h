@@ -0,0 +1,11 @@
+#ifndef IBENCH_H
+#define IBENCH_H
+
+/*
+ * Measures the cycles of a critical section with the inlined
+ * portENTER_CRITICAL()/portEXIT_CRITICAL() and with the out of line path they
+ * replace, and prints the results on the console.
+ */
+void vStartCriticalBench( unsigned portBASE_TYPE uxPriority );
+
+#endif /* IBENCH_H */
@@ -0,0 +1,211 @@
+/*
+ * Interrupt latency benchmark.
+ *
+ * Measures how late the tick hook runs after the timer expiry, the irq
+ * entry, do_irq() and the tick increment of the kernel included, over
+ * lbenchTICKS ticks twice:
+ *
+ * - quiet: the tick irq only.
+ * - storm: the UART raises its transmitter empty irq after every character,
+ *   the handler writes the next one and then spins for lbenchHANDLER_CYCLES,
+ *   a slow handler that holds the core most of the time.  Without
+ *   IRQ_NESTING_ENABLE a timer expiry during the handler waits for it to
+ *   return, with it the timer irq preempts the handler.
+ *
+ * The timer period never changes, the cycle of the next expiry is read once
+ * with timer_add( 0 ), which returns the cycles left to it, and the later
+ * ones are one period apart.  jitter is max - min.  A tick found more than a
+ * period late counts as missed.
+ *
+ * The bench takes the UART irq, build it with UART_IRQ_ENABLE off.  The
+ * storm characters are NULs, the results are printed after it.  A tick is
+ * 1000000 cycles with HZ 10, HZ 1000 in board.h gives more ticks per
+ * simulated second.
+ *
+ * Output:
+ *
+ * LBENCH nesting on|off
+ * LBENCH quiet latency min <cycles> avg <cycles> max <cycles> jitter <cycles> missed <ticks>
+ * LBENCH storm latency min <cycles> avg <cycles> max <cycles> jitter <cycles> missed <ticks> irqs <count>
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Hardware specific definitions. */
+#include "system.h"
+#include "irq.h"
+#include "hal/uart.h"
+
+#include "lbench.h"
+
+#define lbenchTICKS				( 50UL )
+#define lbenchHANDLER_CYCLES	( 2000UL )
+#define lbenchSTACK_SIZE		configMINIMAL_STACK_SIZE
+
+#define lbenchPERIOD			( configCPU_CLOCK_HZ / configTICK_RATE_HZ )
+
+typedef struct LATENCY_STATS
+{
+	unsigned long ulMin;
+	unsigned long ulMax;
+	unsigned long long ullSum;
+	unsigned long ulSamples;
+	unsigned long ulMissed;
+} xLatencyStats;
+
+static void prvIrqBenchTask( void *pvParameters );
+static void prvUartStormHandler( void *pvArg );
+static void prvPrint( const char *pcName, xLatencyStats *pxStats );
+
+/* Written by the tick hook while a run is on. */
+static xLatencyStats * volatile pxRun = NULL;
+static unsigned long ulNextExpiry;
+
+static volatile portBASE_TYPE xStorm = pdFALSE;
+static volatile unsigned long ulStormIrqs = 0;
+
+/*-----------------------------------------------------------*/
+
+void vStartIrqBench( unsigned portBASE_TYPE uxPriority )
+{
+	xTaskCreate( prvIrqBenchTask, ( signed char * ) "LBench", lbenchSTACK_SIZE, NULL, uxPriority, NULL );
+}
+/*-----------------------------------------------------------*/
+
+void vIrqBenchTick( void )
+{
+xLatencyStats *pxStats = pxRun;
+unsigned long ulLatency;
+
+	if( pxStats == NULL )
+	{
+		return;
+	}
+
+	ulLatency = rdcycle() - ulNextExpiry;
+	while( ulLatency >= lbenchPERIOD )
+	{
+		pxStats->ulMissed++;
+		ulLatency -= lbenchPERIOD;
+		ulNextExpiry += lbenchPERIOD;
+	}
+	ulNextExpiry += lbenchPERIOD;
+
+	if( ulLatency < pxStats->ulMin )
+	{
+		pxStats->ulMin = ulLatency;
+	}
+	if( ulLatency > pxStats->ulMax )
+	{
+		pxStats->ulMax = ulLatency;
+	}
+	pxStats->ullSum += ulLatency;
+
+	if( ++pxStats->ulSamples == lbenchTICKS )
+	{
+		pxRun = NULL;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvUartStormHandler( void *pvArg )
+{
+unsigned long ulStart;
+
+	/* Stop warnings. */
+	( void ) pvArg;
+
+	/* Reading the IIR clears the transmitter empty irq. */
+	( void ) readb( UART0_BASE + UART_IIR );
+	if( xStorm == pdFALSE )
+	{
+		return;
+	}
+
+	writeb( 0, UART0_BASE + UART_TX );
+	ulStormIrqs++;
+
+	ulStart = rdcycle();
+	while( rdcycle() - ulStart < lbenchHANDLER_CYCLES )
+	{
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvRun( xLatencyStats *pxStats )
+{
+unsigned int uxFlags;
+
+	pxStats->ulMin = ~0UL;
+	pxStats->ulMax = 0;
+	pxStats->ullSum = 0;
+	pxStats->ulSamples = 0;
+	pxStats->ulMissed = 0;
+
+	uxFlags = __irq_save();
+	ulNextExpiry = rdcycle() + timer_add( 0 );
+	pxRun = pxStats;
+	__irq_restore( uxFlags );
+
+	while( pxRun != NULL )
+	{
+		vTaskDelay( 1 );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvPrint( const char *pcName, xLatencyStats *pxStats )
+{
+	printf( "LBENCH %s latency min %u avg %u max %u jitter %u missed %u",
+			pcName,
+			( unsigned int ) pxStats->ulMin,
+			( unsigned int ) ( pxStats->ullSum / pxStats->ulSamples ),
+			( unsigned int ) pxStats->ulMax,
+			( unsigned int ) ( pxStats->ulMax - pxStats->ulMin ),
+			( unsigned int ) pxStats->ulMissed );
+}
+/*-----------------------------------------------------------*/
+
+static void prvIrqBenchTask( void *pvParameters )
+{
+xLatencyStats xQuiet, xStormStats;
+
+	/* Stop warnings. */
+	( void ) pvParameters;
+
+	prvRun( &xQuiet );
+
+	if( irq_handler_add( UART0_IRQ, prvUartStormHandler, NULL ) != 0 )
+	{
+		printf( "LBENCH the UART irq is taken, build with UART_IRQ_ENABLE off\n" );
+		vTaskSuspend( NULL );
+	}
+	xStorm = pdTRUE;
+	writeb( UART_IER_THRI, UART0_BASE + UART_IER );
+	irq_enable( UART0_IRQ );
+
+	prvRun( &xStormStats );
+
+	xStorm = pdFALSE;
+	writeb( 0, UART0_BASE + UART_IER );
+	irq_disable( UART0_IRQ );
+
+	#ifdef IRQ_NESTING_ENABLE
+		printf( "\nLBENCH nesting on\n" );
+	#else
+		printf( "\nLBENCH nesting off\n" );
+	#endif
+	prvPrint( "quiet", &xQuiet );
+	printf( "\n" );
+	prvPrint( "storm", &xStormStats );
+	printf( " irqs %u\n", ( unsigned int ) ulStormIrqs );
+
+	/* Nothing left to do. */
+	vTaskSuspend( NULL );
+	for( ;; );
+}
@@ -0,0 +1,13 @@
+#ifndef LBENCH_H
+#define LBENCH_H
+
+/*
+ * Measures the latency of the tick irq, with the tick alone and under a
+ * UART irq storm, and prints the results on the console.
+ */
+void vStartIrqBench( unsigned portBASE_TYPE uxPriority );
+
+/* Called by the tick hook. */
+void vIrqBenchTick( void );
+
+#endif /* LBENCH_H */
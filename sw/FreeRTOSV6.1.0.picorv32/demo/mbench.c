@@ -0,0 +1,199 @@
+/*
+ * Mutex benchmark.
+ *
+ * Priority inheritance check: the low priority task takes the mutex and
+ * waits, the control task (low + 2) then blocks on the mutex while a task of
+ * the priority in between spins.  Without inheritance the spinning task keeps
+ * the mutex holder from running and the take of the control task times out.
+ * With it the holder runs at the priority of the control task, gives the
+ * mutex back and drops to its own priority.  The check fails if the take
+ * times out or the priorities seen by the holder are not the expected ones.
+ *
+ * The cycles of a take and give pair are then measured with the mutex free,
+ * and with mbenchWORKERS tasks of the same priority that yield while holding
+ * it, so nearly every take has to wait.
+ *
+ * Output:
+ *
+ * MBENCH inherit ok|FAIL held <priority> after <priority>
+ * MBENCH take/give free <cycles> contended <cycles>
+ *
+ * followed by lockstat_report() with LOCK_STATS_ENABLE.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+/* Hardware specific definitions. */
+#include "system.h"
+#include "lockstat.h"
+
+#include "mbench.h"
+
+#define mbenchLOOPS				( 1000UL )
+#define mbenchWORKERS			( 3 )
+#define mbenchINHERIT_TIMEOUT	( ( portTickType ) 10 )
+#define mbenchSTACK_SIZE		configMINIMAL_STACK_SIZE
+
+static void prvControlTask( void *pvParameters );
+static void prvLowTask( void *pvParameters );
+static void prvSpinTask( void *pvParameters );
+static void prvWorkerTask( void *pvParameters );
+
+static xSemaphoreHandle xInheritMutex, xWorkerMutex;
+static xTaskHandle xControl, xLow;
+static unsigned portBASE_TYPE uxLowPriority;
+
+/* Set by the low priority task, read by the control task. */
+static volatile unsigned portBASE_TYPE uxHeldPriority = 0;
+
+static volatile portBASE_TYPE xSpin = pdTRUE;
+static volatile unsigned long ulShared = 0;
+
+/*-----------------------------------------------------------*/
+
+void vStartMutexBench( unsigned portBASE_TYPE uxPriority )
+{
+	uxLowPriority = uxPriority;
+	xInheritMutex = xSemaphoreCreateMutex();
+	xWorkerMutex = xSemaphoreCreateMutex();
+
+	#if ( configQUEUE_REGISTRY_SIZE > 0 )
+	{
+		vQueueAddToRegistry( xInheritMutex, ( signed char * ) "MBenchInherit" );
+		vQueueAddToRegistry( xWorkerMutex, ( signed char * ) "MBenchWorker" );
+	}
+	#endif
+
+	xTaskCreate( prvControlTask, ( signed char * ) "MBench", mbenchSTACK_SIZE, NULL, uxPriority + 2, &xControl );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+unsigned long long ullStart, ullFree, ullContended;
+portBASE_TYPE xTaken;
+unsigned portBASE_TYPE uxAfter;
+unsigned long ul;
+int i;
+
+	/* Stop warnings. */
+	( void ) pvParameters;
+
+	/* Let the low priority task take the mutex. */
+	xTaskCreate( prvLowTask, ( signed char * ) "MBenchLow", mbenchSTACK_SIZE, NULL, uxLowPriority, &xLow );
+	vTaskDelay( 1 );
+	xTaskCreate( prvSpinTask, ( signed char * ) "MBenchSpin", mbenchSTACK_SIZE, NULL, uxLowPriority + 1, NULL );
+
+	/* The low priority task gives the mutex back once notified, if it gets
+	to run above the spinning task. */
+	xTaskNotifyGive( xLow );
+	xTaken = xSemaphoreTake( xInheritMutex, mbenchINHERIT_TIMEOUT );
+	uxAfter = uxTaskPriorityGet( xLow );
+	xSpin = pdFALSE;
+	if( xTaken == pdPASS )
+	{
+		xSemaphoreGive( xInheritMutex );
+	}
+
+	printf( "MBENCH inherit %s held %u after %u\n",
+			( ( xTaken == pdPASS ) && ( uxHeldPriority == uxLowPriority + 2 ) && ( uxAfter == uxLowPriority ) ) ? "ok" : "FAIL",
+			( unsigned int ) uxHeldPriority, ( unsigned int ) uxAfter );
+
+	ullStart = get_cycles64();
+	for( ul = 0; ul < mbenchLOOPS; ul++ )
+	{
+		xSemaphoreTake( xWorkerMutex, portMAX_DELAY );
+		xSemaphoreGive( xWorkerMutex );
+	}
+	ullFree = get_cycles64() - ullStart;
+
+	/* The workers run below this task, each notifies it when done. */
+	ullStart = get_cycles64();
+	for( i = 0; i < mbenchWORKERS; i++ )
+	{
+		xTaskCreate( prvWorkerTask, ( signed char * ) "MBenchWorker", mbenchSTACK_SIZE, NULL, uxLowPriority + 1, NULL );
+	}
+	for( i = 0; i < mbenchWORKERS; i++ )
+	{
+		ulTaskNotifyTake( pdFALSE, portMAX_DELAY );
+	}
+	ullContended = get_cycles64() - ullStart;
+
+	printf( "MBENCH take/give free %u contended %u\n",
+			( unsigned int ) ( ullFree / mbenchLOOPS ),
+			( unsigned int ) ( ullContended / ( mbenchLOOPS * mbenchWORKERS ) ) );
+	if( ulShared != mbenchLOOPS * mbenchWORKERS )
+	{
+		printf( "MBENCH FAIL %u of %u increments\n", ( unsigned int ) ulShared, ( unsigned int ) ( mbenchLOOPS * mbenchWORKERS ) );
+	}
+
+	#ifdef LOCK_STATS_ENABLE
+	{
+		lockstat_report();
+	}
+	#endif
+
+	/* Nothing left to do. */
+	vTaskSuspend( NULL );
+	for( ;; );
+}
+/*-----------------------------------------------------------*/
+
+static void prvLowTask( void *pvParameters )
+{
+	/* Stop warnings. */
+	( void ) pvParameters;
+
+	xSemaphoreTake( xInheritMutex, portMAX_DELAY );
+	ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+	/* Raised to the priority of the control task, blocked on the mutex. */
+	uxHeldPriority = uxTaskPriorityGet( NULL );
+	xSemaphoreGive( xInheritMutex );
+
+	vTaskSuspend( NULL );
+	for( ;; );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSpinTask( void *pvParameters )
+{
+	/* Stop warnings. */
+	( void ) pvParameters;
+
+	while( xSpin != pdFALSE )
+	{
+	}
+
+	vTaskSuspend( NULL );
+	for( ;; );
+}
+/*-----------------------------------------------------------*/
+
+static void prvWorkerTask( void *pvParameters )
+{
+unsigned long ul;
+
+	/* Stop warnings. */
+	( void ) pvParameters;
+
+	for( ul = 0; ul < mbenchLOOPS; ul++ )
+	{
+		xSemaphoreTake( xWorkerMutex, portMAX_DELAY );
+		ulShared++;
+
+		/* The other workers run and block on the mutex. */
+		taskYIELD();
+		xSemaphoreGive( xWorkerMutex );
+	}
+
+	xTaskNotifyGive( xControl );
+	vTaskSuspend( NULL );
+	for( ;; );
+}
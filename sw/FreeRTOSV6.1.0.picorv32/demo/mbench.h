@@ -0,0 +1,11 @@
+#ifndef MBENCH_H
+#define MBENCH_H
+
+/*
+ * Checks the priority inheritance of the mutexes, measures the cycles of a
+ * mutex take and give with and without contention, and prints the results
+ * and the lock stats on the console.
+ */
+void vStartMutexBench( unsigned portBASE_TYPE uxPriority );
+
+#endif /* MBENCH_H */
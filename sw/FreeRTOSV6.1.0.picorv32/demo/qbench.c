@@ -0,0 +1,196 @@
+/*
+ * Queue throughput benchmark.
+ *
+ * A producer task sends qbenchMESSAGES messages to a consumer task of the
+ * same priority, first through a queue that copies each message (xQueueSend()
+ * and xQueueReceive() with uxItemSize set to the message size), then through a
+ * zero copy queue that only passes a block taken from a buffer pool
+ * (xQueueSendBuffer() and xQueueReceiveBuffer()).  Both sides write or check
+ * the first word of each message only, so the difference is the cost of the
+ * copies.  The cycles per message are measured with the cycle counter.
+ *
+ * Output, one line per message size:
+ *
+ * QBENCH <size> copy <cycles/msg> zero-copy <cycles/msg> speedup <x.xx>
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "bufpool.h"
+
+/* Hardware specific definitions. */
+#include "system.h"
+
+#include "qbench.h"
+
+#define qbenchMESSAGES			( 256 )
+#define qbenchQUEUE_LENGTH		( 4 )
+#define qbenchMAX_SIZE			( 1024 )
+#define qbenchPOOL_BLOCKS		( qbenchQUEUE_LENGTH + 2 )
+#define qbenchSTACK_SIZE		configMINIMAL_STACK_SIZE
+
+/* Describes the run the consumer has to take part in. */
+typedef struct QBENCH_RUN
+{
+	xQueueHandle xQueue;
+	size_t xSize;
+	portBASE_TYPE xZeroCopy;
+} xQBenchRun;
+
+static void prvProducerTask( void *pvParameters );
+static void prvConsumerTask( void *pvParameters );
+static unsigned long prvRun( xQueueHandle xQueue, size_t xSize, portBASE_TYPE xZeroCopy );
+
+static xTaskHandle xProducer, xConsumer;
+static xBufferPoolHandle xPool;
+static volatile xQBenchRun xRun;
+static volatile unsigned long ulErrors = 0;
+
+/* Messages are built and received here when they are copied. */
+static unsigned long ulProducerBuffer[ qbenchMAX_SIZE / sizeof( unsigned long ) ];
+static unsigned long ulConsumerBuffer[ qbenchMAX_SIZE / sizeof( unsigned long ) ];
+
+/*-----------------------------------------------------------*/
+
+void vStartQueueBench( unsigned portBASE_TYPE uxPriority )
+{
+	xPool = xBufferPoolCreate( qbenchPOOL_BLOCKS, qbenchMAX_SIZE );
+	if( xPool == NULL )
+	{
+		printf( "QBENCH no memory for the buffer pool\n" );
+		return;
+	}
+
+	xTaskCreate( prvProducerTask, ( signed char * ) "QBenchTx", qbenchSTACK_SIZE, NULL, uxPriority, &xProducer );
+	xTaskCreate( prvConsumerTask, ( signed char * ) "QBenchRx", qbenchSTACK_SIZE, NULL, uxPriority, &xConsumer );
+}
+/*-----------------------------------------------------------*/
+
+static void prvProducerTask( void *pvParameters )
+{
+static const size_t xSizes[] = { 256, 512, 1024 };
+unsigned long ulCopy, ulZeroCopy, ulSpeedup;
+xQueueHandle xQueue;
+unsigned portBASE_TYPE ux;
+
+	/* Stop warnings. */
+	( void ) pvParameters;
+
+	for( ux = 0; ux < sizeof( xSizes ) / sizeof( xSizes[ 0 ] ); ux++ )
+	{
+		xQueue = xQueueCreate( qbenchQUEUE_LENGTH, xSizes[ ux ] );
+		if( xQueue == NULL )
+		{
+			printf( "QBENCH no memory for a %u byte queue\n", ( unsigned int ) xSizes[ ux ] );
+			break;
+		}
+		ulCopy = prvRun( xQueue, xSizes[ ux ], pdFALSE );
+		vQueueDelete( xQueue );
+
+		xQueue = xQueueCreateZeroCopy( qbenchQUEUE_LENGTH );
+		if( xQueue == NULL )
+		{
+			printf( "QBENCH no memory for the zero copy queue\n" );
+			break;
+		}
+		ulZeroCopy = prvRun( xQueue, xSizes[ ux ], pdTRUE );
+		vQueueDelete( xQueue );
+
+		ulSpeedup = ( ulCopy * 100UL ) / ulZeroCopy;
+		printf( "QBENCH %4u copy %8u zero-copy %8u speedup %u.%02u\n",
+				( unsigned int ) xSizes[ ux ], ( unsigned int ) ulCopy, ( unsigned int ) ulZeroCopy,
+				( unsigned int ) ( ulSpeedup / 100UL ), ( unsigned int ) ( ulSpeedup % 100UL ) );
+	}
+
+	printf( "QBENCH done, %u errors\n", ( unsigned int ) ulErrors );
+
+	/* Nothing left to do. */
+	vTaskSuspend( NULL );
+	for( ;; );
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvRun( xQueueHandle xQueue, size_t xSize, portBASE_TYPE xZeroCopy )
+{
+unsigned long long ullStart, ullEnd;
+unsigned long ul;
+void *pvBlock;
+
+	xRun.xQueue = xQueue;
+	xRun.xSize = xSize;
+	xRun.xZeroCopy = xZeroCopy;
+
+	ullStart = get_cycles64();
+
+	/* Start the consumer. */
+	xTaskNotifyGive( xConsumer );
+
+	for( ul = 0; ul < qbenchMESSAGES; ul++ )
+	{
+		if( xZeroCopy != pdFALSE )
+		{
+			pvBlock = pvBufferPoolAlloc( xPool, portMAX_DELAY );
+			( ( unsigned long * ) pvBlock )[ 0 ] = ul;
+			xQueueSendBuffer( xQueue, pvBlock, xSize, portMAX_DELAY );
+		}
+		else
+		{
+			ulProducerBuffer[ 0 ] = ul;
+			xQueueSend( xQueue, ulProducerBuffer, portMAX_DELAY );
+		}
+	}
+
+	/* Wait for the consumer to receive the last message. */
+	ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+	ullEnd = get_cycles64();
+
+	return ( unsigned long ) ( ( ullEnd - ullStart ) / qbenchMESSAGES );
+}
+/*-----------------------------------------------------------*/
+
+static void prvConsumerTask( void *pvParameters )
+{
+unsigned long ul;
+void *pvBlock;
+size_t xLength;
+
+	/* Stop warnings. */
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+		for( ul = 0; ul < qbenchMESSAGES; ul++ )
+		{
+			if( xRun.xZeroCopy != pdFALSE )
+			{
+				xQueueReceiveBuffer( xRun.xQueue, &pvBlock, &xLength, portMAX_DELAY );
+				if( ( ( ( unsigned long * ) pvBlock )[ 0 ] != ul ) || ( xLength != xRun.xSize ) )
+				{
+					ulErrors++;
+				}
+				if( xBufferPoolFree( xPool, pvBlock ) != pdPASS )
+				{
+					ulErrors++;
+				}
+			}
+			else
+			{
+				xQueueReceive( xRun.xQueue, ulConsumerBuffer, portMAX_DELAY );
+				if( ulConsumerBuffer[ 0 ] != ul )
+				{
+					ulErrors++;
+				}
+			}
+		}
+
+		xTaskNotifyGive( xProducer );
+	}
+}
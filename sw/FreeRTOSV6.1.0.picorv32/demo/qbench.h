@@ -0,0 +1,11 @@
+#ifndef QBENCH_H
+#define QBENCH_H
+
+/*
+ * Compares the time to pass messages of 256 to 1024 bytes between two tasks
+ * through a copying queue and through a zero copy queue fed from a buffer
+ * pool, and prints the results on the console.
+ */
+void vStartQueueBench( unsigned portBASE_TYPE uxPriority );
+
+#endif /* QBENCH_H */
@@ -0,0 +1,251 @@
+/*
+ * Ring buffer benchmark.
+ *
+ * The cycles per 4 byte entry of an enqueue and dequeue through a ring, in
+ * one task so there is no switch in the loop: one entry at a time,
+ * rbenchBATCH entries at a time, rbenchBATCH entries with the zero copy peek
+ * and commit calls, one entry at a time with the multi producer enqueue, and
+ * one entry at a time through a queue for comparison.
+ *
+ * Then a producer task sends rbenchSTRESS_ENTRIES sequence numbers to a
+ * consumer task of lower priority through a small ring, both with random
+ * batch sizes, the consumer alternating between copies and zero copy reads.
+ * The producer sleeps a tick when the ring is full, the tick irq and the
+ * wake ups preempt the consumer at random points.  The consumer checks that
+ * every number arrives once and in order.
+ *
+ * Output:
+ *
+ * RBENCH spsc <cycles> batch <cycles> zerocopy <cycles> mp <cycles> queue <cycles>
+ * RBENCH stress <entries> ok|FAIL at <entry>
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+/* Hardware specific definitions. */
+#include "system.h"
+#include "ring.h"
+
+#include "rbench.h"
+
+#define rbenchLOOPS				( 10000UL )
+#define rbenchBATCH				( 16 )
+#define rbenchENTRIES			( 64 )
+#define rbenchSTRESS_ENTRIES	( 100000UL )
+#define rbenchSTRESS_RING		( 16 )
+#define rbenchSTACK_SIZE		configMINIMAL_STACK_SIZE
+
+static void prvBenchTask( void *pvParameters );
+static void prvProducerTask( void *pvParameters );
+static void prvConsumerTask( void *pvParameters );
+static unsigned long prvRandom( unsigned long *pulSeed );
+
+static unsigned long ulRingBuf[ rbenchENTRIES ];
+static unsigned long ulStressBuf[ rbenchSTRESS_RING ];
+static struct ring xRing, xStressRing;
+static unsigned portBASE_TYPE uxStressPriority;
+
+/*-----------------------------------------------------------*/
+
+void vStartRingBench( unsigned portBASE_TYPE uxPriority )
+{
+	uxStressPriority = uxPriority;
+	ring_init( &xRing, ulRingBuf, rbenchENTRIES, sizeof( unsigned long ) );
+	ring_init( &xStressRing, ulStressBuf, rbenchSTRESS_RING, sizeof( unsigned long ) );
+	xTaskCreate( prvBenchTask, ( signed char * ) "RBench", rbenchSTACK_SIZE, NULL, uxPriority, NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchTask( void *pvParameters )
+{
+unsigned long long ullStart, ullSpsc, ullBatch, ullZeroCopy, ullMp, ullQueue;
+unsigned long ulIn[ rbenchBATCH ], ulOut[ rbenchBATCH ];
+unsigned long *pulEntry;
+unsigned long ul;
+unsigned int n, i;
+xQueueHandle xQueue;
+
+	/* Stop warnings. */
+	( void ) pvParameters;
+
+	for( i = 0; i < rbenchBATCH; i++ )
+	{
+		ulIn[ i ] = i;
+	}
+
+	ullStart = get_cycles64();
+	for( ul = 0; ul < rbenchLOOPS; ul++ )
+	{
+		ring_enqueue( &xRing, ulIn, 1 );
+		ring_dequeue( &xRing, ulOut, 1 );
+	}
+	ullSpsc = get_cycles64() - ullStart;
+
+	ullStart = get_cycles64();
+	for( ul = 0; ul < rbenchLOOPS / rbenchBATCH; ul++ )
+	{
+		ring_enqueue( &xRing, ulIn, rbenchBATCH );
+		ring_dequeue( &xRing, ulOut, rbenchBATCH );
+	}
+	ullBatch = get_cycles64() - ullStart;
+
+	/* The entries are written and read in place, the ring has a multiple of
+	rbenchBATCH entries so a batch never straddles the wrap. */
+	ullStart = get_cycles64();
+	for( ul = 0; ul < rbenchLOOPS / rbenchBATCH; ul++ )
+	{
+		pulEntry = ring_write_peek( &xRing, &n );
+		for( i = 0; i < rbenchBATCH; i++ )
+		{
+			pulEntry[ i ] = i;
+		}
+		ring_write_commit( &xRing, rbenchBATCH );
+
+		pulEntry = ring_read_peek( &xRing, &n );
+		for( i = 0; i < rbenchBATCH; i++ )
+		{
+			ulOut[ i ] = pulEntry[ i ];
+		}
+		ring_read_commit( &xRing, rbenchBATCH );
+	}
+	ullZeroCopy = get_cycles64() - ullStart;
+
+	ullStart = get_cycles64();
+	for( ul = 0; ul < rbenchLOOPS; ul++ )
+	{
+		ring_mp_enqueue( &xRing, ulIn, 1 );
+		ring_dequeue( &xRing, ulOut, 1 );
+	}
+	ullMp = get_cycles64() - ullStart;
+
+	xQueue = xQueueCreate( rbenchENTRIES, sizeof( unsigned long ) );
+	ullStart = get_cycles64();
+	for( ul = 0; ul < rbenchLOOPS; ul++ )
+	{
+		xQueueSend( xQueue, ulIn, 0 );
+		xQueueReceive( xQueue, ulOut, 0 );
+	}
+	ullQueue = get_cycles64() - ullStart;
+	vQueueDelete( xQueue );
+
+	printf( "RBENCH spsc %u batch %u zerocopy %u mp %u queue %u\n",
+			( unsigned int ) ( ullSpsc / rbenchLOOPS ),
+			( unsigned int ) ( ullBatch / rbenchLOOPS ),
+			( unsigned int ) ( ullZeroCopy / rbenchLOOPS ),
+			( unsigned int ) ( ullMp / rbenchLOOPS ),
+			( unsigned int ) ( ullQueue / rbenchLOOPS ) );
+
+	xTaskCreate( prvConsumerTask, ( signed char * ) "RBenchCons", rbenchSTACK_SIZE, NULL, uxStressPriority, NULL );
+	xTaskCreate( prvProducerTask, ( signed char * ) "RBenchProd", rbenchSTACK_SIZE, NULL, uxStressPriority + 1, NULL );
+
+	/* Nothing left to do. */
+	vTaskSuspend( NULL );
+	for( ;; );
+}
+/*-----------------------------------------------------------*/
+
+static void prvProducerTask( void *pvParameters )
+{
+unsigned long ulBatch[ rbenchSTRESS_RING ];
+unsigned long ulNext = 0, ulSeed = 1;
+unsigned int n, i, sent;
+
+	/* Stop warnings. */
+	( void ) pvParameters;
+
+	while( ulNext < rbenchSTRESS_ENTRIES )
+	{
+		n = 1 + prvRandom( &ulSeed ) % rbenchSTRESS_RING;
+		if( n > rbenchSTRESS_ENTRIES - ulNext )
+		{
+			n = rbenchSTRESS_ENTRIES - ulNext;
+		}
+		for( i = 0; i < n; i++ )
+		{
+			ulBatch[ i ] = ulNext + i;
+		}
+
+		sent = ring_enqueue( &xStressRing, ulBatch, n );
+		ulNext += sent;
+		if( sent < n )
+		{
+			/* Full, let the consumer run. */
+			vTaskDelay( 1 );
+		}
+	}
+
+	vTaskSuspend( NULL );
+	for( ;; );
+}
+/*-----------------------------------------------------------*/
+
+static void prvConsumerTask( void *pvParameters )
+{
+unsigned long ulBatch[ rbenchSTRESS_RING ];
+unsigned long ulExpected = 0, ulSeed = 2;
+unsigned long *pulEntry;
+unsigned int n, i;
+portBASE_TYPE xFailed = pdFALSE;
+
+	/* Stop warnings. */
+	( void ) pvParameters;
+
+	while( ( ulExpected < rbenchSTRESS_ENTRIES ) && ( xFailed == pdFALSE ) )
+	{
+		n = 1 + prvRandom( &ulSeed ) % rbenchSTRESS_RING;
+		if( n & 1 )
+		{
+			n = ring_dequeue( &xStressRing, ulBatch, n );
+			pulEntry = ulBatch;
+		}
+		else
+		{
+			pulEntry = ring_read_peek( &xStressRing, &i );
+			if( n > i )
+			{
+				n = i;
+			}
+		}
+
+		for( i = 0; i < n; i++ )
+		{
+			if( pulEntry[ i ] != ulExpected )
+			{
+				xFailed = pdTRUE;
+				break;
+			}
+			ulExpected++;
+		}
+
+		if( pulEntry != ulBatch )
+		{
+			ring_read_commit( &xStressRing, n );
+		}
+	}
+
+	if( xFailed == pdFALSE )
+	{
+		printf( "RBENCH stress %u ok\n", ( unsigned int ) rbenchSTRESS_ENTRIES );
+	}
+	else
+	{
+		printf( "RBENCH stress %u FAIL at %u\n", ( unsigned int ) rbenchSTRESS_ENTRIES, ( unsigned int ) ulExpected );
+	}
+
+	vTaskSuspend( NULL );
+	for( ;; );
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvRandom( unsigned long *pulSeed )
+{
+	/* Numerical Recipes LCG, the high bits are the random ones. */
+	*pulSeed = *pulSeed * 1664525UL + 1013904223UL;
+	return *pulSeed >> 16;
+}
@@ -0,0 +1,11 @@
+#ifndef RBENCH_H
+#define RBENCH_H
+
+/*
+ * Measures the cycles per entry of the ring buffers of lib/ring.c against a
+ * queue, runs a producer and a consumer task through a ring with random batch
+ * sizes, and prints the results on the console.
+ */
+void vStartRingBench( unsigned portBASE_TYPE uxPriority );
+
+#endif /* RBENCH_H */
@@ -0,0 +1,113 @@
+/*
+ * SRAM access benchmark.
+ *
+ * Measures memcpy() on the data cache (DCACHE_ENABLE, see board.h and
+ * hw/rtl/picorv32/picorv32_dcache.v), to be run once on a core built without
+ * the cache and once with it, together with demo/ybench.c for the context
+ * switch:
+ *
+ * - warm: sbenchCOPY_SIZE bytes copied between two SRAM0 buffers
+ *   sbenchRUNS times.  Both buffers fit in the default cache (2 KiB) and,
+ *   next to each other, do not map to the same lines of the direct mapped
+ *   cache but for the line they may share.
+ * - cold: the same copy once right after dcache_flush_invalidate(), every
+ *   line is filled from the SRAM, the lines written are written back later.
+ * - sram1: a copy from a buffer in SRAM1 to SRAM0, warm.
+ *
+ * misses and writebacks are the line fills and write backs of the cold
+ * copy, 0 without the cache.  The runs are made with irq off.
+ *
+ * Output:
+ *
+ * SBENCH memcpy warm <cycles/KiB> cold <cycles/KiB> sram1 <cycles/KiB> misses <count> writebacks <count>
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <string.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Hardware specific definitions. */
+#include "system.h"
+#include "cache.h"
+
+#include "sbench.h"
+
+#define sbenchCOPY_SIZE			( 512 )
+#define sbenchRUNS				( 64UL )
+#define sbenchSTACK_SIZE		configMINIMAL_STACK_SIZE
+
+/* Cycles of ulRuns copies of sbenchCOPY_SIZE bytes, per KiB. */
+#define sbenchPER_KIB( ulCycles, ulRuns )	( ( unsigned int ) ( ( ulCycles ) * 1024UL / ( ( ulRuns ) * sbenchCOPY_SIZE ) ) )
+
+static void prvSramBenchTask( void *pvParameters );
+
+static unsigned long ulSrc[ sbenchCOPY_SIZE / sizeof( unsigned long ) ];
+static unsigned long ulDst[ sbenchCOPY_SIZE / sizeof( unsigned long ) ];
+static unsigned long ulSram1Src[ sbenchCOPY_SIZE / sizeof( unsigned long ) ] __sram1;
+
+/*-----------------------------------------------------------*/
+
+void vStartSramBench( unsigned portBASE_TYPE uxPriority )
+{
+	xTaskCreate( prvSramBenchTask, ( signed char * ) "SBench", sbenchSTACK_SIZE, NULL, uxPriority, NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSramBenchTask( void *pvParameters )
+{
+unsigned long ulStart, ulWarm, ulCold, ulSram1, ulMisses, ulWritebacks, ul;
+
+	/* Stop warnings. */
+	( void ) pvParameters;
+
+	for( ul = 0; ul < sbenchCOPY_SIZE / sizeof( unsigned long ); ul++ )
+	{
+		ulSrc[ ul ] = ul;
+		ulSram1Src[ ul ] = ~ul;
+	}
+
+	portENTER_CRITICAL();
+	{
+		/* Cold first, the write backs of the copy are only counted once the
+		lines are flushed. */
+		dcache_flush_invalidate();
+		ulMisses = dcache_misses();
+		ulWritebacks = dcache_writebacks();
+		ulStart = rdcycle();
+		memcpy( ulDst, ulSrc, sbenchCOPY_SIZE );
+		ulCold = rdcycle() - ulStart;
+		dcache_flush();
+		ulMisses = dcache_misses() - ulMisses;
+		ulWritebacks = dcache_writebacks() - ulWritebacks;
+
+		ulStart = rdcycle();
+		for( ul = 0; ul < sbenchRUNS; ul++ )
+		{
+			memcpy( ulDst, ulSrc, sbenchCOPY_SIZE );
+		}
+		ulWarm = rdcycle() - ulStart;
+
+		ulStart = rdcycle();
+		for( ul = 0; ul < sbenchRUNS; ul++ )
+		{
+			memcpy( ulDst, ulSram1Src, sbenchCOPY_SIZE );
+		}
+		ulSram1 = rdcycle() - ulStart;
+	}
+	portEXIT_CRITICAL();
+
+	printf( "SBENCH memcpy warm %u cold %u sram1 %u misses %u writebacks %u\n",
+			sbenchPER_KIB( ulWarm, sbenchRUNS ),
+			sbenchPER_KIB( ulCold, 1UL ),
+			sbenchPER_KIB( ulSram1, sbenchRUNS ),
+			( unsigned int ) ulMisses,
+			( unsigned int ) ulWritebacks );
+
+	/* Nothing left to do. */
+	vTaskSuspend( NULL );
+	for( ;; );
+}
@@ -0,0 +1,11 @@
+#ifndef SBENCH_H
+#define SBENCH_H
+
+/*
+ * Measures the cycles of memcpy() within SRAM0 and from SRAM1, warm and
+ * right after a data cache flush and invalidate, and prints the results on
+ * the console.
+ */
+void vStartSramBench( unsigned portBASE_TYPE uxPriority );
+
+#endif /* SBENCH_H */
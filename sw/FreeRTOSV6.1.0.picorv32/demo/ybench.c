@@ -0,0 +1,102 @@
+/*
+ * Context switch ping-pong benchmark.
+ *
+ * Two tasks of the same priority switch to each other ybenchSWITCHES times,
+ * first with taskYIELD(), then by giving each other a task notification
+ * (xTaskNotifyGive() and ulTaskNotifyTake()).  Both switches go through
+ * vPortYieldProcessor, which only saves and restores the callee saved
+ * registers, the task switched to may have been switched out by an irq and
+ * be restored from a full frame.  The cycles per switch are measured with the
+ * cycle counter, the tick irqs of the run included.
+ *
+ * Output:
+ *
+ * YBENCH yield <cycles/switch> notify <cycles/switch>
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Hardware specific definitions. */
+#include "system.h"
+
+#include "ybench.h"
+
+#define ybenchSWITCHES			( 10000UL )
+#define ybenchSTACK_SIZE		configMINIMAL_STACK_SIZE
+
+static void prvPingTask( void *pvParameters );
+static void prvPongTask( void *pvParameters );
+
+static xTaskHandle xPing, xPong;
+static volatile unsigned long ulPongs = 0;
+
+/*-----------------------------------------------------------*/
+
+void vStartYieldBench( unsigned portBASE_TYPE uxPriority )
+{
+	xTaskCreate( prvPingTask, ( signed char * ) "YBenchPing", ybenchSTACK_SIZE, NULL, uxPriority, &xPing );
+	xTaskCreate( prvPongTask, ( signed char * ) "YBenchPong", ybenchSTACK_SIZE, NULL, uxPriority, &xPong );
+}
+/*-----------------------------------------------------------*/
+
+static void prvPingTask( void *pvParameters )
+{
+unsigned long long ullStart, ullYield, ullNotify;
+unsigned long ul;
+
+	/* Stop warnings. */
+	( void ) pvParameters;
+
+	/* The pong task yields back as long as it is told to.  The notification
+	starts it, it does not switch to it as it has the same priority. */
+	ulPongs = ybenchSWITCHES / 2;
+	xTaskNotifyGive( xPong );
+	ullStart = get_cycles64();
+	for( ul = 0; ul < ybenchSWITCHES / 2; ul++ )
+	{
+		taskYIELD();
+	}
+	ullYield = get_cycles64() - ullStart;
+
+	ullStart = get_cycles64();
+	for( ul = 0; ul < ybenchSWITCHES / 2; ul++ )
+	{
+		xTaskNotifyGive( xPong );
+		ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+	}
+	ullNotify = get_cycles64() - ullStart;
+
+	printf( "YBENCH yield %u notify %u\n",
+			( unsigned int ) ( ullYield / ybenchSWITCHES ),
+			( unsigned int ) ( ullNotify / ybenchSWITCHES ) );
+
+	/* Nothing left to do. */
+	vTaskSuspend( xPong );
+	vTaskSuspend( NULL );
+	for( ;; );
+}
+/*-----------------------------------------------------------*/
+
+static void prvPongTask( void *pvParameters )
+{
+	/* Stop warnings. */
+	( void ) pvParameters;
+
+	ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+	while( ulPongs != 0 )
+	{
+		ulPongs--;
+		taskYIELD();
+	}
+
+	for( ;; )
+	{
+		ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+		xTaskNotifyGive( xPing );
+	}
+}
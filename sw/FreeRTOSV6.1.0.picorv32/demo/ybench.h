@@ -0,0 +1,11 @@
+#ifndef YBENCH_H
+#define YBENCH_H
+
+/*
+ * Measures the cycles of a voluntary context switch between two tasks, with
+ * taskYIELD() and with task notifications, and prints the results on the
+ * console.
+ */
+void vStartYieldBench( unsigned portBASE_TYPE uxPriority );
+
+#endif /* YBENCH_H */
@@ -0,0 +1,27 @@
+// This is free and unencumbered software released into the public domain.
+//
+// Anyone is free to copy, modify, publish, use, compile, sell, or
+// distribute this software, either in source code form or as a compiled
+// binary, for any purpose, commercial or non-commercial, and by any
+// means.
+
+#include <system.h>
+#include <cache.h>
+
+#ifdef DCACHE_ENABLE
+
+void dcache_flush_range(const void *addr, unsigned int len)
+{
+	unsigned int line, end;
+
+	if (len == 0)
+		return;
+
+	// one maintenance store per line, each is done when it returns
+	line = (unsigned int)addr & ~(DCACHE_LINE_SIZE - 1);
+	end = (unsigned int)addr + len;
+	for (; line < end; line += DCACHE_LINE_SIZE)
+		writel(line, DCACHE_CTRL_BASE + 4);
+}
+
+#endif /* DCACHE_ENABLE */
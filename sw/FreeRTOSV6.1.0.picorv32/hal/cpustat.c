@@ -0,0 +1,151 @@
+// This is free and unencumbered software released into the public domain.
+//
+// Anyone is free to copy, modify, publish, use, compile, sell, or
+// distribute this software, either in source code form or as a compiled
+// binary, for any purpose, commercial or non-commercial, and by any
+// means.
+
+#include <stddef.h>
+#include <stdio.h>
+#include <system.h>
+#include <irq.h>
+#include <cpustat.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#ifdef CPU_STATS_ENABLE
+
+// cycles spent in the handler of each irq line, nested handlers included
+static unsigned long long cpustat_irq_cycles[NR_IRQS];
+static unsigned int cpustat_irq_count[NR_IRQS];
+// cycles spent in do_irq(), handlers included
+static unsigned long long cpustat_irq_total;
+static unsigned long long cpustat_irq_entry;
+static unsigned int cpustat_irq_depth;
+// the running task slice: its start and the irq cycles inside it
+static unsigned long long cpustat_slice_start;
+static unsigned long long cpustat_slice_irq;
+// start of the measurement
+static unsigned long long cpustat_start;
+
+void cpustat_irq_enter(void)
+{
+	if (cpustat_irq_depth++ == 0)
+		cpustat_irq_entry = get_cycles64();
+}
+
+void cpustat_irq_exit(void)
+{
+	unsigned long long d;
+
+	if (--cpustat_irq_depth == 0) {
+		d = get_cycles64() - cpustat_irq_entry;
+		cpustat_irq_total += d;
+		cpustat_slice_irq += d;
+	}
+}
+
+unsigned long long cpustat_handler_enter(void)
+{
+	return get_cycles64();
+}
+
+void cpustat_handler_exit(unsigned int irq, unsigned long long start)
+{
+	cpustat_irq_cycles[irq] += get_cycles64() - start;
+	cpustat_irq_count[irq]++;
+}
+
+unsigned long long cpustat_task_slice(void)
+{
+	unsigned long long end, slice;
+
+	// a switch from an irq handler ends the slice at the irq entry, the
+	// whole irq is added to cpustat_slice_irq of the next slice on exit
+	if (cpustat_irq_depth)
+		end = cpustat_irq_entry;
+	else
+		end = get_cycles64();
+
+	slice = end - cpustat_slice_start - cpustat_slice_irq;
+	cpustat_slice_start = end;
+	cpustat_slice_irq = 0;
+
+	return slice;
+}
+
+void cpustat_reset(void)
+{
+	unsigned int flags;
+	int i;
+
+	flags = __irq_save();
+	for (i = 0; i < NR_IRQS; i++) {
+		cpustat_irq_cycles[i] = 0;
+		cpustat_irq_count[i] = 0;
+	}
+	cpustat_irq_total = 0;
+	cpustat_slice_irq = 0;
+	cpustat_start = get_cycles64();
+	cpustat_slice_start = cpustat_start;
+	__irq_restore(flags);
+}
+
+// kcycles and percentage of total with two decimals
+static void cpustat_print_cycles(unsigned long long cycles,
+				 unsigned long long total)
+{
+	unsigned int pct = 0;
+
+	if (total)
+		pct = (unsigned int)((cycles * 10000ULL) / total);
+
+	printf(" %12u %3u.%02u%%\n",
+		(unsigned int)(cycles / 1000ULL), pct / 100, pct % 100);
+}
+
+void cpustat_report(void)
+{
+	xTaskCycleStats stats[CPU_STATS_MAX_TASKS];
+	unsigned long long irq_cycles[NR_IRQS];
+	unsigned int irq_count[NR_IRQS];
+	unsigned long long irq_total, handlers, total;
+	unsigned int n, i, flags;
+
+	n = uxTaskGetCycleStats(stats, CPU_STATS_MAX_TASKS);
+
+	flags = __irq_save();
+	for (i = 0; i < NR_IRQS; i++) {
+		irq_cycles[i] = cpustat_irq_cycles[i];
+		irq_count[i] = cpustat_irq_count[i];
+	}
+	irq_total = cpustat_irq_total;
+	total = get_cycles64() - cpustat_start;
+	__irq_restore(flags);
+
+	printf("%-16s %4s %12s %8s\n", "NAME", "PRIO", "KCYCLES", "CPU");
+	for (i = 0; i < n; i++) {
+		printf("%-16s %4u", (const char *)stats[i].pcTaskName,
+			(unsigned int)stats[i].uxPriority);
+		cpustat_print_cycles(stats[i].ullCycles, total);
+	}
+
+	handlers = 0;
+	for (i = 0; i < NR_IRQS; i++) {
+		if (irq_count[i] == 0)
+			continue;
+		printf("irq%-2u %10u    -", i, irq_count[i]);
+		cpustat_print_cycles(irq_cycles[i], total);
+		handlers += irq_cycles[i];
+	}
+	// irq_vec, do_irq and the irq mask handling around the handlers
+	if (irq_total > handlers) {
+		printf("%-16s %4s", "irq entry/exit", "-");
+		cpustat_print_cycles(irq_total - handlers, total);
+	}
+
+	printf("total %u kcycles, %u tasks\n", (unsigned int)(total / 1000ULL), n);
+}
+
+#endif /* CPU_STATS_ENABLE */
@@ -4,6 +4,7 @@
 #include <serial.h>
 #include <irq.h>
 #include <util.h>
+#include <workq.h>
 
 const unsigned int sys_malloc_start = (const unsigned int)&__malloc_start;
 const unsigned int sys_malloc_end = (const unsigned int)&__malloc_end;
@@ -14,6 +15,27 @@ void hal_init(void)
 	serial_init();
         irq_init();
 	malloc_init(sys_malloc_start, (sys_malloc_end - sys_malloc_start));
+#ifdef UART_IRQ_ENABLE
+	// the stream buffers come from the heap
+	serial_irq_init(CONSOLE_UART_PORT_IDX);
+#endif
+#ifdef WORKQ_ENABLE
+	// the daemon task and its stack come from the heap
+	workq_init();
+#endif
+}
+
+unsigned long long get_cycles64(void)
+{
+	unsigned int hi, lo;
+
+	// re-read if the low word wrapped between the two reads
+	do {
+		hi = rdcycleh();
+		lo = rdcycle();
+	} while (hi != rdcycleh());
+
+	return ((unsigned long long)hi << 32) | lo;
 }
 
 void hang(void)
@@ -0,0 +1,242 @@
+// This is free and unencumbered software released into the public domain.
+//
+// Anyone is free to copy, modify, publish, use, compile, sell, or
+// distribute this software, either in source code form or as a compiled
+// binary, for any purpose, commercial or non-commercial, and by any
+// means.
+
+#include <stddef.h>
+#include <system.h>
+#include <irq.h>
+#include <hrtimer.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+unsigned long long hrtimer_now(void)
+{
+	return get_cycles64();
+}
+
+unsigned long long hrtimer_now_us(void)
+{
+	return cycles_to_us(get_cycles64());
+}
+
+#ifdef HRTIMER_ENABLE
+
+// the cpu timer is shared with the tick: its next irq is pulled in before
+// the tick boundary for the first expiry, and moved back to the boundary by
+// that irq, the period (timer reload) always stays one tick
+
+#define HRTIMER_TICK_CYCLES	(configCPU_CLOCK_HZ / configTICK_RATE_HZ)
+
+// cycles from reading the timer to timer_add() must stay below this, a timer
+// irq closer than this is left alone and an expiry closer than this is
+// armed this far
+#define HRTIMER_GUARD_CYCLES	128
+
+// pending timers sorted by expiry, equal expiries in start order
+static struct hrtimer *hrtimer_head;
+// cycles from the armed timer irq to the tick boundary, 0 if the armed irq
+// is the tick
+static unsigned int hrtimer_pulled;
+
+// must be called with irq disabled
+static void hrtimer_program(void)
+{
+	long long delta;
+	unsigned int remain, tick, want;
+
+	if (hrtimer_head == NULL)
+		return;
+
+	// 64-bit math first, the expiry is late by the cycles until the read
+	delta = (long long)(hrtimer_head->expires - get_cycles64());
+	if (delta < HRTIMER_GUARD_CYCLES)
+		delta = HRTIMER_GUARD_CYCLES;
+
+	remain = timer_add(0);
+	if (remain < HRTIMER_GUARD_CYCLES)
+		return;
+
+	tick = remain + hrtimer_pulled;
+	want = delta < tick ? (unsigned int)delta : tick;
+	if (want != remain) {
+		timer_add((int)(want - remain));
+		hrtimer_pulled = tick - want;
+	}
+}
+
+// must be called with irq disabled
+static void hrtimer_enqueue(struct hrtimer *timer)
+{
+	struct hrtimer **pp = &hrtimer_head;
+
+	while (*pp && (long long)((*pp)->expires - timer->expires) <= 0)
+		pp = &(*pp)->next;
+	timer->next = *pp;
+	*pp = timer;
+	timer->queued = 1;
+}
+
+// must be called with irq disabled
+static int hrtimer_dequeue(struct hrtimer *timer)
+{
+	struct hrtimer **pp = &hrtimer_head;
+
+	if (!timer->queued)
+		return 0;
+	while (*pp != timer)
+		pp = &(*pp)->next;
+	*pp = timer->next;
+	timer->next = NULL;
+	timer->queued = 0;
+	return 1;
+}
+
+void hrtimer_init(struct hrtimer *timer, hrtimer_func_t func, void *arg)
+{
+	timer->next = NULL;
+	timer->expires = 0;
+	timer->func = func;
+	timer->arg = arg;
+	timer->queued = 0;
+}
+
+void hrtimer_start(struct hrtimer *timer, unsigned long long expires)
+{
+	unsigned int flags;
+
+	flags = __irq_save();
+	hrtimer_dequeue(timer);
+	timer->expires = expires;
+	hrtimer_enqueue(timer);
+	// a later expiry than the armed one is picked up when that one fires
+	if (hrtimer_head == timer)
+		hrtimer_program();
+	__irq_restore(flags);
+}
+
+int hrtimer_cancel(struct hrtimer *timer)
+{
+	unsigned int flags;
+	int ret;
+
+	// the armed irq is not moved back, it finds nothing to run
+	flags = __irq_save();
+	ret = hrtimer_dequeue(timer);
+	__irq_restore(flags);
+
+	return ret;
+}
+
+// run the expired timers, irq disabled
+static int hrtimer_run(void)
+{
+	struct hrtimer *timer;
+	unsigned long long now;
+	int woken = 0;
+
+	now = get_cycles64();
+	while ((timer = hrtimer_head) != NULL) {
+		if ((long long)(timer->expires - now) > 0)
+			break;
+		hrtimer_head = timer->next;
+		timer->next = NULL;
+		timer->queued = 0;
+		// the callback may start it again
+		woken |= timer->func(timer);
+	}
+
+	return woken;
+}
+
+int hrtimer_timer_irq(void)
+{
+	unsigned int elapsed;
+	int tick, woken;
+
+	tick = 1;
+	if (hrtimer_pulled) {
+		// the timer reloaded a whole tick at this irq
+		elapsed = HRTIMER_TICK_CYCLES - timer_add(0);
+		if (hrtimer_pulled > elapsed + HRTIMER_GUARD_CYCLES) {
+			// back to the tick boundary
+			timer_add((int)hrtimer_pulled - HRTIMER_TICK_CYCLES);
+			tick = 0;
+		} else {
+			// the boundary is (nearly) here, count it now and aim
+			// at the next one
+			timer_add((int)hrtimer_pulled);
+		}
+		hrtimer_pulled = 0;
+	}
+
+	woken = hrtimer_run();
+	hrtimer_program();
+
+	// a tick switches context in vPortTickISR()
+	if (!tick && woken)
+		portYIELD_FROM_ISR();
+
+	return tick;
+}
+
+unsigned int hrtimer_idle_ticks(void)
+{
+	unsigned long long now;
+	long long delta;
+	unsigned int remain;
+
+	if (hrtimer_head == NULL)
+		return 0xffffffff;
+	if (hrtimer_pulled)
+		return 0;
+
+	now = get_cycles64();
+	remain = timer_add(0);
+	delta = (long long)(hrtimer_head->expires - now) - remain;
+	if (delta < 0)
+		return 0;
+
+	return 1 + (unsigned int)(delta / HRTIMER_TICK_CYCLES);
+}
+
+// the sleeper blocks on a semaphore of its own, the task notification
+// value stays free for the drivers and the application
+struct hrtimer_sleeper {
+	xStaticSemaphore buf;
+	xSemaphoreHandle sem;
+};
+
+static int hrtimer_wakeup(struct hrtimer *timer)
+{
+	struct hrtimer_sleeper *sl = timer->arg;
+	signed portBASE_TYPE woken = pdFALSE;
+
+	xSemaphoreGiveFromISR(sl->sem, &woken);
+
+	return woken == pdTRUE;
+}
+
+void hrtimer_usleep(unsigned int us)
+{
+	struct hrtimer_sleeper sl;
+	struct hrtimer timer;
+
+	if (us == 0)
+		return;
+
+	sl.sem = xSemaphoreCreateCountingStatic(1, 0, &sl.buf);
+	hrtimer_init(&timer, hrtimer_wakeup, &sl);
+	hrtimer_start(&timer, get_cycles64() + us_to_cycles(us));
+
+	// only hrtimer_wakeup() gives it
+	while (xSemaphoreTake(sl.sem, portMAX_DELAY) != pdTRUE)
+		;
+	vQueueDelete(sl.sem);
+}
+
+#endif /* HRTIMER_ENABLE */
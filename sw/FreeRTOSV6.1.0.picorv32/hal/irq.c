@@ -10,15 +10,46 @@
 #include <system.h>
 #include <exception.h>
 #include <irq.h>
+#include <irq_trace.h>
+#include <ktrace.h>
+#include <cpustat.h>
+#include <hrtimer.h>
+#include <profile.h>
 
 static struct irq_handler_t irq_handler_tbl[NR_IRQS];
 static uint32_t timer_tick_cnt;
 extern void vPortTickISR(void);
 
+#ifdef IRQ_NESTING_ENABLE
+// EBREAK/ECALL/ILLEGAL INSN and BUS Error are never masked
+#define IRQ_SYS_MASK		0x00000006
+
+// depth of irq_vec, maintained by irq_vec
+volatile unsigned int irq_nesting;
+// irq mask as set by irq_enable()/irq_disable()
+static uint32_t irq_line_mask;
+// lines masked on top of irq_line_mask by the running handlers
+static uint32_t irq_prio_mask;
+
+// must be called with irq disabled
+static void pic_set_prio_mask(uint32_t prio_mask)
+{
+	// no handler is running, the hw mask is the line mask
+	if (irq_prio_mask == 0)
+		irq_line_mask = __get_irq_mask();
+	irq_prio_mask = prio_mask;
+	__irq_mask(irq_line_mask | irq_prio_mask);
+}
+#endif
+
 static void timer_isr(void *arg)
 {
+#ifdef HRTIMER_ENABLE
+	// an hrtimer irq between two ticks
+	if (!hrtimer_timer_irq())
+		return;
+#endif
 	timer_tick_cnt++;
-	printf("[TIMER ISR] timer tick count:0x%x\n", timer_tick_cnt);
 	vPortTickISR();
 }
 
@@ -27,11 +58,18 @@ static void pic_unmask_irq(unsigned int irq)
 	uint32_t regv;
 	unsigned int flags;
 
-	if ((irq & 0x7) || (irq >= NR_IRQS))
+	if ((irq < NR_SYS_IRQS) || (irq >= NR_IRQS))
 		return;
 	flags = __irq_save();
+#ifdef IRQ_NESTING_ENABLE
+	if (irq_prio_mask == 0)
+		irq_line_mask = __get_irq_mask();
+	irq_line_mask &= ~(0x00000001L << irq);
+	regv = irq_line_mask | irq_prio_mask;
+#else
 	regv = __get_irq_mask();
 	regv &= ~(0x00000001L << irq);
+#endif
 	__irq_mask(regv);
 	__irq_restore(flags);
 }
@@ -41,11 +79,18 @@ static void pic_mask_irq(unsigned int irq)
 	uint32_t regv;
 	unsigned int flags;
 
-	if ((irq & 0x7) || (irq >=32))
+	if ((irq < NR_SYS_IRQS) || (irq >= NR_IRQS))
 		return;
 	flags = __irq_save();
+#ifdef IRQ_NESTING_ENABLE
+	if (irq_prio_mask == 0)
+		irq_line_mask = __get_irq_mask();
+	irq_line_mask |= (0x00000001L << irq);
+	regv = irq_line_mask | irq_prio_mask;
+#else
 	regv = __get_irq_mask();
 	regv |= (0x00000001L << irq);
+#endif
 	__irq_mask(regv);
 	__irq_restore(flags);
 }
@@ -65,17 +110,98 @@ static void handle_irq(struct irq_handler_t *h)
 	h->handler(h->arg);
 }
 
+#ifdef IRQ_NESTING_ENABLE
+// called with irq disabled, returns with irq disabled
+// the lines in irq_status are handled from the highest priority (irq 0) to
+// the lowest one, each handler runs with irq on and only the lines of equal
+// or lower priority masked
+static void handle_irq_nested(uint32_t irq_status, uint32_t pc)
+{
+	uint32_t prev_prio_mask;
+#ifdef IRQ_TRACE_ENABLE
+	unsigned int ev;
+#endif
+#ifdef CPU_STATS_ENABLE
+	unsigned long long start;
+#endif
+	int rearmed = 0;
+	int i;
+
+	prev_prio_mask = irq_prio_mask;
+
+	for (i = 0; i < NR_IRQS; i++) {
+		if ((irq_status & (0x1UL << i)) == 0)
+			continue;
+		if ((i != 0) && !(irq_handler_tbl[i].flags & IRQ_FLAGS_ENABLE))
+			continue;
+
+#ifdef IRQ_TRACE_ENABLE
+		ev = irq_trace_enter(i, pc);
+#endif
+#ifdef KERNEL_TRACE_ENABLE
+		ktrace_record(KTRACE_IRQ_ENTER, (void *)pc, i);
+#endif
+#ifdef CPU_STATS_ENABLE
+		start = cpustat_handler_enter();
+#endif
+		pic_set_prio_mask(prev_prio_mask | ((~0UL << i) & ~IRQ_SYS_MASK));
+		if (!rearmed) {
+			__irq_rearm();
+			rearmed = 1;
+		} else {
+			__irq_enable();
+		}
+
+		if (i == 0)
+			timer_isr(NULL);
+		else
+			handle_irq(&irq_handler_tbl[i]);
+
+		__irq_disable();
+		pic_set_prio_mask(prev_prio_mask);
+#ifdef CPU_STATS_ENABLE
+		cpustat_handler_exit(i, start);
+#endif
+#ifdef IRQ_TRACE_ENABLE
+		irq_trace_exit(ev);
+#endif
+#ifdef KERNEL_TRACE_ENABLE
+		ktrace_record(KTRACE_IRQ_EXIT, NULL, i);
+#endif
+	}
+}
+#endif
+
 void do_irq(uint32_t *regs)
 {
 	uint32_t irq_status;
+#ifndef IRQ_NESTING_ENABLE
 	int i;
+#endif
+#if defined(IRQ_TRACE_ENABLE) && !defined(IRQ_NESTING_ENABLE)
+	unsigned int ev;
+#endif
+#if defined(CPU_STATS_ENABLE) && !defined(IRQ_NESTING_ENABLE)
+	unsigned long long start;
+#endif
 
 	irq_status = regs[IRQ_STATUS/4];
 
-	printf("[do_irq] IRQ STATUS: 0x%08x\n", irq_status);
-	printf("[do_irq] RETURN PC:  0x%08x\n", regs[REG_PC/4]);
+#ifdef CPU_STATS_ENABLE
+	cpustat_irq_enter();
+#endif
 
 	if ((irq_status & 6) != 0) {
+#ifdef IRQ_TRACE_ENABLE
+		irq_trace_enter((irq_status & 2) ? 1 : 2, regs[REG_PC/4]);
+		irq_trace_dump();
+#endif
+#ifdef KERNEL_TRACE_ENABLE
+		ktrace_dump();
+#endif
+		printf("[do_irq] IRQ STATUS: 0x%08x\n", irq_status);
+		printf("[do_irq] RETURN PC:  0x%08x\n", regs[REG_PC/4]);
+
 		uint32_t pc = (regs[0] & 1) ? regs[0] - 3 : regs[0] - 4;
 		uint32_t instr = *(uint16_t*)pc;
 
@@ -121,8 +247,34 @@ void do_irq(uint32_t *regs)
 		__asm__ volatile ("ebreak");
 	}
 
+#ifdef PROFILE_ENABLE
+	if ((irq_status & 1) != 0)
+		profile_sample(regs[REG_PC/4]);
+#endif
+
+#ifdef IRQ_NESTING_ENABLE
+	handle_irq_nested(irq_status & ~IRQ_SYS_MASK, regs[REG_PC/4]);
+#else
 	if ((irq_status & 1) != 0) {
+#ifdef IRQ_TRACE_ENABLE
+		ev = irq_trace_enter(0, regs[REG_PC/4]);
+#endif
+#ifdef KERNEL_TRACE_ENABLE
+		ktrace_record(KTRACE_IRQ_ENTER, (void *)regs[REG_PC/4], 0);
+#endif
+#ifdef CPU_STATS_ENABLE
+		start = cpustat_handler_enter();
+#endif
 		timer_isr(NULL);
+#ifdef CPU_STATS_ENABLE
+		cpustat_handler_exit(0, start);
+#endif
+#ifdef IRQ_TRACE_ENABLE
+		irq_trace_exit(ev);
+#endif
+#ifdef KERNEL_TRACE_ENABLE
+		ktrace_record(KTRACE_IRQ_EXIT, NULL, 0);
+#endif
 	}
 
 	i = 3;
@@ -130,12 +282,35 @@ void do_irq(uint32_t *regs)
 	while (irq_status) {
 		if (irq_status & 0x1UL) {
 			if (irq_handler_tbl[i].flags & IRQ_FLAGS_ENABLE) {
+#ifdef IRQ_TRACE_ENABLE
+				ev = irq_trace_enter(i, regs[REG_PC/4]);
+#endif
+#ifdef KERNEL_TRACE_ENABLE
+				ktrace_record(KTRACE_IRQ_ENTER, (void *)regs[REG_PC/4], i);
+#endif
+#ifdef CPU_STATS_ENABLE
+				start = cpustat_handler_enter();
+#endif
 				handle_irq(&irq_handler_tbl[i]);
+#ifdef CPU_STATS_ENABLE
+				cpustat_handler_exit(i, start);
+#endif
+#ifdef IRQ_TRACE_ENABLE
+				irq_trace_exit(ev);
+#endif
+#ifdef KERNEL_TRACE_ENABLE
+				ktrace_record(KTRACE_IRQ_EXIT, NULL, i);
+#endif
 			}
 		}
 		i++;
 		irq_status >>= 1;
 	}
+#endif
+
+#ifdef CPU_STATS_ENABLE
+	cpustat_irq_exit();
+#endif
 
 	return;
 }
@@ -149,13 +324,15 @@ static void dummy_irq_handler(void *arg)
 
 int irq_handler_add(unsigned int irq, void (*handler)(void *), void *arg)
 {
-	if ((irq & 0x7) || (irq >= NR_IRQS)) {
+	if ((irq < NR_SYS_IRQS) || (irq >= NR_IRQS)) {
 		return -1;
 	}
 	if (handler == NULL) {
 		return -1;
 	}
-	if (irq_handler_tbl[irq].handler != NULL) {
+	// irq_init() and irq_handler_del() leave dummy_irq_handler behind
+	if ((irq_handler_tbl[irq].handler != NULL) &&
+	    (irq_handler_tbl[irq].handler != dummy_irq_handler)) {
 		return -1;
 	}
 	irq_handler_tbl[irq].flags |= IRQ_FLAGS_VALID;
@@ -167,7 +344,7 @@ int irq_handler_add(unsigned int irq, void (*handler)(void *), void *arg)
 
 int irq_handler_del(unsigned int irq)
 {
-	if ((irq & 0x7) || (irq >= NR_IRQS)) {
+	if ((irq < NR_SYS_IRQS) || (irq >= NR_IRQS)) {
 		return -1;
 	}
 	irq_handler_tbl[irq].flags |= IRQ_FLAGS_VALID;
@@ -178,7 +355,7 @@ int irq_handler_del(unsigned int irq)
 
 int irq_enable(unsigned int irq)
 {
-	if ((irq & 0x7) || (irq >= NR_IRQS)) {
+	if ((irq < NR_SYS_IRQS) || (irq >= NR_IRQS)) {
 		return -1;
 	}
 	if (irq_handler_tbl[irq].flags == 0x0) {
@@ -193,7 +370,7 @@ int irq_enable(unsigned int irq)
 
 int irq_disable(unsigned int irq)
 {
-	if ((irq & 0x7) || (irq >= NR_IRQS)) {
+	if ((irq < NR_SYS_IRQS) || (irq >= NR_IRQS)) {
 		return -1;
 	}
 	if (irq_handler_tbl[irq].flags == 0x0) {
@@ -212,7 +389,8 @@ void irq_init(void)
 
 	pic_init();
 
-	for (i = 0; i < NR_IRQS; i++) {
+	// the timer, ebreak and bus error lines are handled by do_irq() itself
+	for (i = NR_SYS_IRQS; i < NR_IRQS; i++) {
 		irq_handler_add(i, dummy_irq_handler, &irq_handler_tbl[i]);
 	}
 }
@@ -0,0 +1,89 @@
+// This is free and unencumbered software released into the public domain.
+//
+// Anyone is free to copy, modify, publish, use, compile, sell, or
+// distribute this software, either in source code form or as a compiled
+// binary, for any purpose, commercial or non-commercial, and by any
+// means.
+
+#include <stddef.h>
+#include <stdio.h>
+#include <system.h>
+#include <irq.h>
+#include <irq_trace.h>
+
+#ifdef IRQ_TRACE_ENABLE
+
+static struct irq_trace_event_t irq_trace_buf[IRQ_TRACE_ENTRIES];
+// total number of recorded events, the ring index is the low bits
+static uint32_t irq_trace_seq;
+// set while the ring is dumped, the events are dropped
+static volatile int irq_trace_frozen;
+
+unsigned int irq_trace_enter(unsigned int irq, uint32_t pc)
+{
+	struct irq_trace_event_t *e;
+	unsigned int ev;
+
+	if (irq_trace_frozen)
+		return IRQ_TRACE_ENTRIES;
+
+	ev = irq_trace_seq & (IRQ_TRACE_ENTRIES - 1);
+	e = &irq_trace_buf[ev];
+	e->seq = irq_trace_seq++;
+	e->pc = pc;
+	e->irq = irq;
+#ifdef IRQ_NESTING_ENABLE
+	e->depth = irq_nesting;
+#else
+	e->depth = 1;
+#endif
+	e->exit = IRQ_TRACE_NO_EXIT;
+	e->entry = rdcycle();
+
+	return ev;
+}
+
+void irq_trace_exit(unsigned int ev)
+{
+	uint32_t cycle = rdcycle();
+
+	if (ev >= IRQ_TRACE_ENTRIES)
+		return;
+	irq_trace_buf[ev].exit = cycle;
+}
+
+void irq_trace_reset(void)
+{
+	unsigned int flags;
+
+	flags = __irq_save();
+	irq_trace_seq = 0;
+	__irq_restore(flags);
+}
+
+// the output is parsed by sw/tools/irqtrace, keep the format in sync
+void irq_trace_dump(void)
+{
+	struct irq_trace_event_t *e;
+	unsigned int flags;
+	uint32_t seq, cnt, i;
+
+	flags = __irq_save();
+	irq_trace_frozen = 1;
+	seq = irq_trace_seq;
+	__irq_restore(flags);
+
+	cnt = (seq < IRQ_TRACE_ENTRIES) ? seq : IRQ_TRACE_ENTRIES;
+
+	printf("IRQTRACE BEGIN %u %u\n", cnt, IN_CLK);
+	for (i = seq - cnt; i != seq; i++) {
+		e = &irq_trace_buf[i & (IRQ_TRACE_ENTRIES - 1)];
+		printf("IRQTRACE %08x %d %d %08x %08x %08x\n",
+			e->seq, e->irq, e->depth, e->pc, e->entry, e->exit);
+	}
+	printf("IRQTRACE END\n");
+
+	irq_trace_frozen = 0;
+}
+
+#endif /* IRQ_TRACE_ENABLE */
@@ -0,0 +1,113 @@
+// This is free and unencumbered software released into the public domain.
+//
+// Anyone is free to copy, modify, publish, use, compile, sell, or
+// distribute this software, either in source code form or as a compiled
+// binary, for any purpose, commercial or non-commercial, and by any
+// means.
+
+#include <stddef.h>
+#include <stdio.h>
+#include <system.h>
+#include <ktrace.h>
+
+#ifdef KERNEL_TRACE_ENABLE
+
+struct ktrace_buf ktrace_buf = {
+	.magic = KTRACE_MAGIC,
+	.entries = KTRACE_ENTRIES,
+	.max_tasks = KTRACE_MAX_TASKS,
+	.clk = IN_CLK,
+};
+
+// set while the recording is stopped or dumped, the events are dropped
+static volatile int ktrace_frozen;
+
+void ktrace_record(unsigned int type, const void *obj, unsigned int arg)
+{
+	struct ktrace_event *e;
+	unsigned int flags;
+
+	if (ktrace_frozen)
+		return;
+
+	flags = __irq_save();
+	e = &ktrace_buf.ev[ktrace_buf.seq++ & (KTRACE_ENTRIES - 1)];
+	e->cycle = rdcycle();
+	e->obj = (uint32_t)obj;
+	e->type = type;
+	e->arg = arg;
+	__irq_restore(flags);
+}
+
+void ktrace_task_create(const void *tcb, const signed char *name,
+			unsigned int prio)
+{
+	struct ktrace_task *t;
+	unsigned int flags;
+	int i;
+
+	flags = __irq_save();
+	// the names of the first KTRACE_MAX_TASKS tasks are kept
+	if (ktrace_buf.ntasks < KTRACE_MAX_TASKS) {
+		t = &ktrace_buf.tasks[ktrace_buf.ntasks++];
+		t->tcb = (uint32_t)tcb;
+		for (i = 0; i < KTRACE_NAME_LEN - 1 && name[i]; i++)
+			t->name[i] = name[i];
+		t->name[i] = '\0';
+	}
+	__irq_restore(flags);
+
+	ktrace_record(KTRACE_TASK_CREATE, tcb, prio);
+}
+
+void ktrace_stop(void)
+{
+	ktrace_frozen = 1;
+}
+
+void ktrace_start(void)
+{
+	ktrace_frozen = 0;
+}
+
+void ktrace_reset(void)
+{
+	unsigned int flags;
+
+	// the task names are kept, the tasks still exist
+	flags = __irq_save();
+	ktrace_buf.seq = 0;
+	__irq_restore(flags);
+}
+
+// the output is parsed by sw/tools/ktrace2json, keep the format in sync
+void ktrace_dump(void)
+{
+	struct ktrace_event *e;
+	unsigned int flags;
+	uint32_t seq, cnt, i;
+	int frozen;
+
+	flags = __irq_save();
+	frozen = ktrace_frozen;
+	ktrace_frozen = 1;
+	seq = ktrace_buf.seq;
+	__irq_restore(flags);
+
+	cnt = (seq < KTRACE_ENTRIES) ? seq : KTRACE_ENTRIES;
+
+	printf("KTRACE BEGIN %u %u\n", cnt, ktrace_buf.clk);
+	for (i = 0; i < ktrace_buf.ntasks; i++)
+		printf("KTRACE TASK %08x %s\n", ktrace_buf.tasks[i].tcb,
+			ktrace_buf.tasks[i].name);
+	for (i = seq - cnt; i != seq; i++) {
+		e = &ktrace_buf.ev[i & (KTRACE_ENTRIES - 1)];
+		printf("KTRACE %08x %d %d %08x\n", e->cycle, e->type, e->arg,
+			e->obj);
+	}
+	printf("KTRACE END\n");
+
+	ktrace_frozen = frozen;
+}
+
+#endif /* KERNEL_TRACE_ENABLE */
@@ -0,0 +1,63 @@
+// This is free and unencumbered software released into the public domain.
+//
+// Anyone is free to copy, modify, publish, use, compile, sell, or
+// distribute this software, either in source code form or as a compiled
+// binary, for any purpose, commercial or non-commercial, and by any
+// means.
+
+#include <stddef.h>
+#include <stdio.h>
+#include <system.h>
+#include <lockstat.h>
+
+#include "FreeRTOS.h"
+#include "queue.h"
+
+#ifdef LOCK_STATS_ENABLE
+
+// most contended first, the longest wait breaks the ties
+static int lockstat_hotter(const xQueueLockStats *a, const xQueueLockStats *b)
+{
+	if (a->ulContended != b->ulContended)
+		return a->ulContended > b->ulContended;
+	return a->ulMaxWait > b->ulMaxWait;
+}
+
+void lockstat_report(void)
+{
+	static xQueueLockStats stats[LOCK_STATS_MAX_LOCKS];
+	xQueueLockStats tmp;
+	unsigned int n, i, j;
+
+	n = uxQueueGetLockStats(stats, LOCK_STATS_MAX_LOCKS);
+
+	// a few dozen mutexes at most, insertion sort
+	for (i = 1; i < n; i++) {
+		tmp = stats[i];
+		for (j = i; j > 0 && lockstat_hotter(&tmp, &stats[j - 1]); j--)
+			stats[j] = stats[j - 1];
+		stats[j] = tmp;
+	}
+
+	// times in cycles
+	printf("%-16s %10s %10s %4s %10s %10s\n", "NAME", "TAKES", "CONTENDED",
+		"%", "MAXHOLD", "MAXWAIT");
+	for (i = 0; i < n && i < LOCK_STATS_TOP; i++) {
+		// not in the queue registry: the handle
+		if (stats[i].pcName != NULL)
+			printf("%-16s", (const char *)stats[i].pcName);
+		else
+			printf("0x%08x      ", (unsigned int)stats[i].xHandle);
+		printf(" %10u %10u %4u %10u %10u\n",
+			(unsigned int)stats[i].ulTakes,
+			(unsigned int)stats[i].ulContended,
+			stats[i].ulTakes ?
+			(unsigned int)(stats[i].ulContended * 100 / stats[i].ulTakes) : 0,
+			(unsigned int)stats[i].ulMaxHold,
+			(unsigned int)stats[i].ulMaxWait);
+	}
+
+	printf("%u mutexes, %u shown\n", n, (n < LOCK_STATS_TOP) ? n : LOCK_STATS_TOP);
+}
+
+#endif /* LOCK_STATS_ENABLE */
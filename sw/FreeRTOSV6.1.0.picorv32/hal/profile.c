@@ -0,0 +1,171 @@
+// This is free and unencumbered software released into the public domain.
+//
+// Anyone is free to copy, modify, publish, use, compile, sell, or
+// distribute this software, either in source code form or as a compiled
+// binary, for any purpose, commercial or non-commercial, and by any
+// means.
+
+#include <stddef.h>
+#include <stdio.h>
+#include <system.h>
+#include <profile.h>
+#include <hrtimer.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#ifdef PROFILE_ENABLE
+
+#if ( INCLUDE_pcTaskGetTaskName != 1 )
+#error "the profiler needs INCLUDE_pcTaskGetTaskName"
+#endif
+
+// buckets probed for a free or matching one before the sample is dropped
+#define PROFILE_PROBES		8
+// the samples taken before the first task is created and of the tasks beyond
+// PROFILE_MAX_TASKS
+#define PROFILE_NO_TASK		0xff
+
+// one histogram bucket, keyed by the sampled pc and task
+struct profile_bucket {
+	uint32_t pc;
+	uint32_t count;
+	uint8_t task;
+};
+
+struct profile_task {
+	const void *tcb;
+	char name[configMAX_TASK_NAME_LEN];
+};
+
+static struct profile_bucket profile_hist[PROFILE_BUCKETS];
+static struct profile_task profile_tasks[PROFILE_MAX_TASKS];
+static unsigned int profile_ntasks;
+static unsigned int profile_samples;
+static unsigned int profile_dropped;
+static volatile int profile_running;
+
+#ifdef HRTIMER_ENABLE
+static struct hrtimer profile_timer;
+
+// the sample itself is taken by do_irq(), only keep the timer irq coming
+static int profile_timer_func(struct hrtimer *timer)
+{
+	if (profile_running)
+		hrtimer_start(timer, timer->expires + IN_CLK / PROFILE_HZ);
+	return 0;
+}
+#endif
+
+// the tasks are never deleted in this system, a tcb stays the same task
+static unsigned int profile_task_index(void)
+{
+	const void *tcb;
+	const signed char *name;
+	unsigned int i, j;
+
+	tcb = xTaskGetCurrentTaskHandle();
+	if (tcb == NULL)
+		return PROFILE_NO_TASK;
+	for (i = 0; i < profile_ntasks; i++)
+		if (profile_tasks[i].tcb == tcb)
+			return i;
+	if (profile_ntasks == PROFILE_MAX_TASKS)
+		return PROFILE_NO_TASK;
+
+	name = pcTaskGetTaskName(NULL);
+	for (j = 0; j < configMAX_TASK_NAME_LEN - 1 && name[j]; j++)
+		profile_tasks[i].name[j] = name[j];
+	profile_tasks[i].name[j] = '\0';
+	profile_tasks[i].tcb = tcb;
+	profile_ntasks++;
+
+	return i;
+}
+
+void profile_sample(uint32_t pc)
+{
+	struct profile_bucket *b;
+	unsigned int task, h, i;
+
+	if (!profile_running)
+		return;
+
+	// bit 0 flags a compressed instruction in q0
+	pc &= ~1UL;
+	task = profile_task_index();
+	profile_samples++;
+
+	// fibonacci hashing of the half word address, linear probing
+	h = (((pc >> 1) ^ (task << 24)) * 2654435761UL) >> (32 - __builtin_ctz(PROFILE_BUCKETS));
+	for (i = 0; i < PROFILE_PROBES; i++) {
+		b = &profile_hist[(h + i) & (PROFILE_BUCKETS - 1)];
+		if (b->count == 0) {
+			b->pc = pc;
+			b->task = task;
+			b->count = 1;
+			return;
+		}
+		if (b->pc == pc && b->task == task) {
+			b->count++;
+			return;
+		}
+	}
+	profile_dropped++;
+}
+
+void profile_start(void)
+{
+	profile_running = 1;
+#ifdef HRTIMER_ENABLE
+	hrtimer_init(&profile_timer, profile_timer_func, NULL);
+	hrtimer_start(&profile_timer, hrtimer_now() + IN_CLK / PROFILE_HZ);
+#endif
+}
+
+void profile_stop(void)
+{
+	profile_running = 0;
+#ifdef HRTIMER_ENABLE
+	hrtimer_cancel(&profile_timer);
+#endif
+}
+
+void profile_reset(void)
+{
+	unsigned int flags;
+	int i;
+
+	// the task table is kept, the tasks still exist
+	flags = __irq_save();
+	for (i = 0; i < PROFILE_BUCKETS; i++)
+		profile_hist[i].count = 0;
+	profile_samples = 0;
+	profile_dropped = 0;
+	__irq_restore(flags);
+}
+
+// the output is parsed by sw/tools/profsym, keep the format in sync
+void profile_dump(void)
+{
+	struct profile_bucket *b;
+	int running;
+	unsigned int i;
+
+	running = profile_running;
+	profile_running = 0;
+
+	printf("PROF BEGIN %u %u\n", profile_samples, profile_dropped);
+	for (i = 0; i < profile_ntasks; i++)
+		printf("PROF TASK %u %s\n", i, profile_tasks[i].name);
+	for (i = 0; i < PROFILE_BUCKETS; i++) {
+		b = &profile_hist[i];
+		if (b->count)
+			printf("PROF %08x %u %u\n", b->pc, b->task, b->count);
+	}
+	printf("PROF END\n");
+
+	profile_running = running;
+}
+
+#endif /* PROFILE_ENABLE */
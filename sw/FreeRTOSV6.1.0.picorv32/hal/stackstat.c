@@ -0,0 +1,54 @@
+// This is free and unencumbered software released into the public domain.
+//
+// Anyone is free to copy, modify, publish, use, compile, sell, or
+// distribute this software, either in source code form or as a compiled
+// binary, for any purpose, commercial or non-commercial, and by any
+// means.
+
+#include <stddef.h>
+#include <stdio.h>
+#include <system.h>
+#include <stackstat.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#ifdef STACK_STATS_ENABLE
+
+// the recommended sizes are rounded up to this many words
+#define STACK_STATS_ROUND	32
+
+void stackstat_report(void)
+{
+	xTaskStackStats stats[STACK_STATS_MAX_TASKS];
+	unsigned int n, i, size, used, rec, total, total_rec;
+
+	n = uxTaskGetStackStats(stats, STACK_STATS_MAX_TASKS);
+
+	// in words; the irq frames are pushed on the task stack, the margin
+	// covers the irq and call depths not seen while the system ran
+	printf("%-16s %4s %6s %6s %6s %6s\n", "NAME", "PRIO", "SIZE", "USED",
+		"FREE", "REC");
+	total = 0;
+	total_rec = 0;
+	for (i = 0; i < n; i++) {
+		size = stats[i].usStackDepth;
+		used = size - stats[i].usHighWaterMark;
+		rec = used + STACK_STATS_MARGIN;
+		rec = (rec + STACK_STATS_ROUND - 1) & ~(STACK_STATS_ROUND - 1);
+		if (rec > size)
+			rec = size;
+		printf("%-16s %4u %6u %6u %6u %6u%s\n",
+			(const char *)stats[i].pcTaskName,
+			(unsigned int)stats[i].uxPriority, size, used,
+			stats[i].usHighWaterMark, rec,
+			(stats[i].usHighWaterMark < STACK_STATS_MARGIN) ? " low" : "");
+		total += size;
+		total_rec += rec;
+	}
+
+	printf("%u tasks, %u bytes of stack, %u bytes recommended\n", n,
+		total * sizeof(portSTACK_TYPE), total_rec * sizeof(portSTACK_TYPE));
+}
+
+#endif /* STACK_STATS_ENABLE */
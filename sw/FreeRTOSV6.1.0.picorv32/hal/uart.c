@@ -1,13 +1,37 @@
+#include <stddef.h>
 #include <system.h>
 #include <serial.h>
+#include <irq.h>
 #include "uart.h"
 
+#ifdef UART_IRQ_ENABLE
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stream_buffer.h"
+
+// depth of the rx and tx fifos of the 16550
+#define UART_FIFO_SIZE		16
+// UART_IIR_ID does not cover the timeout bit
+#define UART_IIR_MASK		0x0f
+
+struct uart_irq_state {
+	struct uart_port *port;
+	xStreamBufferHandle rx;
+	xStreamBufferHandle tx;
+	// bytes received while the rx stream buffer was full
+	unsigned int rx_dropped;
+};
+
+static struct uart_irq_state uart_irq_state[NUM_UART_PORT];
+#endif
+
 struct uart_port uart_config[] = {
 	{
 		.base		= UART0_BASE,
 		.regshift	= UART0_REGSHIFT,
 		.baud_rate	= UART0_BAUD_RATE,
 		.divisor	= UART0_DIVISOR,
+		.irq		= UART0_IRQ,
 	},
 /*
 	{
@@ -65,6 +89,10 @@ unsigned char serial_tstc(int port)
 
 	if (port >= NUM_UART_PORT)
 		return 0;
+#ifdef UART_IRQ_ENABLE
+	if (uart_irq_state[port].rx != NULL)
+		return !xStreamBufferIsEmpty(uart_irq_state[port].rx);
+#endif
 	p = &uart_config[port];
 	return ((serial_in(p, UART_LSR) & (UART_LSR_DR)) == (UART_LSR_DR));
 }
@@ -76,6 +104,14 @@ unsigned char serial_getc(int port)
 
 	if (port >= NUM_UART_PORT)
 		return 0;
+#ifdef UART_IRQ_ENABLE
+	// the bytes are in the rx stream buffer, spin on it as on the LSR
+	if (uart_irq_state[port].rx != NULL) {
+		while (xStreamBufferReceive(uart_irq_state[port].rx, &c, 1, 0) == 0)
+			;
+		return c;
+	}
+#endif
 	p = &uart_config[port];
 	serial_wait_for_recv(p);
 	c = serial_in(p, UART_RX);
@@ -221,3 +257,126 @@ void serial_init(void)
 	}
 }
 
+#ifdef UART_IRQ_ENABLE
+static void serial_irq_handler(void *arg)
+{
+	struct uart_irq_state *st = (struct uart_irq_state *)arg;
+	struct uart_port *p = st->port;
+	signed portBASE_TYPE woken = pdFALSE;
+	unsigned char buf[UART_FIFO_SIZE];
+	unsigned int iir, n, i;
+
+	for (;;) {
+		iir = serial_in(p, UART_IIR) & UART_IIR_MASK;
+		if (iir & UART_IIR_NO_INT)
+			break;
+
+		switch (iir) {
+		case UART_IIR_RDI:
+		case UART_IIR_TOI:
+			// drain the fifo, then one stream buffer write for all
+			// the bytes rather than one per byte
+			n = 0;
+			while ((n < UART_FIFO_SIZE) &&
+			       (serial_in(p, UART_LSR) & UART_LSR_DR))
+				buf[n++] = serial_in(p, UART_RX);
+			st->rx_dropped += n -
+				xStreamBufferSendFromISR(st->rx, buf, n, &woken);
+			break;
+		case UART_IIR_THRI:
+			// the tx fifo is empty, refill it
+			n = xStreamBufferReceiveFromISR(st->tx, buf,
+							UART_FIFO_SIZE, &woken);
+			if (n == 0)
+				serial_out(p, UART_IER,
+					serial_in(p, UART_IER) & ~UART_IER_THRI);
+			for (i = 0; i < n; i++)
+				serial_out(p, UART_TX, buf[i]);
+			break;
+		case UART_IIR_RLSI:
+			serial_in(p, UART_LSR);
+			break;
+		default:
+			serial_in(p, UART_MSR);
+			break;
+		}
+	}
+
+	if (woken != pdFALSE)
+		portYIELD_FROM_ISR();
+}
+
+// a non-empty tx stream buffer always has THRI enabled, the irq handler
+// disables it when it finds the buffer empty
+static void serial_start_tx(struct uart_port *p)
+{
+	unsigned int flags;
+
+	flags = __irq_save();
+	serial_out(p, UART_IER, serial_in(p, UART_IER) | UART_IER_THRI);
+	__irq_restore(flags);
+}
+
+int serial_irq_init(int port)
+{
+	struct uart_irq_state *st;
+	struct uart_port *p;
+
+	if (port >= NUM_UART_PORT)
+		return -1;
+	st = &uart_irq_state[port];
+	p = &uart_config[port];
+	if (st->rx != NULL)
+		return 0;
+
+	st->port = p;
+	st->rx = xStreamBufferCreate(UART_RX_BUF_SIZE, 1);
+	st->tx = xStreamBufferCreate(UART_TX_BUF_SIZE, 1);
+	if ((st->rx == NULL) || (st->tx == NULL))
+		goto err;
+	if (irq_handler_add(p->irq, serial_irq_handler, st) != 0)
+		goto err;
+
+	serial_out(p, UART_IER, UART_IER_RDI | UART_IER_RLSI);
+	irq_enable(p->irq);
+	return 0;
+
+err:
+	if (st->rx != NULL)
+		vStreamBufferDelete(st->rx);
+	if (st->tx != NULL)
+		vStreamBufferDelete(st->tx);
+	st->rx = NULL;
+	st->tx = NULL;
+	return -1;
+}
+
+unsigned int serial_read(int port, void *buf, unsigned int len,
+			 unsigned int ticks)
+{
+	if ((port >= NUM_UART_PORT) || (uart_irq_state[port].rx == NULL))
+		return 0;
+	return xStreamBufferReceive(uart_irq_state[port].rx, buf, len,
+				    (portTickType)ticks);
+}
+
+unsigned int serial_write(int port, const void *buf, unsigned int len,
+			  unsigned int ticks)
+{
+	struct uart_irq_state *st;
+	unsigned int n = 0, m;
+
+	if ((port >= NUM_UART_PORT) || (uart_irq_state[port].tx == NULL))
+		return 0;
+	st = &uart_irq_state[port];
+	while (n < len) {
+		m = xStreamBufferSend(st->tx, (const unsigned char *)buf + n,
+				      len - n, (portTickType)ticks);
+		serial_start_tx(st->port);
+		if (m == 0)
+			break;
+		n += m;
+	}
+	return n;
+}
+#endif /* UART_IRQ_ENABLE */
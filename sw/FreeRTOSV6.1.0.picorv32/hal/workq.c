@@ -0,0 +1,200 @@
+// This is free and unencumbered software released into the public domain.
+//
+// Anyone is free to copy, modify, publish, use, compile, sell, or
+// distribute this software, either in source code form or as a compiled
+// binary, for any purpose, commercial or non-commercial, and by any
+// means.
+
+#include <stddef.h>
+#include <stdio.h>
+#include <system.h>
+#include <ring.h>
+#include <workq.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#ifdef WORKQ_ENABLE
+
+#if (WORKQ_ENTRIES & (WORKQ_ENTRIES - 1)) != 0
+#error "WORKQ_ENTRIES must be a power of 2"
+#endif
+
+struct work {
+	work_func_t func;
+	void *arg;
+	// rdcycle at the post
+	unsigned int stamp;
+};
+
+// a lib/ring.c ring with the daemon as its only consumer, which never
+// masks irq. the producers (handlers, nested with IRQ_NESTING_ENABLE, and
+// tasks) mask irq around the zero copy write themselves rather than calling
+// ring_mp_enqueue(): the same masked section counts the post and tells if
+// the ring was empty, which decides the wakeup of the daemon
+static struct work workq_buf[WORKQ_ENTRIES];
+static struct ring workq_ring;
+
+static xTaskHandle workq_task;
+
+// written by the producers with irq masked
+static unsigned int workq_posted;
+static unsigned int workq_dropped;
+static unsigned int workq_max_pending;
+// written by the daemon
+static unsigned int workq_wakeups;
+static unsigned int workq_batches;
+static unsigned int workq_max_batch;
+static unsigned int workq_max_latency;
+static unsigned long long workq_total_latency;
+
+// returns 1 if the ring was empty, the daemon then has to be woken
+static int workq_push(work_func_t func, void *arg)
+{
+	struct work *w;
+	unsigned int flags, pending, n;
+	int was_empty;
+
+	flags = __irq_save();
+	pending = ring_count(&workq_ring);
+	w = ring_write_peek(&workq_ring, &n);
+	if (n == 0) {
+		workq_dropped++;
+		__irq_restore(flags);
+		return -1;
+	}
+	w->func = func;
+	w->arg = arg;
+	w->stamp = rdcycle();
+	ring_write_commit(&workq_ring, 1);
+
+	workq_posted++;
+	if (pending + 1 > workq_max_pending)
+		workq_max_pending = pending + 1;
+	// a daemon that finds the ring not empty runs this entry before it
+	// blocks again, only the first entry of a burst wakes it
+	was_empty = (pending == 0);
+	__irq_restore(flags);
+
+	return was_empty;
+}
+
+int workq_post_from_isr(work_func_t func, void *arg, int *woken)
+{
+	signed portBASE_TYPE higher = pdFALSE;
+	int ret;
+
+	ret = workq_push(func, arg);
+	if (ret < 0)
+		return -1;
+	if (ret) {
+		vTaskNotifyGiveFromISR(workq_task, &higher);
+		if (higher == pdTRUE)
+			*woken = 1;
+	}
+	return 0;
+}
+
+int workq_post(work_func_t func, void *arg)
+{
+	int ret;
+
+	ret = workq_push(func, arg);
+	if (ret < 0)
+		return -1;
+	if (ret)
+		xTaskNotifyGive(workq_task);
+	return 0;
+}
+
+// run up to WORKQ_BATCH entries, returns the number run
+static unsigned int workq_run_batch(void)
+{
+	work_func_t func;
+	void *arg;
+	unsigned int latency, avail, n;
+	struct work *w;
+
+	for (n = 0; n < WORKQ_BATCH; n++) {
+		w = ring_read_peek(&workq_ring, &avail);
+		if (avail == 0)
+			break;
+		func = w->func;
+		arg = w->arg;
+		latency = rdcycle() - w->stamp;
+		// free the slot before the work runs, it may post again
+		ring_read_commit(&workq_ring, 1);
+
+		if (latency > workq_max_latency)
+			workq_max_latency = latency;
+		workq_total_latency += latency;
+
+		func(arg);
+	}
+	return n;
+}
+
+static void workq_daemon(void *arg)
+{
+	unsigned int n;
+
+	(void)arg;
+
+	for (;;) {
+		ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+		workq_wakeups++;
+
+		// one wakeup drains the ring. the tasks of the same priority
+		// run between two batches, the lower ones only once the ring
+		// is empty
+		while (!ring_empty(&workq_ring)) {
+			n = workq_run_batch();
+			workq_batches++;
+			if (n > workq_max_batch)
+				workq_max_batch = n;
+			if (!ring_empty(&workq_ring))
+				taskYIELD();
+		}
+	}
+}
+
+int workq_init(void)
+{
+	if (workq_task != NULL)
+		return 0;
+	ring_init(&workq_ring, workq_buf, WORKQ_ENTRIES, sizeof(workq_buf[0]));
+	if (xTaskCreate(workq_daemon, (signed char *)"WORKQ", WORKQ_STACK_SIZE,
+			NULL, WORKQ_PRIORITY, &workq_task) != pdPASS)
+		return -1;
+	return 0;
+}
+
+void workq_report(void)
+{
+	unsigned int posted, dropped, max_pending, wakeups, batches;
+	unsigned int max_batch, max_latency, run;
+	unsigned long long total_latency;
+	unsigned int flags;
+
+	// the daemon can not run while irq are masked
+	flags = __irq_save();
+	posted = workq_posted;
+	dropped = workq_dropped;
+	max_pending = workq_max_pending;
+	run = posted - ring_count(&workq_ring);
+	wakeups = workq_wakeups;
+	batches = workq_batches;
+	max_batch = workq_max_batch;
+	max_latency = workq_max_latency;
+	total_latency = workq_total_latency;
+	__irq_restore(flags);
+
+	printf("workq: posted %u dropped %u run %u max pending %u/%u\n",
+		posted, dropped, run, max_pending, WORKQ_ENTRIES);
+	printf("workq: wakeups %u batches %u max batch %u/%u\n",
+		wakeups, batches, max_batch, WORKQ_BATCH);
+	printf("workq: latency avg %u max %u cycles\n",
+		run ? (unsigned int)(total_latency / run) : 0, max_latency);
+}
+
+#endif /* WORKQ_ENABLE */
@@ -29,17 +29,145 @@
 
 #define IN_CLK  		(10*MHZ)
 
+/*
+ * instruction cache
+ * needs the bitstream built with ICACHE_ENABLE in soc.vh. fetches hit in one
+ * cycle, a miss fills the line with a Wishbone burst. icache_invalidate()
+ * (cache.h) must be called after code is written to memory, the miss count
+ * is read with icache_misses()
+ */
 /* #define ICACHE_ENABLE */
+#define ICACHE_CTRL_BASE	0xa0000000
+
+/*
+ * data cache
+ * needs the bitstream built with DCACHE_ENABLE in soc.vh. write-back, only
+ * the two srams are cached, the uart is not. a device that reads or writes
+ * memory on its own (dma) needs dcache_flush_range() before and
+ * dcache_invalidate_range() after, see cache.h. DCACHE_LINE_SIZE is the
+ * DCACHE_LINE_WORDS of soc.vh in bytes
+ */
 /* #define DCACHE_ENABLE */
+#define DCACHE_CTRL_BASE	0xa0000010
+#define DCACHE_LINE_SIZE	32
+
+/*
+ * nested irq support
+ * a handler only masks the irq lines with equal or lower priority
+ * (higher irq number) and runs with irq on, the timer irq is the highest
+ */
+/* #define IRQ_NESTING_ENABLE */
+
+/*
+ * irq event tracer
+ * every handled irq is recorded into a ring buffer (power of 2 entries),
+ * dumped by irq_trace_dump() and at a fault, decoded by sw/tools/irqtrace
+ */
+/* #define IRQ_TRACE_ENABLE */
+#define IRQ_TRACE_ENTRIES	256
+
+/*
+ * kernel event recorder
+ * task switches, ready, delay and suspend, queue operations, ticks and irq
+ * entry/exit with rdcycle stamps in a ring buffer (power of 2 entries).
+ * dumped by ktrace_dump() or read from a memory dump, converted to a
+ * chrome/perfetto trace by sw/tools/ktrace2json
+ */
+/* #define KERNEL_TRACE_ENABLE */
+#define KTRACE_ENTRIES		1024
+#define KTRACE_MAX_TASKS	16
+
+/*
+ * cpu cycle accounting
+ * cycles spent in every task (idle included), every irq line and the irq
+ * entry/exit path, reported by cpustat_report()
+ */
+/* #define CPU_STATS_ENABLE */
+#define CPU_STATS_MAX_TASKS	16
+
+/*
+ * pc sampling profiler
+ * the return pc and the running task of every timer irq are counted in a
+ * hash table (power of 2 buckets), see profile_start()/profile_dump().
+ * the dump is symbolised by sw/tools/profsym against System.map or the elf.
+ * with HRTIMER_ENABLE an hrtimer raises the timer irq PROFILE_HZ times a
+ * second, not a multiple of HZ so the samples do not lock to the tick
+ */
+/* #define PROFILE_ENABLE */
+#define PROFILE_BUCKETS		512
+#define PROFILE_MAX_TASKS	16
+#define PROFILE_HZ		997
+
+/*
+ * task stack statistics
+ * the stacks are painted at creation, stackstat_report() prints the size,
+ * peak use (high water mark) and a recommended size of every task: the peak
+ * plus STACK_STATS_MARGIN words. also checks the painted limit of the stack
+ * at every switch (configCHECK_FOR_STACK_OVERFLOW 2)
+ */
+/* #define STACK_STATS_ENABLE */
+#define STACK_STATS_MAX_TASKS	16
+#define STACK_STATS_MARGIN	128
+
+/*
+ * mutex contention statistics
+ * every mutex counts its takes and the takes that had to wait, and keeps the
+ * longest hold and wait times in cycles. lockstat_report() prints the
+ * LOCK_STATS_TOP most contended ones, named after the queue registry
+ */
+/* #define LOCK_STATS_ENABLE */
+#define LOCK_STATS_MAX_LOCKS	32
+#define LOCK_STATS_TOP		8
+
+/*
+ * irq driven uart
+ * rx and tx go through a stream buffer per port filled and drained by the
+ * uart irq handler, see serial_read()/serial_write(). the console output
+ * stays polled
+ */
+/* #define UART_IRQ_ENABLE */
+#define UART_RX_BUF_SIZE	256
+#define UART_TX_BUF_SIZE	256
+
+/*
+ * high resolution timers
+ * struct hrtimer expiries in cycles of the 64-bit counter, kept sorted; the
+ * tick timer irq is pulled in for the first expiry between two ticks, see
+ * hrtimer_start()/hrtimer_usleep(). needs the timer add instruction
+ */
+/* #define HRTIMER_ENABLE */
+
+/*
+ * irq deferred work
+ * an irq handler posts a function and its argument into a ring (power of 2
+ * entries) with workq_post_from_isr(), a daemon task of priority
+ * WORKQ_PRIORITY runs them with irq on, WORKQ_BATCH at a time with a yield
+ * to the tasks of the same priority in between. counts and post-to-run
+ * latencies are printed by workq_report()
+ */
+/* #define WORKQ_ENABLE */
+#define WORKQ_ENTRIES		64
+#define WORKQ_BATCH		8
+#define WORKQ_PRIORITY		(configMAX_PRIORITIES - 1)
+#define WORKQ_STACK_SIZE	512
 
 #define NUM_UART_PORT		1
 #define UART0_BASE		0x90000000
+#define UART0_IRQ		3
 #define UART0_REGSHIFT		0
 #define UART0_BAUD_RATE		38400
 #define UART0_DIVISOR		(IN_CLK/(16*UART0_BAUD_RATE))
 
 #define BOOT_SRAM_PHYS_ADDR	0x00000000
 #define BOOT_SRAM_SIZE		0x80000
+
+/*
+ * second sram, not loaded with the image
+ * variables marked __sram1 (system.h) are placed here, e.g. the TCB and
+ * stack buffers of xTaskCreateStatic()
+ */
+#define SRAM1_PHYS_ADDR		0x00480000
+#define SRAM1_SIZE		0x40000
 #define STACK_SIZE		(32*1024)
 #define MALLOC_SIZE		(128*1024)
 
@@ -0,0 +1,71 @@
+#ifndef _CACHE_H_
+#define _CACHE_H_
+
+#include <system.h>
+
+#ifdef ICACHE_ENABLE
+
+// drop every line of the instruction cache and clear the miss count. the
+// core does not snoop stores, call it after code is loaded or patched
+static __always_inline void icache_invalidate(void)
+{
+	writel(0, ICACHE_CTRL_BASE);
+}
+
+// line fills since reset or the last icache_invalidate()
+#define icache_misses()		readl(ICACHE_CTRL_BASE)
+
+#else
+
+#define icache_invalidate()	do { } while (0)
+#define icache_misses()		0
+
+#endif /* ICACHE_ENABLE */
+
+#ifdef DCACHE_ENABLE
+
+#define DCACHE_FLUSH		0x1
+#define DCACHE_INVALIDATE	0x2
+
+// write back every dirty line, the lines stay valid. done when it returns,
+// call it before icache_invalidate() for code written with stores
+static __always_inline void dcache_flush(void)
+{
+	writel(DCACHE_FLUSH, DCACHE_CTRL_BASE);
+}
+
+// drop every line, dirty ones are lost
+static __always_inline void dcache_invalidate(void)
+{
+	writel(DCACHE_INVALIDATE, DCACHE_CTRL_BASE);
+}
+
+static __always_inline void dcache_flush_invalidate(void)
+{
+	writel(DCACHE_FLUSH | DCACHE_INVALIDATE, DCACHE_CTRL_BASE);
+}
+
+// write back and drop the lines of [addr, addr + len), for a buffer a device
+// reads. the same operation is dcache_invalidate_range(), for a buffer a
+// device has written: its lines must have been flushed before the device
+// started, or the write back of a dirty line overwrites the new data
+extern void dcache_flush_range(const void *addr, unsigned int len);
+#define dcache_invalidate_range(addr, len)	dcache_flush_range(addr, len)
+
+// line fills and lines written back since reset
+#define dcache_misses()		readl(DCACHE_CTRL_BASE)
+#define dcache_writebacks()	readl(DCACHE_CTRL_BASE + 4)
+
+#else
+
+#define dcache_flush()				do { } while (0)
+#define dcache_invalidate()			do { } while (0)
+#define dcache_flush_invalidate()		do { } while (0)
+#define dcache_flush_range(addr, len)		do { } while (0)
+#define dcache_invalidate_range(addr, len)	do { } while (0)
+#define dcache_misses()				0
+#define dcache_writebacks()			0
+
+#endif /* DCACHE_ENABLE */
+
+#endif /* _CACHE_H_ */
@@ -0,0 +1,25 @@
+#ifndef _CPUSTAT_H_
+#define _CPUSTAT_H_
+
+#include <board.h>
+
+#ifdef CPU_STATS_ENABLE
+
+// called by do_irq() with irq disabled
+extern void cpustat_irq_enter(void);
+extern void cpustat_irq_exit(void);
+extern unsigned long long cpustat_handler_enter(void);
+extern void cpustat_handler_exit(unsigned int irq, unsigned long long start);
+
+// called by the kernel with irq disabled
+// returns the cycles run by the current task since the last call, the
+// cycles spent in irq handlers are not counted
+extern unsigned long long cpustat_task_slice(void);
+extern void cpustat_reset(void);
+
+// print the cycles of every task and irq line to the console
+extern void cpustat_report(void);
+
+#endif /* CPU_STATS_ENABLE */
+
+#endif /* _CPUSTAT_H_ */
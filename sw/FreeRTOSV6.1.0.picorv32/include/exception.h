@@ -6,7 +6,8 @@ struct ctx_regs_t {
 	unsigned int regs[32];
 	unsigned int crit_nesting;
 	unsigned int irq_status;
-	unsigned int dummy[2];
+	unsigned int frame_type;
+	unsigned int dummy[1];
 };
 #endif /* __ASSEMBLY__ */
 
@@ -46,6 +47,14 @@ struct ctx_regs_t {
 #define REG_X31 (0x7c)
 #define CRIT_NESTING (0x80)
 #define IRQ_STATUS (0x84)
+#define FRAME_TYPE (0x88)
+
+// ctx_regs[FRAME_TYPE/4]
+// FRAME_FULL: saved by irq_vec, every register is valid
+// FRAME_YIELD: saved by vPortYieldProcessor, a function call, only pc, ra,
+// sp, gp, tp, s0 ~ s11 and the critical nesting are valid
+#define FRAME_FULL  (0)
+#define FRAME_YIELD (1)
 
 #define REG_RA  REG_X1
 #define REG_SP  REG_X2
@@ -0,0 +1,52 @@
+#ifndef _HRTIMER_H_
+#define _HRTIMER_H_
+
+#include <board.h>
+
+// cycles of the 64-bit counter per microsecond
+#define HRTIMER_CYCLES_PER_US	(IN_CLK/MHZ)
+
+#define us_to_cycles(us)	((unsigned long long)(us) * HRTIMER_CYCLES_PER_US)
+#define cycles_to_us(c)		((unsigned long long)(c) / HRTIMER_CYCLES_PER_US)
+
+// monotonic time since reset, rdcycle/rdcycleh
+extern unsigned long long hrtimer_now(void);
+extern unsigned long long hrtimer_now_us(void);
+
+#ifdef HRTIMER_ENABLE
+
+struct hrtimer;
+
+// called from the timer irq with irq disabled, returns non-zero if it woke a
+// task that should run before the interrupted one
+typedef int (*hrtimer_func_t)(struct hrtimer *timer);
+
+struct hrtimer {
+	struct hrtimer *next;
+	// absolute expiry in cycles of hrtimer_now()
+	unsigned long long expires;
+	hrtimer_func_t func;
+	void *arg;
+	int queued;
+};
+
+extern void hrtimer_init(struct hrtimer *timer, hrtimer_func_t func, void *arg);
+// (re)arm at an absolute time, an expiry in the past runs at the next irq
+extern void hrtimer_start(struct hrtimer *timer, unsigned long long expires);
+// returns 1 if the timer was queued
+extern int hrtimer_cancel(struct hrtimer *timer);
+
+// block the calling task, the scheduler must be running
+// the wakeup is a semaphore on the stack of the sleeper, the task
+// notification value is left alone
+extern void hrtimer_usleep(unsigned int us);
+
+// called by the timer irq handler, returns 0 if the irq is not a tick
+extern int hrtimer_timer_irq(void);
+// called by the tickless idle with every irq line masked
+// returns the tick boundaries that may pass before the first expiry
+extern unsigned int hrtimer_idle_ticks(void);
+
+#endif /* HRTIMER_ENABLE */
+
+#endif /* _HRTIMER_H_ */
@@ -1,8 +1,20 @@
 #ifndef _IRQ_H_
 #define _IRQ_H_
 
+#include <board.h>
+#include <picorv32.h>
+
 #define NR_IRQS 32
 
+// lines handled by do_irq() itself, no handler can be installed on them
+#define IRQ_TIMER		0
+#define IRQ_EBREAK		1
+#define IRQ_BUS_ERROR		2
+#define NR_SYS_IRQS		3
+
+// all lines masked but ebreak and bus error, as set by start.S
+#define IRQ_DEFAULT_MASK	0xfffffff9
+
 #define IRQ_FLAGS_VALID		0x00000001
 #define IRQ_FLAGS_ENABLE	0x00000002
 
@@ -14,8 +26,26 @@ struct irq_handler_t
 	void *arg;
 };
 
-extern unsigned int __get_irq_mask(void);
-extern unsigned int __irq_mask(unsigned int);
+// set the irq mask (1: masked), returns the previous one
+static __always_inline unsigned int __irq_mask(unsigned int mask)
+{
+	return picorv32_maskirq(mask);
+}
+
+// maskirq has no read only form: swap the default mask in and put the
+// current one back
+static __always_inline unsigned int __get_irq_mask(void)
+{
+	unsigned int mask = picorv32_maskirq(IRQ_DEFAULT_MASK);
+
+	picorv32_maskirq(mask);
+	return mask;
+}
+
+#ifdef IRQ_NESTING_ENABLE
+extern void __irq_rearm(void);
+extern volatile unsigned int irq_nesting;
+#endif
 extern int irq_handler_add(unsigned int irq, void (*handler)(void *), void *arg);
 extern int irq_handler_del(unsigned int irq);
 extern int irq_enable(unsigned int irq);
@@ -0,0 +1,37 @@
+#ifndef _IRQ_TRACE_H_
+#define _IRQ_TRACE_H_
+
+#include <stdint.h>
+#include <board.h>
+
+#ifdef IRQ_TRACE_ENABLE
+
+#if (IRQ_TRACE_ENTRIES & (IRQ_TRACE_ENTRIES - 1)) != 0
+#error "IRQ_TRACE_ENTRIES must be a power of 2"
+#endif
+
+// the exit cycle of an event whose handler has not returned yet
+#define IRQ_TRACE_NO_EXIT	0xffffffff
+
+struct irq_trace_event_t
+{
+	uint32_t seq;		// event number, wraps
+	uint32_t pc;		// return pc of the interrupted context
+	uint32_t entry;		// rdcycle before the handler runs
+	uint32_t exit;		// rdcycle after the handler returns
+	uint8_t irq;
+	uint8_t depth;		// irq nesting depth, 1 for the outermost irq
+	uint16_t dummy;
+};
+
+// must be called with irq disabled
+// returns the event handle passed to irq_trace_exit()
+extern unsigned int irq_trace_enter(unsigned int irq, uint32_t pc);
+extern void irq_trace_exit(unsigned int ev);
+// print the ring buffer to the console, oldest event first
+extern void irq_trace_dump(void);
+extern void irq_trace_reset(void);
+
+#endif /* IRQ_TRACE_ENABLE */
+
+#endif /* _IRQ_TRACE_H_ */
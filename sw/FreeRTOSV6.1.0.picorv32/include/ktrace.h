@@ -0,0 +1,82 @@
+#ifndef _KTRACE_H_
+#define _KTRACE_H_
+
+#include <stdint.h>
+#include <board.h>
+
+#ifdef KERNEL_TRACE_ENABLE
+
+#if (KTRACE_ENTRIES & (KTRACE_ENTRIES - 1)) != 0
+#error "KTRACE_ENTRIES must be a power of 2"
+#endif
+
+// the event types, sw/tools/ktrace2json decodes them, keep in sync
+#define KTRACE_TASK_CREATE		1	// obj: tcb, arg: priority
+#define KTRACE_TASK_SWITCHED_IN		2	// obj: tcb, arg: priority
+#define KTRACE_TASK_SWITCHED_OUT	3	// obj: tcb
+#define KTRACE_TASK_READY		4	// obj: tcb, arg: priority
+#define KTRACE_TASK_DELAY		5	// obj: tcb
+#define KTRACE_TASK_SUSPEND		6	// obj: tcb
+#define KTRACE_TASK_RESUME		7	// obj: tcb
+#define KTRACE_TICK			8	// obj: tick count
+#define KTRACE_IRQ_ENTER		9	// obj: interrupted pc, arg: irq
+#define KTRACE_IRQ_EXIT			10	// arg: irq
+#define KTRACE_QUEUE_CREATE		11	// obj: queue
+#define KTRACE_QUEUE_SEND		12	// obj: queue
+#define KTRACE_QUEUE_SEND_FAILED	13	// obj: queue
+#define KTRACE_QUEUE_RECEIVE		14	// obj: queue
+#define KTRACE_QUEUE_RECEIVE_FAILED	15	// obj: queue
+#define KTRACE_QUEUE_PEEK		16	// obj: queue
+#define KTRACE_QUEUE_BLOCK_SEND		17	// obj: queue
+#define KTRACE_QUEUE_BLOCK_RECEIVE	18	// obj: queue
+#define KTRACE_QUEUE_SEND_ISR		19	// obj: queue
+#define KTRACE_QUEUE_RECEIVE_ISR	20	// obj: queue
+#define KTRACE_MUTEX_CREATE		21	// obj: queue
+#define KTRACE_QUEUE_DELETE		22	// obj: queue
+
+// "KTRC", marks the buffer in a memory dump
+#define KTRACE_MAGIC		0x4352544b
+#define KTRACE_NAME_LEN		16
+
+struct ktrace_event {
+	uint32_t cycle;		// rdcycle
+	uint32_t obj;
+	uint8_t type;
+	uint8_t arg;
+	uint16_t dummy;
+};
+
+struct ktrace_task {
+	uint32_t tcb;
+	char name[KTRACE_NAME_LEN];
+};
+
+// the whole recorder, read from a memory dump as it is
+struct ktrace_buf {
+	uint32_t magic;
+	uint32_t entries;	// KTRACE_ENTRIES
+	uint32_t max_tasks;	// KTRACE_MAX_TASKS
+	uint32_t clk;		// cycles per second
+	uint32_t seq;		// total number of events, the ring index is the low bits
+	uint32_t ntasks;
+	struct ktrace_task tasks[KTRACE_MAX_TASKS];
+	struct ktrace_event ev[KTRACE_ENTRIES];
+};
+
+extern struct ktrace_buf ktrace_buf;
+
+// called by the kernel trace macros (portmacro.h) and do_irq()
+extern void ktrace_record(unsigned int type, const void *obj, unsigned int arg);
+extern void ktrace_task_create(const void *tcb, const signed char *name,
+			       unsigned int prio);
+
+// stop and restart the recording, the ring keeps the last events
+extern void ktrace_stop(void);
+extern void ktrace_start(void);
+extern void ktrace_reset(void);
+// print the recorder to the console in hex, decoded by sw/tools/ktrace2json
+extern void ktrace_dump(void);
+
+#endif /* KERNEL_TRACE_ENABLE */
+
+#endif /* _KTRACE_H_ */
@@ -0,0 +1,14 @@
+#ifndef _LOCKSTAT_H_
+#define _LOCKSTAT_H_
+
+#include <board.h>
+
+#ifdef LOCK_STATS_ENABLE
+
+// print the takes, contended takes, longest hold and longest wait of the
+// most contended mutexes
+extern void lockstat_report(void);
+
+#endif /* LOCK_STATS_ENABLE */
+
+#endif /* _LOCKSTAT_H_ */
@@ -0,0 +1,107 @@
+#ifndef _PICORV32_H_
+#define _PICORV32_H_
+
+// the custom irq instructions of the picorv32 core as inline functions, the
+// assembly versions are in hal/custom_ops.S. the assembler does not know
+// them so they are emitted with .word, which needs fixed register numbers:
+// the operands are pinned to a0
+
+// r-type word of the custom-0 opcode
+#define PICORV32_INSN(f7, rs2, rs1, f3, rd) \
+	(((f7) << 25) | ((rs2) << 20) | ((rs1) << 15) | ((f3) << 12) | \
+	 ((rd) << 7) | 0x0b)
+
+#define PICORV32_REG_A0		10
+
+// the Makefile builds with -fno-inline, which leaves plain inline functions
+// out of line
+#ifndef __always_inline
+#define __always_inline		inline __attribute__((always_inline))
+#endif
+
+// the memory clobber keeps the accesses of a critical section inside it
+
+// irq on/off = v & 1, returns the previous state
+static __always_inline unsigned int picorv32_ctlirq(unsigned int v)
+{
+	register unsigned int a0 __asm__("a0") = v;
+
+	__asm__ __volatile__ (".word %1"
+		: "+r" (a0)
+		: "i" (PICORV32_INSN(0x06, 0, PICORV32_REG_A0, 6, PICORV32_REG_A0))
+		: "memory");
+	return a0;
+}
+
+// irq mask = v (1: masked), returns the previous mask. there is no read
+// only form, reading the mask takes two of them
+static __always_inline unsigned int picorv32_maskirq(unsigned int v)
+{
+	register unsigned int a0 __asm__("a0") = v;
+
+	__asm__ __volatile__ (".word %1"
+		: "+r" (a0)
+		: "i" (PICORV32_INSN(0x03, 0, PICORV32_REG_A0, 6, PICORV32_REG_A0))
+		: "memory");
+	return a0;
+}
+
+// load the timer and its reload value, returns the previous timer value
+static __always_inline unsigned int picorv32_timer(unsigned int v)
+{
+	register unsigned int a0 __asm__("a0") = v;
+
+	__asm__ __volatile__ (".word %1"
+		: "+r" (a0)
+		: "i" (PICORV32_INSN(0x05, 0, PICORV32_REG_A0, 6, PICORV32_REG_A0))
+		: "memory");
+	return a0;
+}
+
+// add cycles to the running timer, the reload value is kept
+// returns the timer value before the add, 0 if it is stopped
+static __always_inline unsigned int picorv32_timer_add(int cycles)
+{
+	register unsigned int a0 __asm__("a0") = (unsigned int)cycles;
+
+	__asm__ __volatile__ (".word %1"
+		: "+r" (a0)
+		: "i" (PICORV32_INSN(0x05, 1, PICORV32_REG_A0, 6, PICORV32_REG_A0))
+		: "memory");
+	return a0;
+}
+
+// sleep until an irq is pending, masked irqs included
+// returns the pending irq bits
+static __always_inline unsigned int picorv32_waitirq(void)
+{
+	register unsigned int a0 __asm__("a0");
+
+	__asm__ __volatile__ (".word %1"
+		: "=r" (a0)
+		: "i" (PICORV32_INSN(0x04, 0, 0, 4, PICORV32_REG_A0))
+		: "memory");
+	return a0;
+}
+
+// q0-q3, q must be a constant. irq_vec saves q0 (return pc) and q1 (irq
+// bits) in the frame, q2 and q3 are free
+#define picorv32_getq(q) \
+({ \
+	register unsigned int __v __asm__("a0"); \
+	__asm__ __volatile__ (".word %1" \
+		: "=r" (__v) \
+		: "i" (PICORV32_INSN(0x00, 0, (q), 4, PICORV32_REG_A0))); \
+	__v; \
+})
+
+#define picorv32_setq(q, v) \
+do { \
+	register unsigned int __v __asm__("a0") = (v); \
+	__asm__ __volatile__ (".word %1" \
+		: \
+		: "r" (__v), \
+		  "i" (PICORV32_INSN(0x01, 0, PICORV32_REG_A0, 2, (q)))); \
+} while (0)
+
+#endif /* _PICORV32_H_ */
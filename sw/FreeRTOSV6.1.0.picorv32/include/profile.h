@@ -0,0 +1,24 @@
+#ifndef _PROFILE_H_
+#define _PROFILE_H_
+
+#include <stdint.h>
+#include <board.h>
+
+#ifdef PROFILE_ENABLE
+
+// called by do_irq() at every timer irq with irq disabled
+// pc is the return pc of the interrupted code
+extern void profile_sample(uint32_t pc);
+
+// samples are only taken between start and stop
+// with HRTIMER_ENABLE, start also arms a PROFILE_HZ sampling timer
+extern void profile_start(void);
+extern void profile_stop(void);
+extern void profile_reset(void);
+
+// print the histogram to the console, symbolised by sw/tools/profsym
+extern void profile_dump(void);
+
+#endif /* PROFILE_ENABLE */
+
+#endif /* _PROFILE_H_ */
@@ -0,0 +1,57 @@
+#ifndef _RING_H_
+#define _RING_H_
+
+// single producer, single consumer ring of fixed size entries
+//
+// the number of entries is a power of 2 and the head and tail indexes run
+// freely, the ring is full when they are that many entries apart. the tail
+// is only written by the producer and the head only by the consumer, so
+// either side can be an irq handler and the other a task without masking
+// irq. both run on the one in-order core, which sees its own accesses in
+// program order, through the data cache too (DCACHE_ENABLE): the barrier()
+// calls only stop the compiler from moving the entry accesses across the
+// index updates. a bus master other than the core (dma) must not use a ring
+// without its own ordering and cache maintenance
+//
+// several producers (tasks and irq handlers) use the ring_mp_*() calls,
+// which serialise them by masking irq around the reservation and the copy:
+// rv32i has no atomic instructions. the consumer side stays the same
+
+struct ring {
+	unsigned char *buf;
+	unsigned int esize;		// entry size in bytes
+	unsigned int mask;		// entries - 1
+	volatile unsigned int head;	// next entry to read
+	volatile unsigned int tail;	// next entry to write
+};
+
+// buf holds entries * esize bytes, entries must be a power of 2
+// returns 0, or -1 if entries is not a power of 2
+extern int ring_init(struct ring *r, void *buf, unsigned int entries,
+		unsigned int esize);
+
+// entries that can be read, entries that can be written
+#define ring_count(r)		((r)->tail - (r)->head)
+#define ring_space(r)		((r)->mask + 1 - ring_count(r))
+#define ring_empty(r)		(ring_count(r) == 0)
+#define ring_full(r)		(ring_space(r) == 0)
+
+// copy up to n entries in or out, returns the number copied
+extern unsigned int ring_enqueue(struct ring *r, const void *src,
+		unsigned int n);
+extern unsigned int ring_dequeue(struct ring *r, void *dst, unsigned int n);
+
+// zero copy: returns the address of the next entries to write (read) and
+// sets *n to how many of them are contiguous, 0 if the ring is full (empty).
+// the entries are handed over by the commit of at most that many. a second
+// peek after a commit returns the part after the wrap
+extern void *ring_write_peek(struct ring *r, unsigned int *n);
+extern void ring_write_commit(struct ring *r, unsigned int n);
+extern void *ring_read_peek(struct ring *r, unsigned int *n);
+extern void ring_read_commit(struct ring *r, unsigned int n);
+
+// ring_enqueue() for several producers, callable from a handler
+extern unsigned int ring_mp_enqueue(struct ring *r, const void *src,
+		unsigned int n);
+
+#endif /* _RING_H_ */
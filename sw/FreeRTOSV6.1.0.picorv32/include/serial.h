@@ -1,11 +1,14 @@
 #ifndef _SERIAL_H_
 #define _SERIAL_H_
 
+#include <board.h>
+
 struct uart_port {
         unsigned int base;
         unsigned int regshift;
         unsigned int baud_rate;
         unsigned int divisor;
+        unsigned int irq;
 };
 
 #define UART0_PORT_IDX	0
@@ -22,5 +25,19 @@ extern void serial_putdec(int port, unsigned int val);
 extern void serial_puthex(int port, unsigned int val, int digits);
 extern void serial_puts(int port, const char *s);
 
+#ifdef UART_IRQ_ENABLE
+// create the rx/tx stream buffers of the port and enable its irq
+// serial_getc()/serial_tstc() read the rx stream buffer from then on
+extern int serial_irq_init(int port);
+// read up to len bytes, wait up to ticks for the first one
+// returns the number of bytes read
+extern unsigned int serial_read(int port, void *buf, unsigned int len,
+				unsigned int ticks);
+// queue len bytes for the irq handler, wait up to ticks each time the tx
+// stream buffer is full. returns the number of bytes queued
+extern unsigned int serial_write(int port, const void *buf, unsigned int len,
+				 unsigned int ticks);
+#endif
+
 #endif // _SERIAL_H_
 
@@ -0,0 +1,13 @@
+#ifndef _STACKSTAT_H_
+#define _STACKSTAT_H_
+
+#include <board.h>
+
+#ifdef STACK_STATS_ENABLE
+
+// print the stack size, peak use and a recommended size of every task
+extern void stackstat_report(void);
+
+#endif /* STACK_STATS_ENABLE */
+
+#endif /* _STACKSTAT_H_ */
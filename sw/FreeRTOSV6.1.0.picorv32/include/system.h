@@ -2,6 +2,7 @@
 #define _SYSTEM_H_
 
 #include "board.h"
+#include "picorv32.h"
 
 #define readb(addr)		(*(volatile unsigned char *) (addr))
 #define readw(addr)		(*(volatile unsigned short *) (addr))
@@ -22,16 +23,53 @@
 
 #define nop()			__asm__ __volatile__ ("":::"memory")
 
+/* cycle counter, the core is built with ENABLE_COUNTERS */
+#define rdcycle() \
+({ \
+	unsigned int __v; \
+	__asm__ __volatile__ ("rdcycle %0" : "=r" (__v)); \
+	__v; \
+})
+
+#define rdcycleh() \
+({ \
+	unsigned int __v; \
+	__asm__ __volatile__ ("rdcycleh %0" : "=r" (__v)); \
+	__v; \
+})
+
+// place a variable in SRAM1, it is not cleared at boot
+#define __sram1			__attribute__ ((section(".sram1")))
+
+// 64-bit cycle counter, never wraps in practice
+extern unsigned long long get_cycles64(void);
+
+// the irq control functions are inlined, each is one ctlirq instruction
+
 // disalbe irq and
 // 1. return 1: irq is on before
 // 2. return 0: irq is off before
-extern unsigned int __irq_save(void);
+static __always_inline unsigned int __irq_save(void)
+{
+	return picorv32_ctlirq(0);
+}
+
 // flags: 0 => disable irq
 // flags: 1 => enable irq
-extern void __irq_restore(unsigned int flags);
+static __always_inline void __irq_restore(unsigned int flags)
+{
+	picorv32_ctlirq(flags);
+}
 
-extern void __irq_disable(void);
-extern void __irq_enable(void);
+static __always_inline void __irq_disable(void)
+{
+	picorv32_ctlirq(0);
+}
+
+static __always_inline void __irq_enable(void)
+{
+	picorv32_ctlirq(1);
+}
 
 extern const unsigned int __malloc_start;
 extern const unsigned int __malloc_end;
@@ -42,6 +80,18 @@ extern const unsigned int sys_stack_top;
 extern void hal_init(void);
 
 extern void timer_enable(unsigned int);
+// move the next timer irq by cycles without changing the period
+// returns the cycles left before the add
+static __always_inline unsigned int timer_add(int cycles)
+{
+	return picorv32_timer_add(cycles);
+}
+
+// sleep until an irq is pending, returns the pending irq bits
+static __always_inline unsigned int __wait_irq(void)
+{
+	return picorv32_waitirq();
+}
 extern unsigned int get_timer_tick(void);
 
 #define BUG() \
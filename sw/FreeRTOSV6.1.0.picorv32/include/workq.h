@@ -0,0 +1,28 @@
+#ifndef _WORKQ_H_
+#define _WORKQ_H_
+
+#include <board.h>
+
+#ifdef WORKQ_ENABLE
+
+// runs in the workq daemon task, with irq on
+typedef void (*work_func_t)(void *arg);
+
+// create the daemon task, called by hal_init()
+extern int workq_init(void);
+
+// defer func(arg) to the daemon from an irq handler
+// returns 0, or -1 if the ring is full (counted as dropped). sets *woken if
+// the daemon must run before the interrupted task, the handler then calls
+// portYIELD_FROM_ISR() once before it returns
+extern int workq_post_from_isr(work_func_t func, void *arg, int *woken);
+// the same from a task
+extern int workq_post(work_func_t func, void *arg);
+
+// print the posted/dropped/run counts, the batch sizes and the latency from
+// the post to the start of the work
+extern void workq_report(void);
+
+#endif /* WORKQ_ENABLE */
+
+#endif /* _WORKQ_H_ */
@@ -0,0 +1,224 @@
+/*
+    FreeRTOS V6.1.0 - Copyright (C) 2010 Real Time Engineers Ltd.
+
+    ***************************************************************************
+    *                                                                         *
+    * If you are:                                                             *
+    *                                                                         *
+    *    + New to FreeRTOS,                                                   *
+    *    + Wanting to learn FreeRTOS or multitasking in general quickly       *
+    *    + Looking for basic training,                                        *
+    *    + Wanting to improve your FreeRTOS skills and productivity           *
+    *                                                                         *
+    * then take a look at the FreeRTOS books - available as PDF or paperback  *
+    *                                                                         *
+    *        "Using the FreeRTOS Real Time Kernel - a Practical Guide"        *
+    *                  http://www.FreeRTOS.org/Documentation                  *
+    *                                                                         *
+    * A pdf reference manual is also available.  Both are usually delivered   *
+    * to your inbox within 20 minutes to two hours when purchased between 8am *
+    * and 8pm GMT (although please allow up to 24 hours in case of            *
+    * exceptional circumstances).  Thank you for your support!                *
+    *                                                                         *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    ***NOTE*** The exception to the GPL is included to allow you to distribute
+    a combined work that includes FreeRTOS without being obliged to provide the
+    source code for proprietary components outside of the FreeRTOS kernel.
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public 
+    License and the FreeRTOS license exception along with FreeRTOS; if not it 
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained 
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+/*
+ * A pool of fixed size blocks.  The free blocks are kept as pointers in a
+ * queue so allocation and release have the cost of passing a pointer through
+ * a queue, whatever the block size, and tasks can block waiting for a block.
+ */
+
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "bufpool.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/*
+ * Definition of the pool.  The blocks follow the structure in the same heap
+ * allocation.
+ */
+typedef struct BufferPoolDefinition
+{
+	xQueueHandle xFreeBlocks;				/*< Queue holding a pointer to each free block. */
+	unsigned char *pucBlocks;				/*< Start of the first block. */
+	unsigned portBASE_TYPE uxBlockCount;	/*< The number of blocks in the pool. */
+	size_t xBlockSize;						/*< The size of each block, a multiple of portBYTE_ALIGNMENT. */
+} xBUFFER_POOL;
+
+/*
+ * Returns pdTRUE if pvBlock is the start of one of the blocks of the pool.
+ */
+static portBASE_TYPE prvIsPoolBlock( const xBUFFER_POOL * const pxPool, const void *pvBlock ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+xBufferPoolHandle xBufferPoolCreate( unsigned portBASE_TYPE uxBlockCount, size_t xBlockSize )
+{
+xBUFFER_POOL *pxPool;
+size_t xHeaderSize;
+unsigned portBASE_TYPE ux;
+void *pvBlock;
+
+	if( ( uxBlockCount == ( unsigned portBASE_TYPE ) 0 ) || ( xBlockSize == ( size_t ) 0 ) )
+	{
+		return NULL;
+	}
+
+	/* Keep every block aligned as pvPortMalloc() would. */
+	xBlockSize = ( xBlockSize + portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+	xHeaderSize = ( sizeof( xBUFFER_POOL ) + portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+	pxPool = ( xBUFFER_POOL * ) pvPortMalloc( xHeaderSize + ( ( size_t ) uxBlockCount * xBlockSize ) );
+	if( pxPool == NULL )
+	{
+		return NULL;
+	}
+
+	pxPool->xFreeBlocks = xQueueCreate( uxBlockCount, sizeof( void * ) );
+	if( pxPool->xFreeBlocks == NULL )
+	{
+		vPortFree( pxPool );
+		return NULL;
+	}
+
+	pxPool->pucBlocks = ( ( unsigned char * ) pxPool ) + xHeaderSize;
+	pxPool->uxBlockCount = uxBlockCount;
+	pxPool->xBlockSize = xBlockSize;
+
+	/* All the blocks start free.  The queue is as long as the pool so this
+	cannot fail. */
+	for( ux = 0; ux < uxBlockCount; ux++ )
+	{
+		pvBlock = ( void * ) ( pxPool->pucBlocks + ( ( size_t ) ux * xBlockSize ) );
+		xQueueSend( pxPool->xFreeBlocks, &pvBlock, ( portTickType ) 0 );
+	}
+
+	return ( xBufferPoolHandle ) pxPool;
+}
+/*-----------------------------------------------------------*/
+
+void *pvBufferPoolAlloc( xBufferPoolHandle xPool, portTickType xTicksToWait )
+{
+xBUFFER_POOL * const pxPool = ( xBUFFER_POOL * ) xPool;
+void *pvBlock;
+
+	if( xQueueReceive( pxPool->xFreeBlocks, &pvBlock, xTicksToWait ) != pdPASS )
+	{
+		pvBlock = NULL;
+	}
+
+	return pvBlock;
+}
+/*-----------------------------------------------------------*/
+
+void *pvBufferPoolAllocFromISR( xBufferPoolHandle xPool, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+xBUFFER_POOL * const pxPool = ( xBUFFER_POOL * ) xPool;
+void *pvBlock;
+
+	if( xQueueReceiveFromISR( pxPool->xFreeBlocks, &pvBlock, pxHigherPriorityTaskWoken ) != pdPASS )
+	{
+		pvBlock = NULL;
+	}
+
+	return pvBlock;
+}
+/*-----------------------------------------------------------*/
+
+signed portBASE_TYPE xBufferPoolFree( xBufferPoolHandle xPool, void *pvBlock )
+{
+xBUFFER_POOL * const pxPool = ( xBUFFER_POOL * ) xPool;
+
+	if( prvIsPoolBlock( pxPool, pvBlock ) == pdFALSE )
+	{
+		return pdFAIL;
+	}
+
+	/* There is always room for a block that was allocated, the send only
+	fails if the block is freed twice. */
+	return xQueueSend( pxPool->xFreeBlocks, &pvBlock, ( portTickType ) 0 );
+}
+/*-----------------------------------------------------------*/
+
+signed portBASE_TYPE xBufferPoolFreeFromISR( xBufferPoolHandle xPool, void *pvBlock, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+xBUFFER_POOL * const pxPool = ( xBUFFER_POOL * ) xPool;
+
+	if( prvIsPoolBlock( pxPool, pvBlock ) == pdFALSE )
+	{
+		return pdFAIL;
+	}
+
+	return xQueueSendFromISR( pxPool->xFreeBlocks, &pvBlock, pxHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
+
+size_t xBufferPoolGetBlockSize( xBufferPoolHandle xPool )
+{
+	return ( ( xBUFFER_POOL * ) xPool )->xBlockSize;
+}
+/*-----------------------------------------------------------*/
+
+unsigned portBASE_TYPE uxBufferPoolFreeBlocks( xBufferPoolHandle xPool )
+{
+	return uxQueueMessagesWaiting( ( ( xBUFFER_POOL * ) xPool )->xFreeBlocks );
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvIsPoolBlock( const xBUFFER_POOL * const pxPool, const void *pvBlock )
+{
+size_t xOffset;
+
+	if( ( const unsigned char * ) pvBlock < pxPool->pucBlocks )
+	{
+		return pdFALSE;
+	}
+
+	xOffset = ( size_t ) ( ( const unsigned char * ) pvBlock - pxPool->pucBlocks );
+	if( ( xOffset >= ( ( size_t ) pxPool->uxBlockCount * pxPool->xBlockSize ) ) || ( ( xOffset % pxPool->xBlockSize ) != ( size_t ) 0 ) )
+	{
+		return pdFALSE;
+	}
+
+	return pdTRUE;
+}
+
@@ -120,6 +120,12 @@ static void prvCheckPendingReadyList( void );
  */
 static void prvCheckDelayedList( void );
 
+/*
+ * Fills the co-routine control block and adds the co-routine to the ready
+ * list.  Shared by xCoRoutineCreate() and xCoRoutineCreateStatic().
+ */
+static void prvInitialiseNewCoRoutine( corCRCB *pxCoRoutine, crCOROUTINE_CODE pxCoRoutineCode, unsigned portBASE_TYPE uxPriority, unsigned portBASE_TYPE uxIndex );
+
 /*-----------------------------------------------------------*/
 
 signed portBASE_TYPE xCoRoutineCreate( crCOROUTINE_CODE pxCoRoutineCode, unsigned portBASE_TYPE uxPriority, unsigned portBASE_TYPE uxIndex )
@@ -131,42 +137,7 @@ corCRCB *pxCoRoutine;
 	pxCoRoutine = ( corCRCB * ) pvPortMalloc( sizeof( corCRCB ) );
 	if( pxCoRoutine )
 	{
-		/* If pxCurrentCoRoutine is NULL then this is the first co-routine to
-		be created and the co-routine data structures need initialising. */
-		if( pxCurrentCoRoutine == NULL )
-		{
-			pxCurrentCoRoutine = pxCoRoutine;
-			prvInitialiseCoRoutineLists();
-		}
-
-		/* Check the priority is within limits. */
-		if( uxPriority >= configMAX_CO_ROUTINE_PRIORITIES )
-		{
-			uxPriority = configMAX_CO_ROUTINE_PRIORITIES - 1;
-		}
-
-		/* Fill out the co-routine control block from the function parameters. */
-		pxCoRoutine->uxState = corINITIAL_STATE;
-		pxCoRoutine->uxPriority = uxPriority;
-		pxCoRoutine->uxIndex = uxIndex;
-		pxCoRoutine->pxCoRoutineFunction = pxCoRoutineCode;
-
-		/* Initialise all the other co-routine control block parameters. */
-		vListInitialiseItem( &( pxCoRoutine->xGenericListItem ) );
-		vListInitialiseItem( &( pxCoRoutine->xEventListItem ) );
-
-		/* Set the co-routine control block as a link back from the xListItem.
-		This is so we can get back to the containing CRCB from a generic item
-		in a list. */
-		listSET_LIST_ITEM_OWNER( &( pxCoRoutine->xGenericListItem ), pxCoRoutine );
-		listSET_LIST_ITEM_OWNER( &( pxCoRoutine->xEventListItem ), pxCoRoutine );
-	
-		/* Event lists are always in priority order. */
-		listSET_LIST_ITEM_VALUE( &( pxCoRoutine->xEventListItem ), configMAX_PRIORITIES - ( portTickType ) uxPriority );
-		
-		/* Now the co-routine has been initialised it can be added to the ready
-		list at the correct priority. */
-		prvAddCoRoutineToReadyQueue( pxCoRoutine );
+		prvInitialiseNewCoRoutine( pxCoRoutine, pxCoRoutineCode, uxPriority, uxIndex );
 
 		xReturn = pdPASS;
 	}
@@ -179,6 +150,70 @@ corCRCB *pxCoRoutine;
 }
 /*-----------------------------------------------------------*/
 
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	signed portBASE_TYPE xCoRoutineCreateStatic( crCOROUTINE_CODE pxCoRoutineCode, unsigned portBASE_TYPE uxPriority, unsigned portBASE_TYPE uxIndex, corCRCB *pxCoRoutineBuffer )
+	{
+	signed portBASE_TYPE xReturn;
+
+		if( pxCoRoutineBuffer != NULL )
+		{
+			prvInitialiseNewCoRoutine( pxCoRoutineBuffer, pxCoRoutineCode, uxPriority, uxIndex );
+			xReturn = pdPASS;
+		}
+		else
+		{
+			xReturn = pdFAIL;
+		}
+
+		return xReturn;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewCoRoutine( corCRCB *pxCoRoutine, crCOROUTINE_CODE pxCoRoutineCode, unsigned portBASE_TYPE uxPriority, unsigned portBASE_TYPE uxIndex )
+{
+	/* If pxCurrentCoRoutine is NULL then this is the first co-routine to
+	be created and the co-routine data structures need initialising. */
+	if( pxCurrentCoRoutine == NULL )
+	{
+		pxCurrentCoRoutine = pxCoRoutine;
+		prvInitialiseCoRoutineLists();
+	}
+
+	/* Check the priority is within limits. */
+	if( uxPriority >= configMAX_CO_ROUTINE_PRIORITIES )
+	{
+		uxPriority = configMAX_CO_ROUTINE_PRIORITIES - 1;
+	}
+
+	/* Fill out the co-routine control block from the function parameters. */
+	pxCoRoutine->uxState = corINITIAL_STATE;
+	pxCoRoutine->uxPriority = uxPriority;
+	pxCoRoutine->uxIndex = uxIndex;
+	pxCoRoutine->pxCoRoutineFunction = pxCoRoutineCode;
+
+	/* Initialise all the other co-routine control block parameters. */
+	vListInitialiseItem( &( pxCoRoutine->xGenericListItem ) );
+	vListInitialiseItem( &( pxCoRoutine->xEventListItem ) );
+
+	/* Set the co-routine control block as a link back from the xListItem.
+	This is so we can get back to the containing CRCB from a generic item
+	in a list. */
+	listSET_LIST_ITEM_OWNER( &( pxCoRoutine->xGenericListItem ), pxCoRoutine );
+	listSET_LIST_ITEM_OWNER( &( pxCoRoutine->xEventListItem ), pxCoRoutine );
+
+	/* Event lists are always in priority order.  The co-routine
+	priorities, not the task priorities, are what is compared. */
+	listSET_LIST_ITEM_VALUE( &( pxCoRoutine->xEventListItem ), configMAX_CO_ROUTINE_PRIORITIES - ( portTickType ) uxPriority );
+	
+	/* Now the co-routine has been initialised it can be added to the ready
+	list at the correct priority. */
+	prvAddCoRoutineToReadyQueue( pxCoRoutine );
+}
+/*-----------------------------------------------------------*/
+
 void vCoRoutineAddToDelayedList( portTickType xTicksToDelay, xList *pxEventList )
 {
 portTickType xTimeToWake;
@@ -298,6 +333,13 @@ corCRCB *pxCRCB;
 
 void vCoRoutineSchedule( void )
 {
+	/* The idle hook runs the co-routines whether any were created or not,
+	the lists are only initialised by the first xCoRoutineCreate(). */
+	if( pxDelayedCoRoutineList == NULL )
+	{
+		return;
+	}
+
 	/* See if any co-routines readied by events need moving to the ready lists. */
 	prvCheckPendingReadyList();
 
@@ -368,4 +410,61 @@ signed portBASE_TYPE xReturn;
 
 	return xReturn;
 }
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TICKLESS_IDLE == 1 )
+
+	portTickType xCoRoutineGetExpectedIdleTime( void )
+	{
+	unsigned portBASE_TYPE uxPriority;
+	portTickType xToWake, xPassed;
+	corCRCB *pxCRCB;
+
+		if( pxDelayedCoRoutineList == NULL )
+		{
+			/* No co-routine was created. */
+			return portMAX_DELAY;
+		}
+
+		if( listLIST_IS_EMPTY( &xPendingReadyCoRoutineList ) == pdFALSE )
+		{
+			return ( portTickType ) 0;
+		}
+
+		for( uxPriority = 0; uxPriority <= uxTopCoRoutineReadyPriority; uxPriority++ )
+		{
+			if( listLIST_IS_EMPTY( &( pxReadyCoRoutineLists[ uxPriority ] ) ) == pdFALSE )
+			{
+				return ( portTickType ) 0;
+			}
+		}
+
+		/* The co-routine tick count caught up with the task tick count at
+		xLastTickCount, the wake times are counted from there.  A delay past
+		the wrap is in the overflow list, and is only first when the current
+		list is empty. */
+		if( listLIST_IS_EMPTY( pxDelayedCoRoutineList ) == pdFALSE )
+		{
+			pxCRCB = ( corCRCB * ) listGET_OWNER_OF_HEAD_ENTRY( pxDelayedCoRoutineList );
+		}
+		else if( listLIST_IS_EMPTY( pxOverflowDelayedCoRoutineList ) == pdFALSE )
+		{
+			pxCRCB = ( corCRCB * ) listGET_OWNER_OF_HEAD_ENTRY( pxOverflowDelayedCoRoutineList );
+		}
+		else
+		{
+			return portMAX_DELAY;
+		}
+
+		xToWake = listGET_LIST_ITEM_VALUE( &( pxCRCB->xGenericListItem ) ) - xLastTickCount;
+		xPassed = xTaskGetTickCount() - xLastTickCount;
+
+		if( xPassed >= xToWake )
+		{
+			return ( portTickType ) 0;
+		}
+
+		return xToWake - xPassed;
+	}
 
+#endif /* configUSE_TICKLESS_IDLE */
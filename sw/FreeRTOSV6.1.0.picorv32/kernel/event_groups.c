@@ -0,0 +1,531 @@
+/*
+    FreeRTOS V6.1.0 - Copyright (C) 2010 Real Time Engineers Ltd.
+
+    ***************************************************************************
+    *                                                                         *
+    * If you are:                                                             *
+    *                                                                         *
+    *    + New to FreeRTOS,                                                   *
+    *    + Wanting to learn FreeRTOS or multitasking in general quickly       *
+    *    + Looking for basic training,                                        *
+    *    + Wanting to improve your FreeRTOS skills and productivity           *
+    *                                                                         *
+    * then take a look at the FreeRTOS books - available as PDF or paperback  *
+    *                                                                         *
+    *        "Using the FreeRTOS Real Time Kernel - a Practical Guide"        *
+    *                  http://www.FreeRTOS.org/Documentation                  *
+    *                                                                         *
+    * A pdf reference manual is also available.  Both are usually delivered   *
+    * to your inbox within 20 minutes to two hours when purchased between 8am *
+    * and 8pm GMT (although please allow up to 24 hours in case of            *
+    * exceptional circumstances).  Thank you for your support!                *
+    *                                                                         *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    ***NOTE*** The exception to the GPL is included to allow you to distribute
+    a combined work that includes FreeRTOS without being obliged to provide the
+    source code for proprietary components outside of the FreeRTOS kernel.
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public 
+    License and the FreeRTOS license exception along with FreeRTOS; if not it 
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained 
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+
+/*
+ * Event groups.  The tasks blocked on an event group wait in an unordered
+ * event list, the event list item value of each task holds the bits it waits
+ * for and how.  Setting bits walks the whole list with the scheduler
+ * suspended, so interrupts stay enabled however many tasks wait.  For the
+ * same reason the interrupts do not set bits themselves, the event group
+ * daemon task does it for them.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "event_groups.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* The top byte of the event list item value of a waiting task holds how it
+waits, the other bits what it waits for.  The top bit of the byte is used by
+tasks.c. */
+#if ( configUSE_16_BIT_TICKS == 1 )
+	#define egCLEAR_EVENTS_ON_EXIT_BIT		( ( xEventBits ) 0x0100U )
+	#define egUNBLOCKED_DUE_TO_BIT_SET		( ( xEventBits ) 0x0200U )
+	#define egWAIT_FOR_ALL_BITS				( ( xEventBits ) 0x0400U )
+	#define egEVENT_BITS_CONTROL_BYTES		( ( xEventBits ) 0xff00U )
+#else
+	#define egCLEAR_EVENTS_ON_EXIT_BIT		( ( xEventBits ) 0x01000000UL )
+	#define egUNBLOCKED_DUE_TO_BIT_SET		( ( xEventBits ) 0x02000000UL )
+	#define egWAIT_FOR_ALL_BITS				( ( xEventBits ) 0x04000000UL )
+	#define egEVENT_BITS_CONTROL_BYTES		( ( xEventBits ) 0xff000000UL )
+#endif
+
+typedef struct EventGroupDefinition
+{
+	xEventBits uxEventBits;
+	xList xTasksWaitingForBits;		/*< Tasks blocked on the group, in no particular order. */
+	unsigned char ucStaticallyAllocated;
+} xEVENT_GROUP;
+
+/* xStaticEventGroup in event_groups.h must have the same size as
+xEVENT_GROUP.  The array size is negative, and the build fails, if it does
+not. */
+typedef char egSTATIC_EVENT_GROUP_SIZE_CHECK[ ( sizeof( xStaticEventGroup ) == sizeof( xEVENT_GROUP ) ) ? 1 : -1 ];
+
+#if ( INCLUDE_xEventGroupSetBitsFromISR == 1 )
+
+	/* A request of xEventGroupSetBitsFromISR() or
+	xEventGroupClearBitsFromISR() to the daemon task. */
+	typedef struct EventGroupRequest
+	{
+		xEVENT_GROUP *pxEventGroup;
+		xEventBits uxBits;
+		portBASE_TYPE xSet;
+	} xEVENT_GROUP_REQUEST;
+
+	PRIVILEGED_DATA static xQueueHandle xEventGroupRequests = NULL;
+
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		PRIVILEGED_DATA static xStaticQueue xEventGroupQueue;
+		PRIVILEGED_DATA static xEVENT_GROUP_REQUEST xEventGroupQueueStorage[ configEVENT_GROUP_QUEUE_LENGTH ];
+		PRIVILEGED_DATA static xStaticTask xEventGroupDaemonTCB;
+		PRIVILEGED_DATA static portSTACK_TYPE xEventGroupDaemonStack[ configEVENT_GROUP_DAEMON_STACK_DEPTH ];
+	#endif
+
+	static void prvEventGroupDaemon( void *pvParameters ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Returns pdTRUE if uxCurrentEventBits meets the condition of a task waiting
+ * for uxBitsToWaitFor, any or all of them.
+ */
+static portBASE_TYPE prvTestWaitCondition( const xEventBits uxCurrentEventBits, const xEventBits uxBitsToWaitFor, const portBASE_TYPE xWaitForAllBits ) PRIVILEGED_FUNCTION;
+
+static void prvInitialiseNewEventGroup( xEVENT_GROUP * const pxEventGroup, unsigned char ucStaticallyAllocated ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+xEventGroupHandle xEventGroupCreate( void )
+{
+xEVENT_GROUP *pxEventGroup;
+
+	pxEventGroup = ( xEVENT_GROUP * ) pvPortMalloc( sizeof( xEVENT_GROUP ) );
+	if( pxEventGroup != NULL )
+	{
+		prvInitialiseNewEventGroup( pxEventGroup, pdFALSE );
+	}
+
+	return ( xEventGroupHandle ) pxEventGroup;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	xEventGroupHandle xEventGroupCreateStatic( xStaticEventGroup *pxStaticEventGroup )
+	{
+	xEVENT_GROUP *pxEventGroup = ( xEVENT_GROUP * ) pxStaticEventGroup;
+
+		if( pxEventGroup != NULL )
+		{
+			prvInitialiseNewEventGroup( pxEventGroup, pdTRUE );
+		}
+
+		return ( xEventGroupHandle ) pxEventGroup;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+xEventBits xEventGroupWaitBits( xEventGroupHandle xEventGroup, const xEventBits uxBitsToWaitFor, const portBASE_TYPE xClearOnExit, const portBASE_TYPE xWaitForAllBits, portTickType xTicksToWait )
+{
+xEVENT_GROUP * const pxEventGroup = ( xEVENT_GROUP * ) xEventGroup;
+xEventBits uxReturn, uxControlBits = 0;
+portBASE_TYPE xAlreadyYielded;
+
+	vTaskSuspendAll();
+	{
+		uxReturn = pxEventGroup->uxEventBits;
+
+		if( prvTestWaitCondition( uxReturn, uxBitsToWaitFor, xWaitForAllBits ) != pdFALSE )
+		{
+			/* Already met, no need to block. */
+			if( xClearOnExit != pdFALSE )
+			{
+				pxEventGroup->uxEventBits &= ~uxBitsToWaitFor;
+			}
+			xTicksToWait = ( portTickType ) 0;
+		}
+		else if( xTicksToWait != ( portTickType ) 0 )
+		{
+			if( xClearOnExit != pdFALSE )
+			{
+				uxControlBits |= egCLEAR_EVENTS_ON_EXIT_BIT;
+			}
+
+			if( xWaitForAllBits != pdFALSE )
+			{
+				uxControlBits |= egWAIT_FOR_ALL_BITS;
+			}
+
+			/* Setting the bits wakes the task and stores them in its event
+			list item. */
+			vTaskPlaceOnUnorderedEventList( &( pxEventGroup->xTasksWaitingForBits ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
+		}
+	}
+	xAlreadyYielded = xTaskResumeAll();
+
+	if( xTicksToWait != ( portTickType ) 0 )
+	{
+		if( xAlreadyYielded == pdFALSE )
+		{
+			portYIELD_WITHIN_API();
+		}
+
+		uxReturn = uxTaskResetEventItemValue();
+
+		if( ( uxReturn & egUNBLOCKED_DUE_TO_BIT_SET ) == ( xEventBits ) 0 )
+		{
+			/* Timed out.  The bits may have been set between the timeout and
+			now, return them as they are. */
+			taskENTER_CRITICAL();
+			{
+				uxReturn = pxEventGroup->uxEventBits;
+
+				if( prvTestWaitCondition( uxReturn, uxBitsToWaitFor, xWaitForAllBits ) != pdFALSE )
+				{
+					if( xClearOnExit != pdFALSE )
+					{
+						pxEventGroup->uxEventBits &= ~uxBitsToWaitFor;
+					}
+				}
+			}
+			taskEXIT_CRITICAL();
+		}
+
+		uxReturn &= ~egEVENT_BITS_CONTROL_BYTES;
+	}
+
+	return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+xEventBits xEventGroupSync( xEventGroupHandle xEventGroup, const xEventBits uxBitsToSet, const xEventBits uxBitsToWaitFor, portTickType xTicksToWait )
+{
+xEVENT_GROUP * const pxEventGroup = ( xEVENT_GROUP * ) xEventGroup;
+xEventBits uxOriginalBitValue, uxReturn;
+portBASE_TYPE xAlreadyYielded;
+
+	vTaskSuspendAll();
+	{
+		uxOriginalBitValue = pxEventGroup->uxEventBits;
+
+		( void ) xEventGroupSetBits( xEventGroup, uxBitsToSet );
+
+		if( ( ( uxOriginalBitValue | uxBitsToSet ) & uxBitsToWaitFor ) == uxBitsToWaitFor )
+		{
+			/* This task was the last one to reach the rendezvous. */
+			uxReturn = ( uxOriginalBitValue | uxBitsToSet );
+
+			/* The other tasks cleared the bits on exit, clear the bits of
+			this one. */
+			pxEventGroup->uxEventBits &= ~uxBitsToWaitFor;
+
+			xTicksToWait = ( portTickType ) 0;
+		}
+		else
+		{
+			if( xTicksToWait != ( portTickType ) 0 )
+			{
+				vTaskPlaceOnUnorderedEventList( &( pxEventGroup->xTasksWaitingForBits ), ( uxBitsToWaitFor | egCLEAR_EVENTS_ON_EXIT_BIT | egWAIT_FOR_ALL_BITS ), xTicksToWait );
+
+				/* Not used, set by the task that completes the rendezvous. */
+				uxReturn = 0;
+			}
+			else
+			{
+				uxReturn = pxEventGroup->uxEventBits;
+			}
+		}
+	}
+	xAlreadyYielded = xTaskResumeAll();
+
+	if( xTicksToWait != ( portTickType ) 0 )
+	{
+		if( xAlreadyYielded == pdFALSE )
+		{
+			portYIELD_WITHIN_API();
+		}
+
+		uxReturn = uxTaskResetEventItemValue();
+
+		if( ( uxReturn & egUNBLOCKED_DUE_TO_BIT_SET ) == ( xEventBits ) 0 )
+		{
+			/* Timed out, the rendezvous may have completed in between. */
+			taskENTER_CRITICAL();
+			{
+				uxReturn = pxEventGroup->uxEventBits;
+
+				if( ( uxReturn & uxBitsToWaitFor ) == uxBitsToWaitFor )
+				{
+					pxEventGroup->uxEventBits &= ~uxBitsToWaitFor;
+				}
+			}
+			taskEXIT_CRITICAL();
+		}
+
+		uxReturn &= ~egEVENT_BITS_CONTROL_BYTES;
+	}
+
+	return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+xEventBits xEventGroupSetBits( xEventGroupHandle xEventGroup, const xEventBits uxBitsToSet )
+{
+xEVENT_GROUP * const pxEventGroup = ( xEVENT_GROUP * ) xEventGroup;
+xList * const pxList = &( pxEventGroup->xTasksWaitingForBits );
+xListItem const *pxListEnd;
+xListItem *pxListItem, *pxNext;
+xEventBits uxBitsWaitedFor, uxControlBits, uxBitsToClear = 0;
+xEventBits uxReturn;
+
+	pxListEnd = ( xListItem const * ) &( pxList->xListEnd );
+
+	vTaskSuspendAll();
+	{
+		pxListItem = ( xListItem * ) pxList->xListEnd.pxNext;
+
+		pxEventGroup->uxEventBits |= uxBitsToSet;
+
+		/* Wake every task whose condition is now met.  The bits the woken
+		tasks asked to clear are only cleared at the end so all the waiting
+		tasks see the same bits. */
+		while( pxListItem != pxListEnd )
+		{
+			pxNext = ( xListItem * ) pxListItem->pxNext;
+			uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
+			uxControlBits = uxBitsWaitedFor & egEVENT_BITS_CONTROL_BYTES;
+			uxBitsWaitedFor &= ~egEVENT_BITS_CONTROL_BYTES;
+
+			if( prvTestWaitCondition( pxEventGroup->uxEventBits, uxBitsWaitedFor, ( uxControlBits & egWAIT_FOR_ALL_BITS ) ? pdTRUE : pdFALSE ) != pdFALSE )
+			{
+				if( ( uxControlBits & egCLEAR_EVENTS_ON_EXIT_BIT ) != ( xEventBits ) 0 )
+				{
+					uxBitsToClear |= uxBitsWaitedFor;
+				}
+
+				/* The woken task reads the bits from its event list item. */
+				( void ) xTaskRemoveFromUnorderedEventList( pxListItem, pxEventGroup->uxEventBits | egUNBLOCKED_DUE_TO_BIT_SET );
+			}
+
+			pxListItem = pxNext;
+		}
+
+		pxEventGroup->uxEventBits &= ~uxBitsToClear;
+		uxReturn = pxEventGroup->uxEventBits;
+	}
+	( void ) xTaskResumeAll();
+
+	return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+xEventBits xEventGroupClearBits( xEventGroupHandle xEventGroup, const xEventBits uxBitsToClear )
+{
+xEVENT_GROUP * const pxEventGroup = ( xEVENT_GROUP * ) xEventGroup;
+xEventBits uxReturn;
+
+	/* Clearing bits wakes nobody, a critical section is enough. */
+	taskENTER_CRITICAL();
+	{
+		uxReturn = pxEventGroup->uxEventBits;
+		pxEventGroup->uxEventBits &= ~uxBitsToClear;
+	}
+	taskEXIT_CRITICAL();
+
+	return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+xEventBits xEventGroupGetBitsFromISR( xEventGroupHandle xEventGroup )
+{
+xEVENT_GROUP * const pxEventGroup = ( xEVENT_GROUP * ) xEventGroup;
+
+	/* A single word read. */
+	return pxEventGroup->uxEventBits;
+}
+/*-----------------------------------------------------------*/
+
+void vEventGroupDelete( xEventGroupHandle xEventGroup )
+{
+xEVENT_GROUP * const pxEventGroup = ( xEVENT_GROUP * ) xEventGroup;
+xList * const pxList = &( pxEventGroup->xTasksWaitingForBits );
+
+	vTaskSuspendAll();
+	{
+		/* The waiting tasks return 0. */
+		while( listCURRENT_LIST_LENGTH( pxList ) > ( unsigned portBASE_TYPE ) 0 )
+		{
+			( void ) xTaskRemoveFromUnorderedEventList( ( xListItem * ) pxList->xListEnd.pxNext, egUNBLOCKED_DUE_TO_BIT_SET );
+		}
+
+		if( pxEventGroup->ucStaticallyAllocated == ( unsigned char ) pdFALSE )
+		{
+			vPortFree( pxEventGroup );
+		}
+		else
+		{
+			/* The memory belongs to the application, just make the
+			structure unusable. */
+			memset( pxEventGroup, 0x00, sizeof( xEVENT_GROUP ) );
+		}
+	}
+	( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_xEventGroupSetBitsFromISR == 1 )
+
+	portBASE_TYPE xEventGroupSetBitsFromISR( xEventGroupHandle xEventGroup, const xEventBits uxBitsToSet, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+	{
+	xEVENT_GROUP_REQUEST xRequest;
+
+		xRequest.pxEventGroup = ( xEVENT_GROUP * ) xEventGroup;
+		xRequest.uxBits = uxBitsToSet;
+		xRequest.xSet = pdTRUE;
+
+		return xQueueSendFromISR( xEventGroupRequests, &xRequest, pxHigherPriorityTaskWoken );
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_xEventGroupSetBitsFromISR == 1 )
+
+	portBASE_TYPE xEventGroupClearBitsFromISR( xEventGroupHandle xEventGroup, const xEventBits uxBitsToClear )
+	{
+	xEVENT_GROUP_REQUEST xRequest;
+	signed portBASE_TYPE xWoken = pdFALSE;
+
+		xRequest.pxEventGroup = ( xEVENT_GROUP * ) xEventGroup;
+		xRequest.uxBits = uxBitsToClear;
+		xRequest.xSet = pdFALSE;
+
+		/* Clearing wakes nobody, the daemon can wait for the next switch. */
+		return xQueueSendFromISR( xEventGroupRequests, &xRequest, &xWoken );
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_xEventGroupSetBitsFromISR == 1 )
+
+	portBASE_TYPE xEventGroupCreateDaemon( void )
+	{
+	portBASE_TYPE xReturn;
+
+		#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		{
+			xEventGroupRequests = xQueueCreateStatic( configEVENT_GROUP_QUEUE_LENGTH, sizeof( xEVENT_GROUP_REQUEST ), ( unsigned char * ) xEventGroupQueueStorage, &xEventGroupQueue );
+			xReturn = xTaskCreateStatic( prvEventGroupDaemon, ( signed char * ) "EVTD", configEVENT_GROUP_DAEMON_STACK_DEPTH, NULL, configEVENT_GROUP_DAEMON_PRIORITY, NULL, xEventGroupDaemonStack, &xEventGroupDaemonTCB );
+		}
+		#else
+		{
+			xEventGroupRequests = xQueueCreate( configEVENT_GROUP_QUEUE_LENGTH, sizeof( xEVENT_GROUP_REQUEST ) );
+			if( xEventGroupRequests == NULL )
+			{
+				return errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+			}
+			xReturn = xTaskCreate( prvEventGroupDaemon, ( signed char * ) "EVTD", configEVENT_GROUP_DAEMON_STACK_DEPTH, NULL, configEVENT_GROUP_DAEMON_PRIORITY, NULL );
+		}
+		#endif
+
+		return xReturn;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_xEventGroupSetBitsFromISR == 1 )
+
+	static void prvEventGroupDaemon( void *pvParameters )
+	{
+	xEVENT_GROUP_REQUEST xRequest;
+
+		( void ) pvParameters;
+
+		for( ;; )
+		{
+			if( xQueueReceive( xEventGroupRequests, &xRequest, portMAX_DELAY ) == pdPASS )
+			{
+				if( xRequest.xSet != pdFALSE )
+				{
+					( void ) xEventGroupSetBits( ( xEventGroupHandle ) xRequest.pxEventGroup, xRequest.uxBits );
+				}
+				else
+				{
+					( void ) xEventGroupClearBits( ( xEventGroupHandle ) xRequest.pxEventGroup, xRequest.uxBits );
+				}
+			}
+		}
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvTestWaitCondition( const xEventBits uxCurrentEventBits, const xEventBits uxBitsToWaitFor, const portBASE_TYPE xWaitForAllBits )
+{
+portBASE_TYPE xReturn;
+
+	if( xWaitForAllBits == pdFALSE )
+	{
+		xReturn = ( ( uxCurrentEventBits & uxBitsToWaitFor ) != ( xEventBits ) 0 ) ? pdTRUE : pdFALSE;
+	}
+	else
+	{
+		xReturn = ( ( uxCurrentEventBits & uxBitsToWaitFor ) == uxBitsToWaitFor ) ? pdTRUE : pdFALSE;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewEventGroup( xEVENT_GROUP * const pxEventGroup, unsigned char ucStaticallyAllocated )
+{
+	pxEventGroup->uxEventBits = 0;
+	vListInitialise( &( pxEventGroup->xTasksWaitingForBits ) );
+	pxEventGroup->ucStaticallyAllocated = ucStaticallyAllocated;
+}
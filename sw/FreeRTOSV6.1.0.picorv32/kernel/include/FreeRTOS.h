@@ -152,6 +152,50 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 	#define configUSE_COUNTING_SEMAPHORES 0
 #endif
 
+#ifndef configUSE_PORT_OPTIMISED_TASK_SELECTION
+	#define configUSE_PORT_OPTIMISED_TASK_SELECTION 0
+#endif
+
+#ifndef configUSE_TASK_NOTIFICATIONS
+	#define configUSE_TASK_NOTIFICATIONS 0
+#endif
+
+#ifndef configSUPPORT_STATIC_ALLOCATION
+	#define configSUPPORT_STATIC_ALLOCATION 0
+#endif
+
+#ifndef configUSE_TICKLESS_IDLE
+	#define configUSE_TICKLESS_IDLE 0
+#endif
+
+#ifndef configEXPECTED_IDLE_TIME_BEFORE_SLEEP
+	#define configEXPECTED_IDLE_TIME_BEFORE_SLEEP 2
+#endif
+
+#if ( configEXPECTED_IDLE_TIME_BEFORE_SLEEP < 2 )
+	#error configEXPECTED_IDLE_TIME_BEFORE_SLEEP must not be less than 2
+#endif
+
+#if ( ( configUSE_TICKLESS_IDLE == 1 ) && !defined( portSUPPRESS_TICKS_AND_SLEEP ) )
+	#error configUSE_TICKLESS_IDLE is set but the port does not define portSUPPRESS_TICKS_AND_SLEEP()
+#endif
+
+#ifndef configUSE_DELAY_WHEEL
+	#define configUSE_DELAY_WHEEL 0
+#endif
+
+#ifndef configDELAY_WHEEL_BITS
+	#define configDELAY_WHEEL_BITS 6
+#endif
+
+#ifndef configUSE_QUEUE_SETS
+	#define configUSE_QUEUE_SETS 0
+#endif
+
+#ifndef configASSERT
+	#define configASSERT( x )
+#endif
+
 #ifndef configUSE_ALTERNATIVE_API
 	#define configUSE_ALTERNATIVE_API 0
 #endif
@@ -181,6 +225,30 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 	#define INCLUDE_xTaskGetSchedulerState 0
 #endif
 
+#ifndef INCLUDE_pcTaskGetTaskName
+	#define INCLUDE_pcTaskGetTaskName 0
+#endif
+
+#ifndef INCLUDE_xEventGroupSetBitsFromISR
+	#define INCLUDE_xEventGroupSetBitsFromISR 0
+#endif
+
+#if ( INCLUDE_xEventGroupSetBitsFromISR == 1 )
+
+	#ifndef configEVENT_GROUP_DAEMON_PRIORITY
+		#define configEVENT_GROUP_DAEMON_PRIORITY ( configMAX_PRIORITIES - 1 )
+	#endif
+
+	#ifndef configEVENT_GROUP_DAEMON_STACK_DEPTH
+		#define configEVENT_GROUP_DAEMON_STACK_DEPTH configMINIMAL_STACK_SIZE
+	#endif
+
+	#ifndef configEVENT_GROUP_QUEUE_LENGTH
+		#define configEVENT_GROUP_QUEUE_LENGTH 8
+	#endif
+
+#endif
+
 #if ( configUSE_MUTEXES == 1 )
 	/* xTaskGetCurrentTaskHandle is used by the priority inheritance mechanism
 	within the mutex implementation so must be available if mutexes are used. */
@@ -376,6 +444,12 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 	#define traceTASK_INCREMENT_TICK( xTickCount )
 #endif
 
+#ifndef traceMOVED_TASK_TO_READY_STATE
+	/* Called when a task is added to a ready list.  pxTCB is not necessarily
+	the running task. */
+	#define traceMOVED_TASK_TO_READY_STATE( pxTCB )
+#endif
+
 #ifndef configGENERATE_RUN_TIME_STATS
 	#define configGENERATE_RUN_TIME_STATS 0
 #endif
@@ -396,6 +470,42 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 	#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
 #endif
 
+#ifndef configGENERATE_CYCLE_STATS
+	#define configGENERATE_CYCLE_STATS 0
+#endif
+
+#if ( configGENERATE_CYCLE_STATS == 1 )
+
+	#ifndef portGET_TASK_CYCLES
+		#error If configGENERATE_CYCLE_STATS is defined then portGET_TASK_CYCLES must also be defined.  portGET_TASK_CYCLES should evaluate to the number of cycles the running task has used since the last time it was called.
+	#endif /* portGET_TASK_CYCLES */
+
+#endif /* configGENERATE_CYCLE_STATS */
+
+#ifndef configGENERATE_STACK_STATS
+	#define configGENERATE_STACK_STATS 0
+#endif
+
+#if ( ( configGENERATE_STACK_STATS == 1 ) && ( INCLUDE_uxTaskGetStackHighWaterMark != 1 ) )
+	#error configGENERATE_STACK_STATS needs INCLUDE_uxTaskGetStackHighWaterMark to measure the free stack.
+#endif
+
+#ifndef configGENERATE_LOCK_STATS
+	#define configGENERATE_LOCK_STATS 0
+#endif
+
+#if ( configGENERATE_LOCK_STATS == 1 )
+
+	#if ( configUSE_MUTEXES != 1 )
+		#error configGENERATE_LOCK_STATS needs configUSE_MUTEXES, the stats are kept for mutexes only.
+	#endif
+
+	#ifndef portGET_LOCK_CYCLES
+		#error If configGENERATE_LOCK_STATS is defined then portGET_LOCK_CYCLES must also be defined.  portGET_LOCK_CYCLES should evaluate to a free running 64-bit cycle count.
+	#endif /* portGET_LOCK_CYCLES */
+
+#endif /* configGENERATE_LOCK_STATS */
+
 #ifndef configUSE_MALLOC_FAILED_HOOK
 	#define configUSE_MALLOC_FAILED_HOOK 0
 #endif
@@ -416,5 +526,48 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 	#define vPortFreeAligned( pvBlockToFree ) vPortFree( pvBlockToFree )
 #endif
 
+#include "list.h"
+
+/*
+ * Storage for a queue, semaphore or mutex created with xQueueCreateStatic()
+ * and friends.  The structure has the same size and alignment as the queue
+ * structure private to queue.c but its members must not be accessed by the
+ * application.  queue.c will fail to compile if the two definitions get out
+ * of step.
+ */
+typedef struct xSTATIC_QUEUE
+{
+	void *pvDummy1[ 4 ];
+	xList xDummy2[ 2 ];
+	unsigned portBASE_TYPE uxDummy3[ 3 ];
+	signed portBASE_TYPE xDummy4[ 2 ];
+	#if ( configUSE_QUEUE_SETS == 1 )
+		void *pvDummy6;
+		unsigned portBASE_TYPE uxDummy10;
+	#endif
+	#if ( configGENERATE_LOCK_STATS == 1 )
+		unsigned long long ullDummy7;
+		unsigned long ulDummy8[ 4 ];
+		void *pvDummy9;
+	#endif
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		unsigned char ucDummy5;
+	#endif
+} xStaticQueue;
+
+/*
+ * Used by uxQueueGetLockStats() to report the contention of a mutex.  The
+ * times are in cycles, saturated at 0xffffffff.
+ */
+typedef struct xQUEUE_LOCK_STATS
+{
+	void *xHandle;
+	const signed char *pcName;		/* The name in the queue registry, NULL if the mutex is not in it. */
+	unsigned long ulTakes;			/* Times the mutex was taken. */
+	unsigned long ulContended;		/* Takes that found the mutex held and waited for it. */
+	unsigned long ulMaxHold;		/* Longest time the mutex was held. */
+	unsigned long ulMaxWait;		/* Longest wait of a contended take. */
+} xQueueLockStats;
+
 #endif /* INC_FREERTOS_H */
 
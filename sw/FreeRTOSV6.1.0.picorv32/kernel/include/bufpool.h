@@ -0,0 +1,222 @@
+/*
+    FreeRTOS V6.1.0 - Copyright (C) 2010 Real Time Engineers Ltd.
+
+    ***************************************************************************
+    *                                                                         *
+    * If you are:                                                             *
+    *                                                                         *
+    *    + New to FreeRTOS,                                                   *
+    *    + Wanting to learn FreeRTOS or multitasking in general quickly       *
+    *    + Looking for basic training,                                        *
+    *    + Wanting to improve your FreeRTOS skills and productivity           *
+    *                                                                         *
+    * then take a look at the FreeRTOS books - available as PDF or paperback  *
+    *                                                                         *
+    *        "Using the FreeRTOS Real Time Kernel - a Practical Guide"        *
+    *                  http://www.FreeRTOS.org/Documentation                  *
+    *                                                                         *
+    * A pdf reference manual is also available.  Both are usually delivered   *
+    * to your inbox within 20 minutes to two hours when purchased between 8am *
+    * and 8pm GMT (although please allow up to 24 hours in case of            *
+    * exceptional circumstances).  Thank you for your support!                *
+    *                                                                         *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    ***NOTE*** The exception to the GPL is included to allow you to distribute
+    a combined work that includes FreeRTOS without being obliged to provide the
+    source code for proprietary components outside of the FreeRTOS kernel.
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public 
+    License and the FreeRTOS license exception along with FreeRTOS; if not it 
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained 
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+#ifndef INC_FREERTOS_H
+	#error "#include FreeRTOS.h" must appear in source files before "#include bufpool.h"
+#endif
+
+#ifndef BUFPOOL_H
+#define BUFPOOL_H
+
+#include "queue.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * bufpool. h
+ *
+ * Type by which buffer pools are referenced.  For example, a call to
+ * xBufferPoolCreate() returns an xBufferPoolHandle variable that can then be
+ * used as a parameter to pvBufferPoolAlloc(), xBufferPoolFree(), etc.
+ *
+ * \page xBufferPoolHandle xBufferPoolHandle
+ * \ingroup BufferPools
+ */
+typedef void * xBufferPoolHandle;
+
+/**
+ * bufpool. h
+ * <pre>
+ xBufferPoolHandle xBufferPoolCreate(
+							  unsigned portBASE_TYPE uxBlockCount,
+							  size_t xBlockSize
+						  );
+ * </pre>
+ *
+ * Creates a pool of uxBlockCount blocks of xBlockSize bytes each.  The
+ * blocks are allocated from the heap once, when the pool is created, and
+ * are aligned to portBYTE_ALIGNMENT.
+ *
+ * Allocating and freeing a block only moves a pointer in or out of a queue
+ * of free blocks, so it takes the same time whatever the block size is and
+ * a task can block waiting for a free block.  Together with the zero copy
+ * queues (see xQueueSendBuffer()) a block can be passed from task to task
+ * without its contents being copied.
+ *
+ * @param uxBlockCount The number of blocks in the pool.
+ *
+ * @param xBlockSize The size of each block in bytes.
+ *
+ * @return A handle to the pool, or NULL if the memory could not be allocated.
+ *
+ * Example usage:
+   <pre>
+ xBufferPoolHandle xPool;
+ xQueueHandle xQueue;
+
+ void vProducerTask( void *pvParameters )
+ {
+ void *pvPacket;
+
+	xPool = xBufferPoolCreate( 8, 1024 );
+	xQueue = xQueueCreateZeroCopy( 8 );
+
+	for( ;; )
+	{
+		// Wait for a free block, fill it and pass it to the consumer.
+		pvPacket = pvBufferPoolAlloc( xPool, portMAX_DELAY );
+		vFillPacket( pvPacket );
+		xQueueSendBuffer( xQueue, pvPacket, 1024, portMAX_DELAY );
+	}
+ }
+
+ void vConsumerTask( void *pvParameters )
+ {
+ void *pvPacket;
+ size_t xLength;
+
+	for( ;; )
+	{
+		if( xQueueReceiveBuffer( xQueue, &pvPacket, &xLength, portMAX_DELAY ) == pdPASS )
+		{
+			// The consumer now owns the block and returns it to the pool.
+			vProcessPacket( pvPacket, xLength );
+			xBufferPoolFree( xPool, pvPacket );
+		}
+	}
+ }
+ </pre>
+ * \defgroup xBufferPoolCreate xBufferPoolCreate
+ * \ingroup BufferPools
+ */
+xBufferPoolHandle xBufferPoolCreate( unsigned portBASE_TYPE uxBlockCount, size_t xBlockSize );
+
+/**
+ * bufpool. h
+ * <pre>void *pvBufferPoolAlloc( xBufferPoolHandle xPool, portTickType xTicksToWait );</pre>
+ *
+ * Take a block from the pool.  The caller owns the block until it is freed
+ * or passed to another task through a zero copy queue.
+ *
+ * @param xPool The pool to take the block from.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for a block to be freed if the pool is empty.
+ *
+ * @return A pointer to the block, or NULL if no block became free within
+ * xTicksToWait.
+ *
+ * \defgroup pvBufferPoolAlloc pvBufferPoolAlloc
+ * \ingroup BufferPools
+ */
+void *pvBufferPoolAlloc( xBufferPoolHandle xPool, portTickType xTicksToWait );
+
+/**
+ * bufpool. h
+ * <pre>void *pvBufferPoolAllocFromISR( xBufferPoolHandle xPool, signed portBASE_TYPE *pxHigherPriorityTaskWoken );</pre>
+ *
+ * A version of pvBufferPoolAlloc() that can be called from an ISR.  It does
+ * not block.
+ *
+ * \defgroup pvBufferPoolAllocFromISR pvBufferPoolAllocFromISR
+ * \ingroup BufferPools
+ */
+void *pvBufferPoolAllocFromISR( xBufferPoolHandle xPool, signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+
+/**
+ * bufpool. h
+ * <pre>signed portBASE_TYPE xBufferPoolFree( xBufferPoolHandle xPool, void *pvBlock );</pre>
+ *
+ * Return a block to the pool, waking a task blocked in pvBufferPoolAlloc()
+ * if there is one.  The caller must not access the block afterwards.
+ *
+ * @param xPool The pool the block was taken from.
+ *
+ * @param pvBlock The block, as returned by pvBufferPoolAlloc().
+ *
+ * @return pdPASS if the block was returned.  pdFAIL if pvBlock does not
+ * point to the start of a block of the pool or if the pool is already full,
+ * i.e. the block has been freed twice.
+ *
+ * \defgroup xBufferPoolFree xBufferPoolFree
+ * \ingroup BufferPools
+ */
+signed portBASE_TYPE xBufferPoolFree( xBufferPoolHandle xPool, void *pvBlock );
+
+/**
+ * bufpool. h
+ * <pre>signed portBASE_TYPE xBufferPoolFreeFromISR( xBufferPoolHandle xPool, void *pvBlock, signed portBASE_TYPE *pxHigherPriorityTaskWoken );</pre>
+ *
+ * A version of xBufferPoolFree() that can be called from an ISR.
+ *
+ * \defgroup xBufferPoolFreeFromISR xBufferPoolFreeFromISR
+ * \ingroup BufferPools
+ */
+signed portBASE_TYPE xBufferPoolFreeFromISR( xBufferPoolHandle xPool, void *pvBlock, signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+
+/*
+ * Return the size of the blocks of the pool, as rounded up to
+ * portBYTE_ALIGNMENT, and the number of blocks currently free.
+ */
+size_t xBufferPoolGetBlockSize( xBufferPoolHandle xPool );
+unsigned portBASE_TYPE uxBufferPoolFreeBlocks( xBufferPoolHandle xPool );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BUFPOOL_H */
+
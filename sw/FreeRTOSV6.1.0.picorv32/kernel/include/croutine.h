@@ -159,6 +159,32 @@ typedef struct corCoRoutineControlBlock
  */
 signed portBASE_TYPE xCoRoutineCreate( crCOROUTINE_CODE pxCoRoutineCode, unsigned portBASE_TYPE uxPriority, unsigned portBASE_TYPE uxIndex );
 
+/**
+ * croutine. h
+ *<pre>
+ portBASE_TYPE xCoRoutineCreateStatic(
+                                 crCOROUTINE_CODE pxCoRoutineCode,
+                                 unsigned portBASE_TYPE uxPriority,
+                                 unsigned portBASE_TYPE uxIndex,
+                                 corCRCB *pxCoRoutineBuffer
+                               );</pre>
+ *
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * this function to be available.
+ *
+ * As xCoRoutineCreate() but the control block is provided by the caller, a
+ * co-routine then uses no heap at all.  A co-routine has no stack of its
+ * own, it runs on the stack of the task that calls vCoRoutineSchedule().
+ *
+ * @return pdPASS, or pdFAIL if pxCoRoutineBuffer is NULL.
+ *
+ * \defgroup xCoRoutineCreateStatic xCoRoutineCreateStatic
+ * \ingroup Tasks
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	signed portBASE_TYPE xCoRoutineCreateStatic( crCOROUTINE_CODE pxCoRoutineCode, unsigned portBASE_TYPE uxPriority, unsigned portBASE_TYPE uxIndex, corCRCB *pxCoRoutineBuffer );
+#endif
+
 
 /**
  * croutine. h
@@ -174,7 +200,16 @@ signed portBASE_TYPE xCoRoutineCreate( crCOROUTINE_CODE pxCoRoutineCode, unsigne
  *
  * If an application comprises of both tasks and co-routines then
  * vCoRoutineSchedule should be called from the idle task (in an idle task
- * hook).
+ * hook).  It returns at once if no co-routine was created.
+ *
+ * Co-routines should be created before the scheduler is started, or by other
+ * co-routines: creating one from a task races with the idle task walking
+ * the co-routine ready lists.
+ *
+ * A queue is used either by tasks or by co-routines, as a blocked co-routine
+ * and a blocked task sit in the same event lists.  A task sends to a
+ * co-routine queue with crQUEUE_SEND_FROM_ISR() inside taskENTER_CRITICAL(),
+ * a co-routine sends to a task queue with xQueueSend() and a block time of 0.
  *
  * Example usage:
    <pre>
@@ -742,6 +777,17 @@ void vCoRoutineAddToDelayedList( portTickType xTicksToDelay, xList *pxEventList
  */
 signed portBASE_TYPE xCoRoutineRemoveFromEventList( const xList *pxEventList );
 
+/*
+ * This function is intended for internal use by the tickless idle only.
+ * The function should not be used by application writers.
+ *
+ * Returns the number of ticks until the first delayed co-routine is due, 0
+ * if a co-routine is ready or due now, portMAX_DELAY if none is delayed.
+ * The co-routines run from the idle hook, so the idle task must not sleep
+ * past that time.
+ */
+portTickType xCoRoutineGetExpectedIdleTime( void );
+
 #ifdef __cplusplus
 }
 #endif
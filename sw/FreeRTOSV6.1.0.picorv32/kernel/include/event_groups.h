@@ -0,0 +1,360 @@
+/*
+    FreeRTOS V6.1.0 - Copyright (C) 2010 Real Time Engineers Ltd.
+
+    ***************************************************************************
+    *                                                                         *
+    * If you are:                                                             *
+    *                                                                         *
+    *    + New to FreeRTOS,                                                   *
+    *    + Wanting to learn FreeRTOS or multitasking in general quickly       *
+    *    + Looking for basic training,                                        *
+    *    + Wanting to improve your FreeRTOS skills and productivity           *
+    *                                                                         *
+    * then take a look at the FreeRTOS books - available as PDF or paperback  *
+    *                                                                         *
+    *        "Using the FreeRTOS Real Time Kernel - a Practical Guide"        *
+    *                  http://www.FreeRTOS.org/Documentation                  *
+    *                                                                         *
+    * A pdf reference manual is also available.  Both are usually delivered   *
+    * to your inbox within 20 minutes to two hours when purchased between 8am *
+    * and 8pm GMT (although please allow up to 24 hours in case of            *
+    * exceptional circumstances).  Thank you for your support!                *
+    *                                                                         *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    ***NOTE*** The exception to the GPL is included to allow you to distribute
+    a combined work that includes FreeRTOS without being obliged to provide the
+    source code for proprietary components outside of the FreeRTOS kernel.
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public 
+    License and the FreeRTOS license exception along with FreeRTOS; if not it 
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained 
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+
+#ifndef INC_FREERTOS_H
+	#error "#include FreeRTOS.h" must appear in source files before "#include event_groups.h"
+#endif
+
+#ifndef EVENT_GROUPS_H
+#define EVENT_GROUPS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * event_groups. h
+ *
+ * Type by which event groups are referenced.  For example, a call to
+ * xEventGroupCreate() returns an xEventGroupHandle variable that can then be
+ * used as a parameter to xEventGroupWaitBits(), xEventGroupSetBits(), etc.
+ *
+ * An event group is a set of event bits.  A task can block until one or all
+ * of several bits are set, so a single call waits on several conditions that
+ * would otherwise need one queue or semaphore each.  The number of bits is 8
+ * with configUSE_16_BIT_TICKS set to 1 and 24 otherwise, the top byte of an
+ * xEventBits value is used by the kernel.
+ *
+ * The waiting tasks are kept in an unordered event list that is walked with
+ * the scheduler suspended, never with interrupts disabled.  Interrupts
+ * therefore cannot set bits directly: xEventGroupSetBitsFromISR() passes the
+ * request to the event group daemon task through a queue.
+ *
+ * \page xEventGroupHandle xEventGroupHandle
+ * \ingroup EventGroups
+ */
+typedef void * xEventGroupHandle;
+
+/*
+ * The type that holds event bits.
+ */
+typedef portTickType xEventBits;
+
+/*
+ * Storage for an event group created with xEventGroupCreateStatic().  The
+ * structure has the same size as the one private to event_groups.c, its
+ * members must not be accessed by the application.
+ */
+typedef struct xSTATIC_EVENT_GROUP
+{
+	portTickType xDummy1;
+	xList xDummy2;
+	unsigned char ucDummy3;
+} xStaticEventGroup;
+
+/**
+ * event_groups. h
+ *<pre>
+ xEventGroupHandle xEventGroupCreate( void );
+ </pre>
+ *
+ * Create a new event group with all the bits cleared.
+ *
+ * @return A handle to the created event group, or NULL if there was not
+ * enough heap memory.
+ *
+ * \defgroup xEventGroupCreate xEventGroupCreate
+ * \ingroup EventGroups
+ */
+xEventGroupHandle xEventGroupCreate( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * event_groups. h
+ *<pre>
+ xEventGroupHandle xEventGroupCreateStatic( xStaticEventGroup *pxStaticEventGroup );
+ </pre>
+ *
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * this function to be available.
+ *
+ * As xEventGroupCreate() but uses the memory provided by the caller.
+ *
+ * \defgroup xEventGroupCreateStatic xEventGroupCreateStatic
+ * \ingroup EventGroups
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	xEventGroupHandle xEventGroupCreateStatic( xStaticEventGroup *pxStaticEventGroup ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * event_groups. h
+ *<pre>
+ xEventBits xEventGroupWaitBits( xEventGroupHandle xEventGroup,
+								 const xEventBits uxBitsToWaitFor,
+								 const portBASE_TYPE xClearOnExit,
+								 const portBASE_TYPE xWaitForAllBits,
+								 portTickType xTicksToWait );
+ </pre>
+ *
+ * Block until one (xWaitForAllBits == pdFALSE) or all (xWaitForAllBits ==
+ * pdTRUE) of uxBitsToWaitFor are set in the event group, or xTicksToWait
+ * ticks have passed.  Must not be called from an interrupt.
+ *
+ * @param uxBitsToWaitFor The bits to wait for, must not be 0.
+ *
+ * @param xClearOnExit If pdTRUE, the bits waited for are cleared when the
+ * condition is met, as part of the same operation.  Nothing is cleared on a
+ * timeout.
+ *
+ * @param xTicksToWait The maximum number of ticks to block, 0 to only test
+ * the bits, portMAX_DELAY to block without timeout if INCLUDE_vTaskSuspend
+ * is 1.
+ *
+ * @return The event bits when the condition was met, before they were
+ * cleared, or the event bits when the block time expired.  Test the return
+ * value to know which.
+ *
+ * Example usage:
+   <pre>
+ #define UART_RX_DONE	( 1UL << 0 )
+ #define DMA_DONE		( 1UL << 1 )
+
+ void vADriverTask( void *pvParameters )
+ {
+ xEventBits uxBits;
+
+	for( ;; )
+	{
+		// Wait for either event, clearing the bits that are handled.
+		uxBits = xEventGroupWaitBits( xDriverEvents, UART_RX_DONE | DMA_DONE, pdTRUE, pdFALSE, portMAX_DELAY );
+
+		if( uxBits & UART_RX_DONE )
+		{
+			// ...
+		}
+		if( uxBits & DMA_DONE )
+		{
+			// ...
+		}
+	}
+ }
+   </pre>
+ * \defgroup xEventGroupWaitBits xEventGroupWaitBits
+ * \ingroup EventGroups
+ */
+xEventBits xEventGroupWaitBits( xEventGroupHandle xEventGroup, const xEventBits uxBitsToWaitFor, const portBASE_TYPE xClearOnExit, const portBASE_TYPE xWaitForAllBits, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * event_groups. h
+ *<pre>
+ xEventBits xEventGroupSetBits( xEventGroupHandle xEventGroup, const xEventBits uxBitsToSet );
+ </pre>
+ *
+ * Set bits in an event group and unblock the tasks whose condition is now
+ * met.  Must not be called from an interrupt, see
+ * xEventGroupSetBitsFromISR().
+ *
+ * @return The event bits when the call returns.  They may already have been
+ * cleared again by a woken task that asked for it.
+ *
+ * \defgroup xEventGroupSetBits xEventGroupSetBits
+ * \ingroup EventGroups
+ */
+xEventBits xEventGroupSetBits( xEventGroupHandle xEventGroup, const xEventBits uxBitsToSet ) PRIVILEGED_FUNCTION;
+
+/**
+ * event_groups. h
+ *<pre>
+ xEventBits xEventGroupClearBits( xEventGroupHandle xEventGroup, const xEventBits uxBitsToClear );
+ </pre>
+ *
+ * Clear bits in an event group.  Must not be called from an interrupt, see
+ * xEventGroupClearBitsFromISR().
+ *
+ * @return The event bits before they were cleared.
+ *
+ * \defgroup xEventGroupClearBits xEventGroupClearBits
+ * \ingroup EventGroups
+ */
+xEventBits xEventGroupClearBits( xEventGroupHandle xEventGroup, const xEventBits uxBitsToClear ) PRIVILEGED_FUNCTION;
+
+/**
+ * event_groups. h
+ *<pre>
+ xEventBits xEventGroupGetBits( xEventGroupHandle xEventGroup );
+ </pre>
+ *
+ * Returns the current event bits.
+ *
+ * \defgroup xEventGroupGetBits xEventGroupGetBits
+ * \ingroup EventGroups
+ */
+#define xEventGroupGetBits( xEventGroup ) xEventGroupClearBits( ( xEventGroup ), 0 )
+
+/**
+ * event_groups. h
+ *<pre>
+ xEventBits xEventGroupGetBitsFromISR( xEventGroupHandle xEventGroup );
+ </pre>
+ *
+ * A version of xEventGroupGetBits() that can be called from an interrupt.
+ *
+ * \defgroup xEventGroupGetBitsFromISR xEventGroupGetBitsFromISR
+ * \ingroup EventGroups
+ */
+xEventBits xEventGroupGetBitsFromISR( xEventGroupHandle xEventGroup ) PRIVILEGED_FUNCTION;
+
+/**
+ * event_groups. h
+ *<pre>
+ xEventBits xEventGroupSync( xEventGroupHandle xEventGroup,
+							 const xEventBits uxBitsToSet,
+							 const xEventBits uxBitsToWaitFor,
+							 portTickType xTicksToWait );
+ </pre>
+ *
+ * Set uxBitsToSet then wait for all of uxBitsToWaitFor, as one operation:
+ * a rendezvous of several tasks that each set their own bit and wait for
+ * the bits of all of them.  The bits waited for are cleared when the
+ * condition is met.
+ *
+ * @return As xEventGroupWaitBits().
+ *
+ * \defgroup xEventGroupSync xEventGroupSync
+ * \ingroup EventGroups
+ */
+xEventBits xEventGroupSync( xEventGroupHandle xEventGroup, const xEventBits uxBitsToSet, const xEventBits uxBitsToWaitFor, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * event_groups. h
+ *<pre>
+ void vEventGroupDelete( xEventGroupHandle xEventGroup );
+ </pre>
+ *
+ * Delete an event group.  The tasks blocked on it are unblocked and their
+ * wait returns 0.
+ *
+ * \defgroup vEventGroupDelete vEventGroupDelete
+ * \ingroup EventGroups
+ */
+void vEventGroupDelete( xEventGroupHandle xEventGroup ) PRIVILEGED_FUNCTION;
+
+/**
+ * event_groups. h
+ *<pre>
+ portBASE_TYPE xEventGroupSetBitsFromISR( xEventGroupHandle xEventGroup,
+										  const xEventBits uxBitsToSet,
+										  signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+ </pre>
+ *
+ * INCLUDE_xEventGroupSetBitsFromISR must be set to 1 in FreeRTOSConfig.h for
+ * this function to be available.
+ *
+ * Set bits in an event group from an interrupt.  The bits are set by the
+ * event group daemon task, at configEVENT_GROUP_DAEMON_PRIORITY, not by the
+ * interrupt itself: setting bits may wake any number of tasks, which must
+ * not be done with interrupts disabled.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if the daemon task has a
+ * higher priority than the interrupted task, a context switch should then be
+ * requested before the interrupt exits.
+ *
+ * @return pdPASS if the request was queued to the daemon task, pdFAIL if the
+ * queue of configEVENT_GROUP_QUEUE_LENGTH requests was full.
+ *
+ * \defgroup xEventGroupSetBitsFromISR xEventGroupSetBitsFromISR
+ * \ingroup EventGroups
+ */
+#if ( INCLUDE_xEventGroupSetBitsFromISR == 1 )
+	portBASE_TYPE xEventGroupSetBitsFromISR( xEventGroupHandle xEventGroup, const xEventBits uxBitsToSet, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * event_groups. h
+ *<pre>
+ portBASE_TYPE xEventGroupClearBitsFromISR( xEventGroupHandle xEventGroup, const xEventBits uxBitsToClear );
+ </pre>
+ *
+ * INCLUDE_xEventGroupSetBitsFromISR must be set to 1 in FreeRTOSConfig.h for
+ * this function to be available.
+ *
+ * Clear bits in an event group from an interrupt.  The bits are cleared by
+ * the event group daemon task, in order with the requests of
+ * xEventGroupSetBitsFromISR().
+ *
+ * @return pdPASS if the request was queued to the daemon task, pdFAIL if the
+ * queue was full.
+ *
+ * \defgroup xEventGroupClearBitsFromISR xEventGroupClearBitsFromISR
+ * \ingroup EventGroups
+ */
+#if ( INCLUDE_xEventGroupSetBitsFromISR == 1 )
+	portBASE_TYPE xEventGroupClearBitsFromISR( xEventGroupHandle xEventGroup, const xEventBits uxBitsToClear ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS CALLED BY
+ * vTaskStartScheduler() TO CREATE THE EVENT GROUP DAEMON TASK.
+ */
+#if ( INCLUDE_xEventGroupSetBitsFromISR == 1 )
+	portBASE_TYPE xEventGroupCreateDaemon( void ) PRIVILEGED_FUNCTION;
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EVENT_GROUPS_H */
+
@@ -151,6 +151,15 @@ typedef struct xLIST
  */
 #define listGET_LIST_ITEM_VALUE( pxListItem )				( ( pxListItem )->xItemValue )
 
+/*
+ * Access macro to retrieve the owner of a list item, as set by
+ * listSET_LIST_ITEM_OWNER().
+ *
+ * \page listGET_LIST_ITEM_OWNER listGET_LIST_ITEM_OWNER
+ * \ingroup LinkedList
+ */
+#define listGET_LIST_ITEM_OWNER( pxListItem )				( ( pxListItem )->pvOwner )
+
 /*
  * Access macro to determine if a list contains any items.  The macro will
  * only have the value true if the list is empty.
@@ -0,0 +1,205 @@
+/*
+    FreeRTOS V6.1.0 - Copyright (C) 2010 Real Time Engineers Ltd.
+
+    ***************************************************************************
+    *                                                                         *
+    * If you are:                                                             *
+    *                                                                         *
+    *    + New to FreeRTOS,                                                   *
+    *    + Wanting to learn FreeRTOS or multitasking in general quickly       *
+    *    + Looking for basic training,                                        *
+    *    + Wanting to improve your FreeRTOS skills and productivity           *
+    *                                                                         *
+    * then take a look at the FreeRTOS books - available as PDF or paperback  *
+    *                                                                         *
+    *        "Using the FreeRTOS Real Time Kernel - a Practical Guide"        *
+    *                  http://www.FreeRTOS.org/Documentation                  *
+    *                                                                         *
+    * A pdf reference manual is also available.  Both are usually delivered   *
+    * to your inbox within 20 minutes to two hours when purchased between 8am *
+    * and 8pm GMT (although please allow up to 24 hours in case of            *
+    * exceptional circumstances).  Thank you for your support!                *
+    *                                                                         *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    ***NOTE*** The exception to the GPL is included to allow you to distribute
+    a combined work that includes FreeRTOS without being obliged to provide the
+    source code for proprietary components outside of the FreeRTOS kernel.
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public 
+    License and the FreeRTOS license exception along with FreeRTOS; if not it 
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained 
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+
+#ifndef INC_FREERTOS_H
+	#error "#include FreeRTOS.h" must appear in source files before "#include message_buffer.h"
+#endif
+
+#ifndef MESSAGE_BUFFER_H
+#define MESSAGE_BUFFER_H
+
+/*
+ * Message buffers are stream buffers that keep the boundaries of the data
+ * written: each message is stored behind a size_t length, a send writes a
+ * whole message or nothing and a receive reads one whole message.  So a
+ * message of n bytes uses n + sizeof( size_t ) bytes of the buffer.  As with
+ * stream buffers there must be a single writer and a single reader.
+ */
+#include "stream_buffer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * message_buffer. h
+ *
+ * Type by which message buffers are referenced.
+ *
+ * \page xMessageBufferHandle xMessageBufferHandle
+ * \ingroup MessageBuffers
+ */
+typedef xStreamBufferHandle xMessageBufferHandle;
+typedef xStaticStreamBuffer xStaticMessageBuffer;
+
+/**
+ * message_buffer. h
+ * <pre>xMessageBufferHandle xMessageBufferCreate( size_t xBufferSizeBytes );</pre>
+ *
+ * Creates a message buffer of xBufferSizeBytes bytes, length headers
+ * included.  A task blocked in xMessageBufferReceive() is woken as soon as
+ * a message is written.
+ *
+ * @return A handle to the created message buffer, or NULL if there was not
+ * enough heap memory.
+ *
+ * \defgroup xMessageBufferCreate xMessageBufferCreate
+ * \ingroup MessageBuffers
+ */
+#define xMessageBufferCreate( xBufferSizeBytes ) xStreamBufferGenericCreate( ( xBufferSizeBytes ), ( size_t ) 0, pdTRUE )
+
+/**
+ * message_buffer. h
+ * <pre>
+ xMessageBufferHandle xMessageBufferCreateStatic( size_t xBufferSizeBytes,
+												  unsigned char *pucMessageBufferStorage,
+												  xStaticMessageBuffer *pxStaticMessageBuffer );
+ * </pre>
+ *
+ * As xMessageBufferCreate() but uses the memory provided by the caller.
+ * pucMessageBufferStorage must be at least xBufferSizeBytes + 1 bytes long.
+ *
+ * \defgroup xMessageBufferCreateStatic xMessageBufferCreateStatic
+ * \ingroup MessageBuffers
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	#define xMessageBufferCreateStatic( xBufferSizeBytes, pucMessageBufferStorage, pxStaticMessageBuffer ) xStreamBufferGenericCreateStatic( ( xBufferSizeBytes ), ( size_t ) 0, pdTRUE, ( pucMessageBufferStorage ), ( pxStaticMessageBuffer ) )
+#endif
+
+/**
+ * message_buffer. h
+ * <pre>
+ size_t xMessageBufferSend( xMessageBufferHandle xMessageBuffer,
+							const void *pvTxData,
+							size_t xDataLengthBytes,
+							portTickType xTicksToWait );
+ * </pre>
+ *
+ * Write a message.  If there is not enough space for the message and its
+ * length the task blocks for up to xTicksToWait ticks for space.
+ *
+ * @return xDataLengthBytes if the message was written, 0 if the block time
+ * expired or the message can never fit in the buffer.
+ *
+ * \defgroup xMessageBufferSend xMessageBufferSend
+ * \ingroup MessageBuffers
+ */
+#define xMessageBufferSend( xMessageBuffer, pvTxData, xDataLengthBytes, xTicksToWait ) xStreamBufferSend( ( xMessageBuffer ), ( pvTxData ), ( xDataLengthBytes ), ( xTicksToWait ) )
+
+/**
+ * message_buffer. h
+ * <pre>
+ size_t xMessageBufferSendFromISR( xMessageBufferHandle xMessageBuffer,
+								   const void *pvTxData,
+								   size_t xDataLengthBytes,
+								   signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+ * </pre>
+ *
+ * A version of xMessageBufferSend() that can be called from an ISR.
+ *
+ * \defgroup xMessageBufferSendFromISR xMessageBufferSendFromISR
+ * \ingroup MessageBuffers
+ */
+#define xMessageBufferSendFromISR( xMessageBuffer, pvTxData, xDataLengthBytes, pxHigherPriorityTaskWoken ) xStreamBufferSendFromISR( ( xMessageBuffer ), ( pvTxData ), ( xDataLengthBytes ), ( pxHigherPriorityTaskWoken ) )
+
+/**
+ * message_buffer. h
+ * <pre>
+ size_t xMessageBufferReceive( xMessageBufferHandle xMessageBuffer,
+							   void *pvRxData,
+							   size_t xBufferLengthBytes,
+							   portTickType xTicksToWait );
+ * </pre>
+ *
+ * Read the next message.  If the buffer is empty the task blocks for up to
+ * xTicksToWait ticks for a message.
+ *
+ * @return The length of the message read.  0 if the block time expired, or
+ * if the next message is longer than xBufferLengthBytes, in which case it is
+ * left in the buffer.
+ *
+ * \defgroup xMessageBufferReceive xMessageBufferReceive
+ * \ingroup MessageBuffers
+ */
+#define xMessageBufferReceive( xMessageBuffer, pvRxData, xBufferLengthBytes, xTicksToWait ) xStreamBufferReceive( ( xMessageBuffer ), ( pvRxData ), ( xBufferLengthBytes ), ( xTicksToWait ) )
+
+/**
+ * message_buffer. h
+ * <pre>
+ size_t xMessageBufferReceiveFromISR( xMessageBufferHandle xMessageBuffer,
+									  void *pvRxData,
+									  size_t xBufferLengthBytes,
+									  signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+ * </pre>
+ *
+ * A version of xMessageBufferReceive() that can be called from an ISR.
+ *
+ * \defgroup xMessageBufferReceiveFromISR xMessageBufferReceiveFromISR
+ * \ingroup MessageBuffers
+ */
+#define xMessageBufferReceiveFromISR( xMessageBuffer, pvRxData, xBufferLengthBytes, pxHigherPriorityTaskWoken ) xStreamBufferReceiveFromISR( ( xMessageBuffer ), ( pvRxData ), ( xBufferLengthBytes ), ( pxHigherPriorityTaskWoken ) )
+
+#define vMessageBufferDelete( xMessageBuffer ) vStreamBufferDelete( xMessageBuffer )
+#define xMessageBufferIsEmpty( xMessageBuffer ) xStreamBufferIsEmpty( xMessageBuffer )
+#define xMessageBufferIsFull( xMessageBuffer ) xStreamBufferIsFull( xMessageBuffer )
+#define xMessageBufferSpacesAvailable( xMessageBuffer ) xStreamBufferSpacesAvailable( xMessageBuffer )
+#define xMessageBufferReset( xMessageBuffer ) xStreamBufferReset( xMessageBuffer )
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MESSAGE_BUFFER_H */
+
@@ -81,6 +81,7 @@ extern "C" {
 #endif
 
 #include "system.h"
+#include "ktrace.h"
 
 /*-----------------------------------------------------------
  * Port specific definitions.
@@ -120,20 +121,120 @@ extern void vPortYieldProcessor(void);
 
 /*-----------------------------------------------------------*/
 
+/* Port optimised task selection. */
+#if configUSE_PORT_OPTIMISED_TASK_SELECTION == 1
+
+	/* Each bit of uxTopReadyPriority is a priority with ready tasks, so
+	configMAX_PRIORITIES must not be more than 32. */
+
+	/* rv32i has no clz instruction, see ulPortCountLeadingZeros() in port.c. */
+	extern unsigned portLONG ulPortCountLeadingZeros( unsigned portLONG ulBitmap );
+
+	#define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) |= ( 1UL << ( uxPriority ) )
+	#define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) &= ~( 1UL << ( uxPriority ) )
+	#define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities ) uxTopPriority = ( 31 - ulPortCountLeadingZeros( ( uxReadyPriorities ) ) )
+
+#endif
+/*-----------------------------------------------------------*/
+
 /* Task utilities. */
 
 #define portYIELD()			vPortYieldProcessor()
+#ifdef IRQ_NESTING_ENABLE
+extern void vPortYieldFromISR( void );
+#define portYIELD_FROM_ISR()		vPortYieldFromISR()
+#else
 #define portYIELD_FROM_ISR()		vTaskSwitchContext()
+#endif
+
+#if configUSE_TICKLESS_IDLE == 1
+/* Called by the idle task to sleep through xExpectedIdleTime ticks, see
+port.c. */
+extern void vPortSuppressTicksAndSleep( portTickType xExpectedIdleTime );
+#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime )	vPortSuppressTicksAndSleep( xExpectedIdleTime )
+#endif
 
 /* Critical section handling. */
 #define portDISABLE_INTERRUPTS()	__irq_disable()
 #define portENABLE_INTERRUPTS()		__irq_enable()
 
+#ifdef IRQ_NESTING_ENABLE
+/* Handlers run with irq on when nesting is enabled, so the kernel calls made
+from an ISR have to turn irq off themselves. */
+#define portSET_INTERRUPT_MASK_FROM_ISR()				__irq_save()
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedStatusValue )	__irq_restore( uxSavedStatusValue )
+#endif
+
+#if configGENERATE_CYCLE_STATS == 1
+/* Charge the cycles used since the last switch, less the time spent in irq
+handlers, to the task being switched out. */
+extern unsigned long long cpustat_task_slice( void );
+#define portGET_TASK_CYCLES()		cpustat_task_slice()
+#define portCHARGE_TASK_CYCLES()	pxCurrentTCB->ullCycleCounter += portGET_TASK_CYCLES()
+#else
+#define portCHARGE_TASK_CYCLES()
+#endif
+
+#if configGENERATE_LOCK_STATS == 1
+/* Time base of the mutex hold and wait times. */
+#define portGET_LOCK_CYCLES()		get_cycles64()
+#endif
+
+#ifdef KERNEL_TRACE_ENABLE
+/* Record the kernel events into the ring of hal/ktrace.c, see
+KERNEL_TRACE_ENABLE in board.h.  The cycle stats are still charged on a
+switch. */
+#define traceTASK_SWITCHED_OUT()	{ portCHARGE_TASK_CYCLES(); ktrace_record( KTRACE_TASK_SWITCHED_OUT, pxCurrentTCB, 0 ); }
+#define traceTASK_SWITCHED_IN()		ktrace_record( KTRACE_TASK_SWITCHED_IN, pxCurrentTCB, pxCurrentTCB->uxPriority )
+#define traceMOVED_TASK_TO_READY_STATE( pxTCB )	ktrace_record( KTRACE_TASK_READY, pxTCB, ( pxTCB )->uxPriority )
+#define traceTASK_CREATE( pxNewTCB )	ktrace_task_create( pxNewTCB, ( pxNewTCB )->pcTaskName, ( pxNewTCB )->uxPriority )
+#define traceTASK_DELAY()		ktrace_record( KTRACE_TASK_DELAY, pxCurrentTCB, 0 )
+#define traceTASK_DELAY_UNTIL()		ktrace_record( KTRACE_TASK_DELAY, pxCurrentTCB, 0 )
+#define traceTASK_SUSPEND( pxTaskToSuspend )	ktrace_record( KTRACE_TASK_SUSPEND, pxTaskToSuspend, 0 )
+#define traceTASK_RESUME( pxTaskToResume )	ktrace_record( KTRACE_TASK_RESUME, pxTaskToResume, 0 )
+#define traceTASK_RESUME_FROM_ISR( pxTaskToResume )	ktrace_record( KTRACE_TASK_RESUME, pxTaskToResume, 0 )
+#define traceTASK_INCREMENT_TICK( xTickCount )	ktrace_record( KTRACE_TICK, ( void * ) ( xTickCount ), 0 )
+#define traceQUEUE_CREATE( pxNewQueue )	ktrace_record( KTRACE_QUEUE_CREATE, pxNewQueue, 0 )
+#define traceCREATE_MUTEX( pxNewQueue )	ktrace_record( KTRACE_MUTEX_CREATE, pxNewQueue, 0 )
+#define traceQUEUE_DELETE( pxQueue )	ktrace_record( KTRACE_QUEUE_DELETE, pxQueue, 0 )
+#define traceQUEUE_SEND( pxQueue )	ktrace_record( KTRACE_QUEUE_SEND, pxQueue, 0 )
+#define traceQUEUE_SEND_FAILED( pxQueue )	ktrace_record( KTRACE_QUEUE_SEND_FAILED, pxQueue, 0 )
+#define traceQUEUE_RECEIVE( pxQueue )	ktrace_record( KTRACE_QUEUE_RECEIVE, pxQueue, 0 )
+#define traceQUEUE_RECEIVE_FAILED( pxQueue )	ktrace_record( KTRACE_QUEUE_RECEIVE_FAILED, pxQueue, 0 )
+#define traceQUEUE_PEEK( pxQueue )	ktrace_record( KTRACE_QUEUE_PEEK, pxQueue, 0 )
+#define traceBLOCKING_ON_QUEUE_SEND( pxQueue )	ktrace_record( KTRACE_QUEUE_BLOCK_SEND, pxQueue, 0 )
+#define traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue )	ktrace_record( KTRACE_QUEUE_BLOCK_RECEIVE, pxQueue, 0 )
+#define traceQUEUE_SEND_FROM_ISR( pxQueue )	ktrace_record( KTRACE_QUEUE_SEND_ISR, pxQueue, 0 )
+#define traceQUEUE_RECEIVE_FROM_ISR( pxQueue )	ktrace_record( KTRACE_QUEUE_RECEIVE_ISR, pxQueue, 0 )
+#elif configGENERATE_CYCLE_STATS == 1
+#define traceTASK_SWITCHED_OUT()	portCHARGE_TASK_CYCLES()
+#endif
+
+/* The critical section macros are inlined on the ctlirq wrappers of
+picorv32.h, they do what vPortEnterCritical() and vPortExitCritical() do
+without the calls.  ulCriticalNesting is part of the task context, see
+start.S.  The functions are kept for the code that needs them out of line. */
+extern volatile unsigned portLONG ulCriticalNesting;
+
 extern void vPortEnterCritical( void );
 extern void vPortExitCritical( void );
 
-#define portENTER_CRITICAL()		vPortEnterCritical();
-#define portEXIT_CRITICAL()		vPortExitCritical();
+#define portENTER_CRITICAL()									\
+{																\
+	__irq_disable();											\
+	ulCriticalNesting++;										\
+}
+
+#define portEXIT_CRITICAL()										\
+{																\
+	if( ulCriticalNesting > 0UL )								\
+	{															\
+		if( --ulCriticalNesting == 0UL )						\
+		{														\
+			__irq_enable();										\
+		}														\
+	}															\
+}
 
 /*-----------------------------------------------------------*/
 
@@ -71,6 +71,24 @@ extern "C" {
 
 typedef void * xQueueHandle;
 
+/*
+ * A queue set, and a queue or semaphore that is a member of one.  See
+ * xQueueCreateSet().
+ */
+typedef void * xQueueSetHandle;
+typedef void * xQueueSetMemberHandle;
+
+/*
+ * The item held by a zero copy queue: a buffer and the length of the data in
+ * it.  Only this descriptor is copied in and out of the queue, never the
+ * buffer.
+ */
+typedef struct QueueBufferDefinition
+{
+	void *pvData;
+	size_t xLength;
+} xQueueBuffer;
+
 
 /* For internal use only. */
 #define	queueSEND_TO_BACK	( 0 )
@@ -135,6 +153,62 @@ typedef void * xQueueHandle;
  */
 xQueueHandle xQueueCreate( unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize );
 
+/**
+ * queue. h
+ * <pre>
+ xQueueHandle xQueueCreateStatic(
+							  unsigned portBASE_TYPE uxQueueLength,
+							  unsigned portBASE_TYPE uxItemSize,
+							  unsigned char *pucQueueStorage,
+							  xStaticQueue *pxStaticQueue
+						  );
+ * </pre>
+ *
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * this function to be available.
+ *
+ * Creates a new queue instance as xQueueCreate() does, but uses the memory
+ * provided by the caller instead of allocating it from the heap.  Both
+ * buffers must remain valid for the lifetime of the queue and are not freed
+ * by vQueueDelete().
+ *
+ * @param uxQueueLength The maximum number of items that the queue can contain.
+ *
+ * @param uxItemSize The number of bytes each item in the queue will require.
+ *
+ * @param pucQueueStorage Array of at least uxQueueLength * uxItemSize bytes
+ * that holds the queued items.  Can be NULL if uxItemSize is 0.
+ *
+ * @param pxStaticQueue Variable of type xStaticQueue used to hold the queue
+ * structure.
+ *
+ * @return A handle to the created queue, or 0 if a parameter is invalid.
+ *
+ * Example usage:
+   <pre>
+ #define QUEUE_LENGTH	10
+
+ static unsigned long ulQueueStorage[ QUEUE_LENGTH ];
+ static xStaticQueue xQueueBuffer;
+
+ void vATask( void *pvParameters )
+ {
+ xQueueHandle xQueue;
+
+	// Create a queue capable of containing 10 unsigned long values, without
+	// using the heap.
+	xQueue = xQueueCreateStatic( QUEUE_LENGTH, sizeof( unsigned long ), ( unsigned char * ) ulQueueStorage, &xQueueBuffer );
+
+	// ... Rest of task code.
+ }
+ </pre>
+ * \defgroup xQueueCreateStatic xQueueCreateStatic
+ * \ingroup QueueManagement
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	xQueueHandle xQueueCreateStatic( unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize, unsigned char *pucQueueStorage, xStaticQueue *pxStaticQueue );
+#endif
+
 /**
  * queue. h
  * <pre>
@@ -786,6 +860,97 @@ unsigned portBASE_TYPE uxQueueMessagesWaiting( const xQueueHandle xQueue );
  */
 void vQueueDelete( xQueueHandle xQueue );
 
+/**
+ * queue. h
+ * <pre>xQueueHandle xQueueCreateZeroCopy( unsigned portBASE_TYPE uxQueueLength );</pre>
+ *
+ * <i>Macro</i> that creates a queue of xQueueBuffer descriptors.  Such a
+ * queue passes the ownership of a buffer from the sending task to the
+ * receiving task: only the pointer and the length are copied, whatever the
+ * size of the buffer, so the time spent copying and in critical sections
+ * does not grow with the size of the messages.  The buffers are typically
+ * taken from a pool of fixed size blocks, see bufpool.h.
+ *
+ * Use xQueueSendBuffer() and xQueueReceiveBuffer() (or the FromISR
+ * versions) with such a queue.
+ *
+ * @param uxQueueLength The maximum number of buffers that the queue can
+ * contain.
+ *
+ * \defgroup xQueueCreateZeroCopy xQueueCreateZeroCopy
+ * \ingroup QueueManagement
+ */
+#define xQueueCreateZeroCopy( uxQueueLength ) xQueueCreate( ( uxQueueLength ), sizeof( xQueueBuffer ) )
+
+/**
+ * queue. h
+ * <pre>
+ portBASE_TYPE xQueueSendBuffer(
+								  xQueueHandle xQueue,
+								  void *pvData,
+								  size_t xLength,
+								  portTickType xTicksToWait
+							  );
+ * </pre>
+ *
+ * Post a buffer to the back of a queue created by xQueueCreateZeroCopy().
+ * When pdPASS is returned the buffer belongs to the task that receives it
+ * and the sender must no longer access it.  On failure the sender still
+ * owns the buffer.
+ *
+ * @param xQueue The handle to the queue on which the buffer is to be posted.
+ *
+ * @param pvData The buffer, which is not copied.
+ *
+ * @param xLength The number of valid bytes in the buffer.
+ *
+ * @param xTicksToWait As for xQueueSend().
+ *
+ * @return pdPASS if the buffer was posted, otherwise errQUEUE_FULL.
+ *
+ * \defgroup xQueueSendBuffer xQueueSendBuffer
+ * \ingroup QueueManagement
+ */
+signed portBASE_TYPE xQueueSendBuffer( xQueueHandle xQueue, void *pvData, size_t xLength, portTickType xTicksToWait );
+
+/**
+ * queue. h
+ * <pre>
+ portBASE_TYPE xQueueReceiveBuffer(
+									 xQueueHandle xQueue,
+									 void **ppvData,
+									 size_t *pxLength,
+									 portTickType xTicksToWait
+								 );
+ * </pre>
+ *
+ * Receive a buffer from a queue created by xQueueCreateZeroCopy().  The
+ * calling task owns the buffer on return, and must free it or pass it on.
+ *
+ * @param xQueue The handle to the queue from which the buffer is received.
+ *
+ * @param ppvData Set to the received buffer.
+ *
+ * @param pxLength Set to the number of valid bytes in the buffer.  Can be
+ * NULL.
+ *
+ * @param xTicksToWait As for xQueueReceive().
+ *
+ * @return pdPASS if a buffer was received, otherwise pdFALSE.
+ *
+ * \defgroup xQueueReceiveBuffer xQueueReceiveBuffer
+ * \ingroup QueueManagement
+ */
+signed portBASE_TYPE xQueueReceiveBuffer( xQueueHandle xQueue, void **ppvData, size_t *pxLength, portTickType xTicksToWait );
+
+/*
+ * Versions of xQueueSendBuffer() and xQueueReceiveBuffer() that can be
+ * called from an ISR.  The pxHigherPriorityTaskWoken parameter is as for
+ * xQueueSendFromISR() and xQueueReceiveFromISR().
+ */
+signed portBASE_TYPE xQueueSendBufferFromISR( xQueueHandle xQueue, void *pvData, size_t xLength, signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+signed portBASE_TYPE xQueueReceiveBufferFromISR( xQueueHandle xQueue, void **ppvData, size_t *pxLength, signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+
 /**
  * queue. h
  * <pre>
@@ -1176,6 +1341,139 @@ signed portBASE_TYPE xQueueIsQueueEmptyFromISR( const xQueueHandle pxQueue );
 signed portBASE_TYPE xQueueIsQueueFullFromISR( const xQueueHandle pxQueue );
 unsigned portBASE_TYPE uxQueueMessagesWaitingFromISR( const xQueueHandle pxQueue );
 
+/**
+ * queue. h
+ * <pre>
+ xQueueSetHandle xQueueCreateSet( unsigned portBASE_TYPE uxEventQueueLength );
+ </pre>
+ *
+ * configUSE_QUEUE_SETS must be set to 1 in FreeRTOSConfig.h for the queue set
+ * functions to be available.
+ *
+ * Create a queue set.  A task blocks on a set with xQueueSelectFromSet()
+ * until any of the queues and semaphores added to the set has an item, in
+ * place of polling each of them or dedicating a task to each.
+ *
+ * The set holds the handle of a member each time an item is sent to that
+ * member, so the oldest handle is returned first and selecting costs the
+ * same whatever the number of members.  The item itself must then be read
+ * from the returned member, with a block time of 0, before selecting again.
+ *
+ * Mutexes cannot be added to a set.  A task must not block on a member of a
+ * set directly: sending to a member only wakes the tasks blocked on the set.
+ *
+ * @param uxEventQueueLength The number of handles the set can hold.  The sum
+ * of the lengths of the members (1 for a binary semaphore) is kept within it
+ * by xQueueAddToSet(), so no event is lost.
+ *
+ * @return The set, or NULL if there was not enough heap memory.
+ *
+ * Example usage:
+   <pre>
+ void vAGatewayTask( void *pvParameters )
+ {
+ xQueueSetHandle xSet;
+ xQueueSetMemberHandle xMember;
+ xMessage xMessage;
+
+	xSet = xQueueCreateSet( RX_QUEUE_LENGTH + CMD_QUEUE_LENGTH + 1 );
+	xQueueAddToSet( xRxQueue, xSet );
+	xQueueAddToSet( xCmdQueue, xSet );
+	xQueueAddToSet( xTimeoutSemaphore, xSet );
+
+	for( ;; )
+	{
+		xMember = xQueueSelectFromSet( xSet, portMAX_DELAY );
+
+		if( xMember == xTimeoutSemaphore )
+		{
+			xSemaphoreTake( xTimeoutSemaphore, 0 );
+		}
+		else if( xMember != NULL )
+		{
+			xQueueReceive( xMember, &xMessage, 0 );
+		}
+	}
+ }
+   </pre>
+ * \defgroup xQueueCreateSet xQueueCreateSet
+ * \ingroup QueueSets
+ */
+#if ( configUSE_QUEUE_SETS == 1 )
+	xQueueSetHandle xQueueCreateSet( unsigned portBASE_TYPE uxEventQueueLength );
+#endif
+
+/**
+ * queue. h
+ * <pre>
+ portBASE_TYPE xQueueAddToSet( xQueueSetMemberHandle xQueueOrSemaphore, xQueueSetHandle xQueueSet );
+ </pre>
+ *
+ * Add a queue or semaphore to a set.
+ *
+ * @return pdPASS, or pdFAIL if the queue is a mutex, is already in a set, is
+ * not empty or is too long for the room left in the set.  configASSERT() is
+ * called for the last case, which is a set created too short.
+ *
+ * \defgroup xQueueAddToSet xQueueAddToSet
+ * \ingroup QueueSets
+ */
+#if ( configUSE_QUEUE_SETS == 1 )
+	portBASE_TYPE xQueueAddToSet( xQueueSetMemberHandle xQueueOrSemaphore, xQueueSetHandle xQueueSet );
+#endif
+
+/**
+ * queue. h
+ * <pre>
+ portBASE_TYPE xQueueRemoveFromSet( xQueueSetMemberHandle xQueueOrSemaphore, xQueueSetHandle xQueueSet );
+ </pre>
+ *
+ * Remove a queue or semaphore from a set.
+ *
+ * @return pdPASS, or pdFAIL if the queue is not in the set or is not empty.
+ *
+ * \defgroup xQueueRemoveFromSet xQueueRemoveFromSet
+ * \ingroup QueueSets
+ */
+#if ( configUSE_QUEUE_SETS == 1 )
+	portBASE_TYPE xQueueRemoveFromSet( xQueueSetMemberHandle xQueueOrSemaphore, xQueueSetHandle xQueueSet );
+#endif
+
+/**
+ * queue. h
+ * <pre>
+ xQueueSetMemberHandle xQueueSelectFromSet( xQueueSetHandle xQueueSet, portTickType xTicksToWait );
+ </pre>
+ *
+ * Block until a member of the set has an item, or xTicksToWait ticks have
+ * passed.
+ *
+ * @return The member to read from, or NULL on a timeout.
+ *
+ * \defgroup xQueueSelectFromSet xQueueSelectFromSet
+ * \ingroup QueueSets
+ */
+#if ( configUSE_QUEUE_SETS == 1 )
+	xQueueSetMemberHandle xQueueSelectFromSet( xQueueSetHandle xQueueSet, portTickType xTicksToWait );
+#endif
+
+/**
+ * queue. h
+ * <pre>
+ xQueueSetMemberHandle xQueueSelectFromSetFromISR( xQueueSetHandle xQueueSet );
+ </pre>
+ *
+ * A version of xQueueSelectFromSet() that can be called from an interrupt.
+ *
+ * @return The member to read from, or NULL if no member has an item.
+ *
+ * \defgroup xQueueSelectFromSetFromISR xQueueSelectFromSetFromISR
+ * \ingroup QueueSets
+ */
+#if ( configUSE_QUEUE_SETS == 1 )
+	xQueueSetMemberHandle xQueueSelectFromSetFromISR( xQueueSetHandle xQueueSet );
+#endif
+
 
 /*
  * xQueueAltGenericSend() is an alternative version of xQueueGenericSend().
@@ -1219,6 +1517,16 @@ signed portBASE_TYPE xQueueCRReceive( xQueueHandle pxQueue, void *pvBuffer, port
 xQueueHandle xQueueCreateMutex( void );
 xQueueHandle xQueueCreateCountingSemaphore( unsigned portBASE_TYPE uxCountValue, unsigned portBASE_TYPE uxInitialCount );
 
+/*
+ * For internal use only.  Use xSemaphoreCreateBinaryStatic(),
+ * xSemaphoreCreateMutexStatic() or xSemaphoreCreateCountingStatic() instead
+ * of calling these functions directly.
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	xQueueHandle xQueueCreateMutexStatic( xStaticQueue *pxStaticQueue );
+	xQueueHandle xQueueCreateSemaphoreStatic( unsigned portBASE_TYPE uxCountValue, unsigned portBASE_TYPE uxInitialCount, xStaticQueue *pxStaticQueue );
+#endif
+
 /*
  * For internal use only.  Use xSemaphoreTakeMutexRecursive() or
  * xSemaphoreGiveMutexRecursive() instead of calling these functions directly.
@@ -1250,6 +1558,22 @@ portBASE_TYPE xQueueGiveMutexRecursive( xQueueHandle xMutex );
 	void vQueueAddToRegistry( xQueueHandle xQueue, signed char *pcName );
 #endif
 
+/*
+ * configGENERATE_LOCK_STATS must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * Fills pxStats with the acquisition counts, the longest hold time and the
+ * longest wait of up to uxMaxLocks mutexes, most recently created first.  A
+ * take is counted as contended when it found the mutex held and waited for
+ * it; a take that times out is not counted.  The name of a mutex is the one
+ * it was given with vQueueAddToRegistry(), if any.
+ *
+ * @return The number of entries written to pxStats.
+ */
+#if ( configGENERATE_LOCK_STATS == 1 )
+	unsigned portBASE_TYPE uxQueueGetLockStats( xQueueLockStats *pxStats, unsigned portBASE_TYPE uxMaxLocks );
+#endif
+
 
 
 
@@ -61,6 +61,7 @@
 #include "queue.h"
 
 typedef xQueueHandle xSemaphoreHandle;
+typedef xStaticQueue xStaticSemaphore;
 
 #define semBINARY_SEMAPHORE_QUEUE_LENGTH	( ( unsigned char ) 1 )
 #define semSEMAPHORE_QUEUE_ITEM_LENGTH		( ( unsigned char ) 0 )
@@ -705,6 +706,46 @@ typedef xQueueHandle xSemaphoreHandle;
  */
 #define xSemaphoreCreateCounting( uxMaxCount, uxInitialCount ) xQueueCreateCountingSemaphore( uxMaxCount, uxInitialCount )
 
+/**
+ * semphr. h
+ * <pre>xSemaphoreHandle xSemaphoreCreateBinaryStatic( xStaticSemaphore *pxSemaphoreBuffer )</pre>
+ * <pre>xSemaphoreHandle xSemaphoreCreateMutexStatic( xStaticSemaphore *pxSemaphoreBuffer )</pre>
+ * <pre>xSemaphoreHandle xSemaphoreCreateRecursiveMutexStatic( xStaticSemaphore *pxSemaphoreBuffer )</pre>
+ * <pre>xSemaphoreHandle xSemaphoreCreateCountingStatic( unsigned portBASE_TYPE uxMaxCount, unsigned portBASE_TYPE uxInitialCount, xStaticSemaphore *pxSemaphoreBuffer )</pre>
+ *
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * these macros to be available.
+ *
+ * <i>Macros</i> that create a semaphore or mutex as vSemaphoreCreateBinary(),
+ * xSemaphoreCreateMutex(), xSemaphoreCreateRecursiveMutex() and
+ * xSemaphoreCreateCounting() do, but use the xStaticSemaphore variable
+ * provided by the caller instead of allocating from the heap.  The binary
+ * semaphore is created in the 'given' state, as with vSemaphoreCreateBinary().
+ *
+ * @return Handle to the created semaphore.  Null if pxSemaphoreBuffer is
+ * NULL.
+ *
+ * Example usage:
+ <pre>
+ static xStaticSemaphore xSemaphoreBuffer;
+
+ void vATask( void * pvParameters )
+ {
+ xSemaphoreHandle xSemaphore;
+
+    xSemaphore = xSemaphoreCreateMutexStatic( &xSemaphoreBuffer );
+ }
+ </pre>
+ * \defgroup xSemaphoreCreateStatic xSemaphoreCreateStatic
+ * \ingroup Semaphores
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	#define xSemaphoreCreateBinaryStatic( pxSemaphoreBuffer ) xQueueCreateSemaphoreStatic( ( unsigned portBASE_TYPE ) semBINARY_SEMAPHORE_QUEUE_LENGTH, ( unsigned portBASE_TYPE ) 1, ( pxSemaphoreBuffer ) )
+	#define xSemaphoreCreateMutexStatic( pxSemaphoreBuffer ) xQueueCreateMutexStatic( pxSemaphoreBuffer )
+	#define xSemaphoreCreateRecursiveMutexStatic( pxSemaphoreBuffer ) xQueueCreateMutexStatic( pxSemaphoreBuffer )
+	#define xSemaphoreCreateCountingStatic( uxMaxCount, uxInitialCount, pxSemaphoreBuffer ) xQueueCreateSemaphoreStatic( ( uxMaxCount ), ( uxInitialCount ), ( pxSemaphoreBuffer ) )
+#endif
+
 
 #endif /* SEMAPHORE_H */
 
@@ -0,0 +1,293 @@
+/*
+    FreeRTOS V6.1.0 - Copyright (C) 2010 Real Time Engineers Ltd.
+
+    ***************************************************************************
+    *                                                                         *
+    * If you are:                                                             *
+    *                                                                         *
+    *    + New to FreeRTOS,                                                   *
+    *    + Wanting to learn FreeRTOS or multitasking in general quickly       *
+    *    + Looking for basic training,                                        *
+    *    + Wanting to improve your FreeRTOS skills and productivity           *
+    *                                                                         *
+    * then take a look at the FreeRTOS books - available as PDF or paperback  *
+    *                                                                         *
+    *        "Using the FreeRTOS Real Time Kernel - a Practical Guide"        *
+    *                  http://www.FreeRTOS.org/Documentation                  *
+    *                                                                         *
+    * A pdf reference manual is also available.  Both are usually delivered   *
+    * to your inbox within 20 minutes to two hours when purchased between 8am *
+    * and 8pm GMT (although please allow up to 24 hours in case of            *
+    * exceptional circumstances).  Thank you for your support!                *
+    *                                                                         *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    ***NOTE*** The exception to the GPL is included to allow you to distribute
+    a combined work that includes FreeRTOS without being obliged to provide the
+    source code for proprietary components outside of the FreeRTOS kernel.
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public 
+    License and the FreeRTOS license exception along with FreeRTOS; if not it 
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained 
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+
+#ifndef INC_FREERTOS_H
+	#error "#include FreeRTOS.h" must appear in source files before "#include stream_buffer.h"
+#endif
+
+#ifndef STREAM_BUFFER_H
+#define STREAM_BUFFER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * stream_buffer. h
+ *
+ * Type by which stream buffers are referenced.  For example, a call to
+ * xStreamBufferCreate() returns an xStreamBufferHandle variable that can
+ * then be used as a parameter to xStreamBufferSend(), xStreamBufferReceive(),
+ * etc.  Message buffers (see message_buffer.h) are referenced the same way.
+ *
+ * A stream buffer passes a stream of bytes from a single writer (a task or
+ * an interrupt) to a single reader (a task or an interrupt).  The data is
+ * copied in and out without a critical section: the writer only updates the
+ * head index and the reader only updates the tail index.  A task blocks on
+ * one of the two event lists of the buffer, as on a queue, so the task
+ * notification value of the tasks using a stream buffer is free for other
+ * uses.  If there are several writers or several readers the application must
+ * serialise them, e.g. with a mutex or a critical section.
+ *
+ * \page xStreamBufferHandle xStreamBufferHandle
+ * \ingroup StreamBuffers
+ */
+typedef void * xStreamBufferHandle;
+
+/*
+ * Storage for a stream or message buffer created with
+ * xStreamBufferCreateStatic() or xMessageBufferCreateStatic().  The
+ * structure has the same size as the one private to stream_buffer.c, its
+ * members must not be accessed by the application.
+ */
+typedef struct xSTATIC_STREAM_BUFFER
+{
+	size_t xDummy1[ 4 ];
+	xList xDummy2[ 2 ];
+	void *pvDummy3;
+	unsigned char ucDummy4;
+} xStaticStreamBuffer;
+
+/**
+ * stream_buffer. h
+ * <pre>
+ xStreamBufferHandle xStreamBufferCreate( size_t xBufferSizeBytes, size_t xTriggerLevelBytes );
+ * </pre>
+ *
+ * Creates a stream buffer that can hold up to xBufferSizeBytes bytes.
+ *
+ * @param xBufferSizeBytes The number of bytes the buffer can hold.
+ *
+ * @param xTriggerLevelBytes The number of bytes that must be in the buffer
+ * before a task blocked in xStreamBufferReceive() is woken.  0 is taken as 1.
+ * A larger value lets the reader handle the data in bigger chunks, the reader
+ * still gets the bytes that are there when its block time expires.
+ *
+ * @return A handle to the created stream buffer, or NULL if there was not
+ * enough heap memory.
+ *
+ * \defgroup xStreamBufferCreate xStreamBufferCreate
+ * \ingroup StreamBuffers
+ */
+#define xStreamBufferCreate( xBufferSizeBytes, xTriggerLevelBytes ) xStreamBufferGenericCreate( ( xBufferSizeBytes ), ( xTriggerLevelBytes ), pdFALSE )
+
+/**
+ * stream_buffer. h
+ * <pre>
+ xStreamBufferHandle xStreamBufferCreateStatic( size_t xBufferSizeBytes,
+												size_t xTriggerLevelBytes,
+												unsigned char *pucStreamBufferStorage,
+												xStaticStreamBuffer *pxStaticStreamBuffer );
+ * </pre>
+ *
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * this macro to be available.
+ *
+ * As xStreamBufferCreate() but uses the memory provided by the caller.
+ * pucStreamBufferStorage must be at least xBufferSizeBytes + 1 bytes long.
+ *
+ * \defgroup xStreamBufferCreateStatic xStreamBufferCreateStatic
+ * \ingroup StreamBuffers
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	#define xStreamBufferCreateStatic( xBufferSizeBytes, xTriggerLevelBytes, pucStreamBufferStorage, pxStaticStreamBuffer ) xStreamBufferGenericCreateStatic( ( xBufferSizeBytes ), ( xTriggerLevelBytes ), pdFALSE, ( pucStreamBufferStorage ), ( pxStaticStreamBuffer ) )
+#endif
+
+/**
+ * stream_buffer. h
+ * <pre>
+ size_t xStreamBufferSend( xStreamBufferHandle xStreamBuffer,
+						   const void *pvTxData,
+						   size_t xDataLengthBytes,
+						   portTickType xTicksToWait );
+ * </pre>
+ *
+ * Copy bytes into a stream buffer.  If there is not enough space for all the
+ * bytes the task blocks for up to xTicksToWait ticks for space to become
+ * available, then writes as many bytes as fit.
+ *
+ * @param xStreamBuffer The handle of the stream buffer.
+ *
+ * @param pvTxData The bytes to copy.
+ *
+ * @param xDataLengthBytes The number of bytes to copy.
+ *
+ * @param xTicksToWait The maximum time to block waiting for space.
+ *
+ * @return The number of bytes written, which can be less than
+ * xDataLengthBytes if the block time expired.
+ *
+ * \defgroup xStreamBufferSend xStreamBufferSend
+ * \ingroup StreamBuffers
+ */
+size_t xStreamBufferSend( xStreamBufferHandle xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer. h
+ * <pre>
+ size_t xStreamBufferSendFromISR( xStreamBufferHandle xStreamBuffer,
+								  const void *pvTxData,
+								  size_t xDataLengthBytes,
+								  signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+ * </pre>
+ *
+ * A version of xStreamBufferSend() that can be called from an ISR.  It
+ * writes as many bytes as fit and never blocks.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if writing the data woke a
+ * task with a priority above the interrupted one, in which case a context
+ * switch should be requested before the ISR exits.
+ *
+ * @return The number of bytes written.
+ *
+ * \defgroup xStreamBufferSendFromISR xStreamBufferSendFromISR
+ * \ingroup StreamBuffers
+ */
+size_t xStreamBufferSendFromISR( xStreamBufferHandle xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer. h
+ * <pre>
+ size_t xStreamBufferReceive( xStreamBufferHandle xStreamBuffer,
+							  void *pvRxData,
+							  size_t xBufferLengthBytes,
+							  portTickType xTicksToWait );
+ * </pre>
+ *
+ * Copy bytes out of a stream buffer.  If the buffer is empty the task blocks
+ * for up to xTicksToWait ticks.  It is woken when the trigger level is
+ * reached, or at the end of the block time with the bytes that arrived.
+ *
+ * @param xStreamBuffer The handle of the stream buffer.
+ *
+ * @param pvRxData Where the bytes are copied to.
+ *
+ * @param xBufferLengthBytes The maximum number of bytes to copy.
+ *
+ * @param xTicksToWait The maximum time to block waiting for data.
+ *
+ * @return The number of bytes read, 0 if the block time expired with the
+ * buffer empty.
+ *
+ * \defgroup xStreamBufferReceive xStreamBufferReceive
+ * \ingroup StreamBuffers
+ */
+size_t xStreamBufferReceive( xStreamBufferHandle xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer. h
+ * <pre>
+ size_t xStreamBufferReceiveFromISR( xStreamBufferHandle xStreamBuffer,
+									 void *pvRxData,
+									 size_t xBufferLengthBytes,
+									 signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+ * </pre>
+ *
+ * A version of xStreamBufferReceive() that can be called from an ISR.  It
+ * never blocks.
+ *
+ * \defgroup xStreamBufferReceiveFromISR xStreamBufferReceiveFromISR
+ * \ingroup StreamBuffers
+ */
+size_t xStreamBufferReceiveFromISR( xStreamBufferHandle xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer. h
+ * <pre>void vStreamBufferDelete( xStreamBufferHandle xStreamBuffer );</pre>
+ *
+ * Delete a stream buffer, freeing its memory unless it was provided by the
+ * application.  No task must be blocked on the buffer.
+ *
+ * \defgroup vStreamBufferDelete vStreamBufferDelete
+ * \ingroup StreamBuffers
+ */
+void vStreamBufferDelete( xStreamBufferHandle xStreamBuffer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Query the state of a stream buffer.  The result can be out of date by the
+ * time it is used if the other side is running.
+ */
+portBASE_TYPE xStreamBufferIsEmpty( xStreamBufferHandle xStreamBuffer ) PRIVILEGED_FUNCTION;
+portBASE_TYPE xStreamBufferIsFull( xStreamBufferHandle xStreamBuffer ) PRIVILEGED_FUNCTION;
+size_t xStreamBufferBytesAvailable( xStreamBufferHandle xStreamBuffer ) PRIVILEGED_FUNCTION;
+size_t xStreamBufferSpacesAvailable( xStreamBufferHandle xStreamBuffer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Change the trigger level of a stream buffer.  Returns pdFALSE if the level
+ * is larger than the buffer.
+ */
+portBASE_TYPE xStreamBufferSetTriggerLevel( xStreamBufferHandle xStreamBuffer, size_t xTriggerLevel ) PRIVILEGED_FUNCTION;
+
+/*
+ * Empty a stream buffer.  Fails, returning pdFAIL, if a task is blocked on
+ * it.
+ */
+portBASE_TYPE xStreamBufferReset( xStreamBufferHandle xStreamBuffer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Functions behind the create macros of stream_buffer.h and
+ * message_buffer.h.  Use the macros instead of calling them directly.
+ */
+xStreamBufferHandle xStreamBufferGenericCreate( size_t xBufferSizeBytes, size_t xTriggerLevelBytes, portBASE_TYPE xIsMessageBuffer ) PRIVILEGED_FUNCTION;
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	xStreamBufferHandle xStreamBufferGenericCreateStatic( size_t xBufferSizeBytes, size_t xTriggerLevelBytes, portBASE_TYPE xIsMessageBuffer, unsigned char *pucStreamBufferStorage, xStaticStreamBuffer *pxStaticStreamBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STREAM_BUFFER_H */
+
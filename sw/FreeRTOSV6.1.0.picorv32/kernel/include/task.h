@@ -119,6 +119,100 @@ typedef struct xTASK_PARAMTERS
 	xMemoryRegion xRegions[ portNUM_CONFIGURABLE_REGIONS ];
 } xTaskParameters;
 
+/*
+ * Storage for the TCB of a task created with xTaskCreateStatic().  The
+ * structure has the same size and alignment as the TCB private to tasks.c
+ * but its members must not be accessed by the application.  tasks.c will
+ * fail to compile if the two definitions get out of step.
+ */
+typedef struct xSTATIC_TCB
+{
+	void *pvDummy1;
+	#if ( portUSING_MPU_WRAPPERS == 1 )
+		xMPU_SETTINGS xDummy2;
+	#endif
+	xListItem xDummy3[ 2 ];
+	unsigned portBASE_TYPE uxDummy4;
+	void *pvDummy5;
+	signed char ucDummy6[ configMAX_TASK_NAME_LEN ];
+	#if ( portSTACK_GROWTH > 0 )
+		void *pvDummy7;
+	#endif
+	#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+		unsigned portBASE_TYPE uxDummy8;
+	#endif
+	#if ( configUSE_TRACE_FACILITY == 1 )
+		unsigned portBASE_TYPE uxDummy9;
+	#endif
+	#if ( configUSE_MUTEXES == 1 )
+		unsigned portBASE_TYPE uxDummy10;
+	#endif
+	#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+		void *pvDummy11;
+	#endif
+	#if ( configGENERATE_RUN_TIME_STATS == 1 )
+		unsigned long ulDummy12;
+	#endif
+	#if ( configGENERATE_CYCLE_STATS == 1 )
+		unsigned long long ullDummy13;
+	#endif
+	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+		unsigned long ulDummy14;
+		unsigned char ucDummy15;
+	#endif
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		unsigned char ucDummy16;
+	#endif
+	#if ( configGENERATE_STACK_STATS == 1 )
+		unsigned short usDummy17;
+	#endif
+} xStaticTask;
+
+/*
+ * Used by uxTaskGetCycleStats() to report the cycles used by a task.
+ */
+typedef struct xTASK_CYCLE_STATS
+{
+	xTaskHandle xHandle;
+	const signed char *pcTaskName;
+	unsigned portBASE_TYPE uxPriority;
+	unsigned long long ullCycles;		/* Cycles used by the task, irq handlers excluded. */
+} xTaskCycleStats;
+
+/*
+ * Used by uxTaskGetStackStats() to report the stack use of a task.  The sizes
+ * are in portSTACK_TYPE words.
+ */
+typedef struct xTASK_STACK_STATS
+{
+	xTaskHandle xHandle;
+	const signed char *pcTaskName;
+	unsigned portBASE_TYPE uxPriority;
+	unsigned short usStackDepth;		/* The usStackDepth the task was created with. */
+	unsigned short usHighWaterMark;		/* The minimum free stack since the task was created. */
+} xTaskStackStats;
+
+/*
+ * Actions that can be performed when xTaskNotify() is called.
+ */
+typedef enum
+{
+	eNoAction = 0,				/* Notify the task without updating its notify value. */
+	eSetBits,					/* Set bits in the task's notification value. */
+	eIncrement,					/* Increment the task's notification value. */
+	eSetValueWithOverwrite,		/* Set the task's notification value to a specific value even if the previous value has not yet been read by the task. */
+	eSetValueWithoutOverwrite	/* Set the task's notification value if the previous value has been read by the task. */
+} eNotifyAction;
+
+/*
+ * Returned by eTaskConfirmSleepModeStatus().
+ */
+typedef enum
+{
+	eAbortSleep = 0,		/* Something happened since the expected idle time was computed, do not sleep. */
+	eStandardSleep			/* Sleep for no longer than the expected idle time. */
+} eSleepModeStatus;
+
 /*
  * Defines the priority used by the idle task.  This must not be modified.
  *
@@ -269,7 +363,60 @@ typedef struct xTASK_PARAMTERS
  * \defgroup xTaskCreate xTaskCreate
  * \ingroup Tasks
  */
-#define xTaskCreate( pvTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask ) xTaskGenericCreate( ( pvTaskCode ), ( pcName ), ( usStackDepth ), ( pvParameters ), ( uxPriority ), ( pxCreatedTask ), ( NULL ), ( NULL ) )
+#define xTaskCreate( pvTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask ) xTaskGenericCreate( ( pvTaskCode ), ( pcName ), ( usStackDepth ), ( pvParameters ), ( uxPriority ), ( pxCreatedTask ), ( NULL ), ( NULL ), ( NULL ) )
+
+/**
+ * task. h
+ *<pre>
+ portBASE_TYPE xTaskCreateStatic(
+							  pdTASK_CODE pvTaskCode,
+							  const char * const pcName,
+							  unsigned short usStackDepth,
+							  void *pvParameters,
+							  unsigned portBASE_TYPE uxPriority,
+							  xTaskHandle *pvCreatedTask,
+							  portSTACK_TYPE *puxStackBuffer,
+							  xStaticTask *pxTaskBuffer
+						  );</pre>
+ *
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * this macro to be available.
+ *
+ * Create a new task as xTaskCreate() does, but use the memory provided by
+ * the caller for the TCB and the stack instead of allocating it from the
+ * heap.  The buffers can be placed anywhere by the linker script (.bss,
+ * SRAM1, ...) and must remain valid for the lifetime of the task.  They are
+ * not freed when the task is deleted.
+ *
+ * @param puxStackBuffer Array of at least usStackDepth portSTACK_TYPE
+ * variables used as the task stack.
+ *
+ * @param pxTaskBuffer Variable of type xStaticTask used to hold the TCB.
+ *
+ * The other parameters are as for xTaskCreate().
+ *
+ * @return pdPASS if the task was successfully created and added to a ready
+ * list, otherwise an error code defined in the file errors. h
+ *
+ * Example usage:
+   <pre>
+ static portSTACK_TYPE xStack[ STACK_SIZE ];
+ static xStaticTask xTaskBuffer;
+
+ // Function that creates a task without using the heap.
+ void vOtherFunction( void )
+ {
+ xTaskHandle xHandle;
+
+	 xTaskCreateStatic( vTaskCode, "NAME", STACK_SIZE, NULL, tskIDLE_PRIORITY, &xHandle, xStack, &xTaskBuffer );
+ }
+   </pre>
+ * \defgroup xTaskCreateStatic xTaskCreateStatic
+ * \ingroup Tasks
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	#define xTaskCreateStatic( pvTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask, puxStackBuffer, pxTaskBuffer ) xTaskGenericCreate( ( pvTaskCode ), ( pcName ), ( usStackDepth ), ( pvParameters ), ( uxPriority ), ( pxCreatedTask ), ( puxStackBuffer ), ( NULL ), ( pxTaskBuffer ) )
+#endif
 
 /**
  * task. h
@@ -338,7 +485,7 @@ xTaskHandle xHandle;
  * \defgroup xTaskCreateRestricted xTaskCreateRestricted
  * \ingroup Tasks
  */
-#define xTaskCreateRestricted( x, pxCreatedTask ) xTaskGenericCreate( ((x)->pvTaskCode), ((x)->pcName), ((x)->usStackDepth), ((x)->pvParameters), ((x)->uxPriority), (pxCreatedTask), ((x)->puxStackBuffer), ((x)->xRegions) )
+#define xTaskCreateRestricted( x, pxCreatedTask ) xTaskGenericCreate( ((x)->pvTaskCode), ((x)->pcName), ((x)->usStackDepth), ((x)->pvParameters), ((x)->uxPriority), (pxCreatedTask), ((x)->puxStackBuffer), ((x)->xRegions), ( NULL ) )
 
 /**
  * task. h
@@ -752,6 +899,122 @@ void vTaskResume( xTaskHandle pxTaskToResume ) PRIVILEGED_FUNCTION;
  */
 portBASE_TYPE xTaskResumeFromISR( xTaskHandle pxTaskToResume ) PRIVILEGED_FUNCTION;
 
+/*-----------------------------------------------------------
+ * TASK NOTIFICATION API
+ *----------------------------------------------------------*/
+
+/**
+ * task. h
+ * <pre>portBASE_TYPE xTaskNotify( xTaskHandle xTaskToNotify, unsigned long ulValue, eNotifyAction eAction );</pre>
+ *
+ * configUSE_TASK_NOTIFICATIONS must be defined as 1 for this function to be
+ * available.
+ *
+ * Each task has a 32-bit notification value and a notification state.
+ * Sending a notification to a task updates the value as selected by eAction
+ * and unblocks the task if it is waiting in xTaskNotifyWait() or
+ * ulTaskNotifyTake().  No queue is allocated and no event list is walked,
+ * so a notification is a lighter weight replacement for a binary or counting
+ * semaphore, an event group or a single item mailbox with one receiver.
+ *
+ * @param xTaskToNotify The handle of the task being notified.
+ *
+ * @param ulValue Used to update the notification value of the task, see
+ * eAction.
+ *
+ * @param eAction eSetBits ORs ulValue into the notification value,
+ * eIncrement increments it (ulValue is not used), eSetValueWithOverwrite
+ * sets it to ulValue, eSetValueWithoutOverwrite sets it to ulValue only if
+ * the task has no pending notification, eNoAction only notifies the task.
+ *
+ * @return pdFAIL if eAction is eSetValueWithoutOverwrite and the task already
+ * had a pending notification, otherwise pdPASS.
+ *
+ * \defgroup xTaskNotify xTaskNotify
+ * \ingroup TaskNotifications
+ */
+portBASE_TYPE xTaskNotify( xTaskHandle xTaskToNotify, unsigned long ulValue, eNotifyAction eAction ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>portBASE_TYPE xTaskNotifyFromISR( xTaskHandle xTaskToNotify, unsigned long ulValue, eNotifyAction eAction, signed portBASE_TYPE *pxHigherPriorityTaskWoken );</pre>
+ *
+ * A version of xTaskNotify() that can be called from an interrupt handler.
+ *
+ * *pxHigherPriorityTaskWoken is set to pdTRUE if the notified task has a
+ * priority above the interrupted task, in which case portYIELD_FROM_ISR()
+ * should be called before the interrupt handler returns.
+ *
+ * \defgroup xTaskNotifyFromISR xTaskNotifyFromISR
+ * \ingroup TaskNotifications
+ */
+portBASE_TYPE xTaskNotifyFromISR( xTaskHandle xTaskToNotify, unsigned long ulValue, eNotifyAction eAction, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>portBASE_TYPE xTaskNotifyWait( unsigned long ulBitsToClearOnEntry, unsigned long ulBitsToClearOnExit, unsigned long *pulNotificationValue, portTickType xTicksToWait );</pre>
+ *
+ * Wait, with an optional timeout, for the calling task to receive a
+ * notification.
+ *
+ * @param ulBitsToClearOnEntry Bits cleared in the notification value before
+ * the task blocks, only if no notification is pending already.
+ *
+ * @param ulBitsToClearOnExit Bits cleared in the notification value when a
+ * notification has been received, after *pulNotificationValue is written.
+ *
+ * @param pulNotificationValue Receives the notification value.  Can be NULL.
+ *
+ * @param xTicksToWait The maximum time to block.  portMAX_DELAY blocks without
+ * a timeout if INCLUDE_vTaskSuspend is 1.
+ *
+ * @return pdTRUE if a notification was received, pdFALSE on timeout.
+ *
+ * \defgroup xTaskNotifyWait xTaskNotifyWait
+ * \ingroup TaskNotifications
+ */
+portBASE_TYPE xTaskNotifyWait( unsigned long ulBitsToClearOnEntry, unsigned long ulBitsToClearOnExit, unsigned long *pulNotificationValue, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>portBASE_TYPE xTaskNotifyGive( xTaskHandle xTaskToNotify );</pre>
+ *
+ * Increment the notification value of a task, the counterpart of
+ * ulTaskNotifyTake() when the notification value is used as a counting
+ * semaphore.
+ *
+ * \defgroup xTaskNotifyGive xTaskNotifyGive
+ * \ingroup TaskNotifications
+ */
+#define xTaskNotifyGive( xTaskToNotify ) xTaskNotify( ( xTaskToNotify ), 0, eIncrement )
+
+/**
+ * task. h
+ * <pre>void vTaskNotifyGiveFromISR( xTaskHandle xTaskToNotify, signed portBASE_TYPE *pxHigherPriorityTaskWoken );</pre>
+ *
+ * A version of xTaskNotifyGive() that can be called from an interrupt handler.
+ *
+ * \defgroup vTaskNotifyGiveFromISR vTaskNotifyGiveFromISR
+ * \ingroup TaskNotifications
+ */
+void vTaskNotifyGiveFromISR( xTaskHandle xTaskToNotify, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>unsigned long ulTaskNotifyTake( portBASE_TYPE xClearCountOnExit, portTickType xTicksToWait );</pre>
+ *
+ * Wait, with an optional timeout, for the notification value of the calling
+ * task to be non-zero, then either clear it (xClearCountOnExit is pdTRUE,
+ * binary semaphore) or decrement it (counting semaphore).
+ *
+ * @return The notification value before it was cleared or decremented, 0 on
+ * timeout.
+ *
+ * \defgroup ulTaskNotifyTake ulTaskNotifyTake
+ * \ingroup TaskNotifications
+ */
+unsigned long ulTaskNotifyTake( portBASE_TYPE xClearCountOnExit, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
 /*-----------------------------------------------------------
  * SCHEDULER CONTROL
  *----------------------------------------------------------*/
@@ -1114,6 +1377,36 @@ unsigned long ulTaskEndTrace( void ) PRIVILEGED_FUNCTION;
  */
 unsigned portBASE_TYPE uxTaskGetStackHighWaterMark( xTaskHandle xTask ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * <pre>unsigned portBASE_TYPE uxTaskGetCycleStats( xTaskCycleStats *pxStats, unsigned portBASE_TYPE uxMaxTasks );</pre>
+ *
+ * configGENERATE_CYCLE_STATS must be defined as 1 for this function to be
+ * available.
+ *
+ * Fills pxStats with the name, priority and cycle count of up to uxMaxTasks
+ * tasks, the idle task included.  The cycles of the calling task are brought
+ * up to date first.  The scheduler is suspended while the lists are walked.
+ *
+ * @return The number of entries written to pxStats.
+ */
+unsigned portBASE_TYPE uxTaskGetCycleStats( xTaskCycleStats *pxStats, unsigned portBASE_TYPE uxMaxTasks ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>unsigned portBASE_TYPE uxTaskGetStackStats( xTaskStackStats *pxStats, unsigned portBASE_TYPE uxMaxTasks );</pre>
+ *
+ * configGENERATE_STACK_STATS must be defined as 1 for this function to be
+ * available.
+ *
+ * Fills pxStats with the name, priority, stack depth and stack high water
+ * mark of up to uxMaxTasks tasks, the idle task included.  The painted stack
+ * of every task is scanned with the scheduler suspended.
+ *
+ * @return The number of entries written to pxStats.
+ */
+unsigned portBASE_TYPE uxTaskGetStackStats( xTaskStackStats *pxStats, unsigned portBASE_TYPE uxMaxTasks ) PRIVILEGED_FUNCTION;
+
 /**
  * task.h
  * <pre>void vTaskSetApplicationTaskTag( xTaskHandle xTask, pdTASK_HOOK_CODE pxHookFunction );</pre>
@@ -1201,6 +1494,42 @@ void vTaskPlaceOnEventList( const xList * const pxEventList, portTickType xTicks
  */
 signed portBASE_TYPE xTaskRemoveFromEventList( const xList * const pxEventList ) PRIVILEGED_FUNCTION;
 
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE EVENT GROUPS.
+ *
+ * THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.
+ *
+ * As vTaskPlaceOnEventList() but the event list is not kept in priority
+ * order.  The event list item of the calling task holds xItemValue, e.g. the
+ * bits it waits for, until uxTaskResetEventItemValue() is called.
+ */
+void vTaskPlaceOnUnorderedEventList( xList * pxEventList, portTickType xItemValue, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE EVENT GROUPS.
+ *
+ * THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.
+ *
+ * Readies the task that owns pxEventListItem, an item of an unordered event
+ * list, and stores xItemValue in the item for the woken task to read.
+ *
+ * @return pdTRUE if the woken task has a higher priority than the calling
+ * task.  The switch is then made when the scheduler is resumed.
+ */
+signed portBASE_TYPE xTaskRemoveFromUnorderedEventList( xListItem * pxEventListItem, portTickType xItemValue ) PRIVILEGED_FUNCTION;
+
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE EVENT GROUPS.
+ *
+ * Returns the event list item value of the calling task, as stored by
+ * xTaskRemoveFromUnorderedEventList() or vTaskPlaceOnUnorderedEventList(),
+ * and gives the item back the value used by the queues.
+ */
+portTickType uxTaskResetEventItemValue( void ) PRIVILEGED_FUNCTION;
+
 /*
  * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
  * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
@@ -1229,6 +1558,12 @@ void vTaskSwitchContext( void ) PRIVILEGED_FUNCTION;
  */
 xTaskHandle xTaskGetCurrentTaskHandle( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Return the name given to a task when it was created.  NULL can be passed
+ * to get the name of the calling task.  Safe to call from an interrupt.
+ */
+signed char *pcTaskGetTaskName( xTaskHandle xTaskToQuery ) PRIVILEGED_FUNCTION;
+
 /*
  * Capture the current time status for future reference.
  */
@@ -1246,6 +1581,31 @@ portBASE_TYPE xTaskCheckForTimeOut( xTimeOutType * const pxTimeOut, portTickType
  */
 void vTaskMissedYield( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS ONLY
+ * INTENDED FOR USE WHEN IMPLEMENTING A PORT OF THE SCHEDULER AND IS
+ * AN INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * Used by portSUPPRESS_TICKS_AND_SLEEP() when configUSE_TICKLESS_IDLE is 1.
+ * Called with the scheduler suspended after the tick interrupt was stopped,
+ * adds the ticks that elapsed while the processor slept to the tick count.
+ * xTicksToJump must not take the tick count past the expected idle time
+ * the port was given.
+ */
+void vTaskStepTick( portTickType xTicksToJump ) PRIVILEGED_FUNCTION;
+
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS ONLY
+ * INTENDED FOR USE WHEN IMPLEMENTING A PORT OF THE SCHEDULER AND IS
+ * AN INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * Used by portSUPPRESS_TICKS_AND_SLEEP() when configUSE_TICKLESS_IDLE is 1.
+ * Called with the scheduler suspended and the interrupts masked, just before
+ * the processor sleeps.  Returns eAbortSleep if a task was readied, a yield
+ * was missed or a tick was missed since the expected idle time was computed.
+ */
+eSleepModeStatus eTaskConfirmSleepModeStatus( void ) PRIVILEGED_FUNCTION;
+
 /*
  * Returns the scheduler state as taskSCHEDULER_RUNNING,
  * taskSCHEDULER_NOT_STARTED or taskSCHEDULER_SUSPENDED.
@@ -1266,9 +1626,9 @@ void vTaskPriorityDisinherit( xTaskHandle * const pxMutexHolder ) PRIVILEGED_FUN
 
 /*
  * Generic version of the task creation function which is in turn called by the
- * xTaskCreate() and xTaskCreateRestricted() macros.
+ * xTaskCreate(), xTaskCreateRestricted() and xTaskCreateStatic() macros.
  */
-signed portBASE_TYPE xTaskGenericCreate( pdTASK_CODE pvTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, unsigned portBASE_TYPE uxPriority, xTaskHandle *pxCreatedTask, portSTACK_TYPE *puxStackBuffer, const xMemoryRegion * const xRegions ) PRIVILEGED_FUNCTION;
+signed portBASE_TYPE xTaskGenericCreate( pdTASK_CODE pvTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, unsigned portBASE_TYPE uxPriority, xTaskHandle *pxCreatedTask, portSTACK_TYPE *puxStackBuffer, const xMemoryRegion * const xRegions, xStaticTask * const pxTaskBuffer ) PRIVILEGED_FUNCTION;
 
 #ifdef __cplusplus
 }
@@ -58,6 +58,10 @@
 
 #include "exception.h"
 #include "system.h"
+#include "irq.h"
+#include "cpustat.h"
+#include "hrtimer.h"
+#include "profile.h"
 
 /* Constants required to setup the initial stack. */
 
@@ -67,6 +71,29 @@
 /* Setup the TB to generate the tick interrupts. */
 static void prvSetupTimerInterrupt( void );
 
+#if configUSE_TICKLESS_IDLE == 1
+// cycles of one tick, the timer period
+static unsigned portLONG ulTimerCyclesPerTick;
+// the longest sleep the 32-bit timer can count
+static portTickType xMaximumSuppressedTicks;
+
+// waitirq returns on any pending line, the masked ones too, and a line only
+// stops pending when it is taken. once a line masked before the sleep ends
+// it, no sleep is tried again before the next tick: the idle task stays on
+// the tick path instead of sleeping and waking at once over and over
+static portBASE_TYPE xSleepBlocked = pdFALSE;
+static portTickType xSleepBlockedTick;
+
+// a tick boundary closer than this when the timer irq is moved back is
+// taken as passed, it may pass before timer_add() runs
+#define portTICKLESS_GUARD_CYCLES	512
+
+// with irq off the core drops a timer irq, so the sleep runs with irq on
+// and every line masked: an irq is latched, ends waitirq, and is taken when
+// the mask is restored
+#define portALL_IRQS_MASKED		0xffffffffUL
+#endif
+
 /*
  * Initialise the stack of a task to look exactly as if a call to
  * portSAVE_CONTEXT had been called.
@@ -100,6 +127,9 @@ portSTACK_TYPE *pxPortInitialiseStack( portSTACK_TYPE *pxTopOfStack, pdTASK_CODE
 	// the task SP for the first time
 	*(pxTopOfStack + REG_SP/4) = ( portSTACK_TYPE ) orig_pxTopOfStack;
 
+	// a full frame, A0 has to be restored
+	*(pxTopOfStack + FRAME_TYPE/4) = ( portSTACK_TYPE ) FRAME_FULL;
+
 	// return the new stack frame
 	return pxTopOfStack;
 }
@@ -114,6 +144,17 @@ portBASE_TYPE xPortStartScheduler( void )
 	here already. */
 	prvSetupTimerInterrupt();
 
+#if configGENERATE_CYCLE_STATS == 1
+	/* The cycles used before the scheduler starts are not charged to the
+	first task. */
+	cpustat_reset();
+#endif
+
+#ifdef PROFILE_ENABLE
+	/* Sample from the first task on, profile_dump() prints the histogram. */
+	profile_start();
+#endif
+
 	/* Start the first task. */
 	vPortISRStartFirstTask();
 
@@ -127,9 +168,137 @@ void vPortEndScheduler( void )
 	is nothing to return to.  */
 }
 
+#if configUSE_PORT_OPTIMISED_TASK_SELECTION == 1
+// branch-free binary search, sltu gives each step without a jump
+// returns 32 for 0, the idle task keeps the ready bitmap non-zero anyway
+unsigned portLONG ulPortCountLeadingZeros( unsigned portLONG ulBitmap )
+{
+	unsigned portLONG n, r;
+
+	n = ( ulBitmap < 0x00010000UL ) << 4;
+	ulBitmap <<= n;
+	r = n;
+	n = ( ulBitmap < 0x01000000UL ) << 3;
+	ulBitmap <<= n;
+	r += n;
+	n = ( ulBitmap < 0x10000000UL ) << 2;
+	ulBitmap <<= n;
+	r += n;
+	n = ( ulBitmap < 0x40000000UL ) << 1;
+	ulBitmap <<= n;
+	r += n;
+	n = ( ulBitmap < 0x80000000UL );
+	ulBitmap <<= n;
+	r += n;
+
+	return r + ( ulBitmap == 0 );
+}
+#endif
+
+#if configUSE_TICKLESS_IDLE == 1
+// prvIdleTask() -> portSUPPRESS_TICKS_AND_SLEEP(), scheduler suspended
+// the timer period is never changed: the next timer irq is moved
+// xExpectedIdleTime - 1 ticks later with timer_add(), and moved back to the
+// next tick boundary if another irq ends the sleep first, so the tick keeps
+// its phase and the reload value stays one tick
+void vPortSuppressTicksAndSleep( portTickType xExpectedIdleTime )
+{
+	unsigned portLONG ulMask, ulPending, ulStart, ulElapsed, ulToTick;
+	unsigned portLONG ulNextTick, ulCutBack;
+	portTickType xPassed, xCutBackTicks;
+
+	if( ( xSleepBlocked != pdFALSE ) && ( xTaskGetTickCount() == xSleepBlockedTick ) )
+		return;
+	xSleepBlocked = pdFALSE;
+
+	if( xExpectedIdleTime > xMaximumSuppressedTicks )
+		xExpectedIdleTime = xMaximumSuppressedTicks;
+
+	ulMask = __irq_mask( portALL_IRQS_MASKED );
+
+#ifdef HRTIMER_ENABLE
+	// the sleep ends at the last tick boundary before the first hrtimer,
+	// whose irq then pulls the timer in again
+	xPassed = hrtimer_idle_ticks();
+	if( xExpectedIdleTime > xPassed )
+		xExpectedIdleTime = xPassed;
+	if( xExpectedIdleTime < 2 )
+	{
+		__irq_mask( ulMask );
+		return;
+	}
+#endif
+
+	if( eTaskConfirmSleepModeStatus() == eAbortSleep )
+	{
+		__irq_mask( ulMask );
+		return;
+	}
+
+	ulStart = rdcycle();
+	ulToTick = timer_add( ( xExpectedIdleTime - 1 ) * ulTimerCyclesPerTick );
+	// the timer expired with the add, that tick irq is pending and ends
+	// the sleep at once, the next boundary is one period later
+	if( ulToTick <= 1 )
+		ulToTick += ulTimerCyclesPerTick;
+
+	// a line masked before the sleep ends it like any other irq, waiting
+	// on would spin for the whole sleep
+	ulPending = __wait_irq();
+
+	// tick boundaries passed during the sleep
+	ulElapsed = rdcycle() - ulStart;
+	if( ulElapsed < ulToTick )
+		xPassed = 0;
+	else
+		xPassed = 1 + ( ulElapsed - ulToTick ) / ulTimerCyclesPerTick;
+
+	if( xPassed >= xExpectedIdleTime )
+	{
+		// the timer ended the sleep, its pending irq counts the last tick
+		vTaskStepTick( xExpectedIdleTime - 1 );
+	}
+	else
+	{
+		xCutBackTicks = xExpectedIdleTime - 1 - xPassed;
+		if( xCutBackTicks > 0 )
+		{
+			// computed first, rdcycle() to timer_add() must stay short
+			ulCutBack = xCutBackTicks * ulTimerCyclesPerTick;
+			ulNextTick = ulToTick + xPassed * ulTimerCyclesPerTick;
+
+			if( ( signed portLONG ) ( ulNextTick - ( rdcycle() - ulStart ) ) < portTICKLESS_GUARD_CYCLES )
+			{
+				// aim at the boundary after, this one passes
+				// without an irq
+				xPassed++;
+				ulCutBack -= ulTimerCyclesPerTick;
+			}
+
+			if( ulCutBack )
+				timer_add( -( signed portLONG ) ulCutBack );
+		}
+		vTaskStepTick( xPassed );
+	}
+
+	if( ( ulPending & ~ulMask ) == 0 )
+	{
+		xSleepBlocked = pdTRUE;
+		xSleepBlockedTick = xTaskGetTickCount();
+	}
+
+	__irq_mask( ulMask );
+}
+#endif
+
 // main() -> vTaskStartScheduler() -> xPortStartScheduler() -> prvSetupTimerInterrupt()
 static void prvSetupTimerInterrupt( void )
 {
+#if configUSE_TICKLESS_IDLE == 1
+	ulTimerCyclesPerTick = configCPU_CLOCK_HZ / configTICK_RATE_HZ;
+	xMaximumSuppressedTicks = ( 0xffffffffUL / ulTimerCyclesPerTick ) - 1;
+#endif
+
 	// initialize tick timer
 	timer_enable(configCPU_CLOCK_HZ/configTICK_RATE_HZ);
 }
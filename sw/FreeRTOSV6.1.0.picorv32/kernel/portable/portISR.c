@@ -75,6 +75,12 @@ extern void vPortYieldProcessor( void );
 
 void vPortTickISR( void )
 {
+#ifdef IRQ_NESTING_ENABLE
+	unsigned portBASE_TYPE uxSavedInterruptStatus;
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+#endif
+
 	/* Increment the RTOS tick count, then look for the highest priority
 	task that is ready to run. */
 	vTaskIncrementTick();
@@ -82,8 +88,27 @@ void vPortTickISR( void )
 #if configUSE_PREEMPTION == 1
 	vTaskSwitchContext();
 #endif
+
+#ifdef IRQ_NESTING_ENABLE
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+#endif
 }
 
+#ifdef IRQ_NESTING_ENABLE
+/*
+ * pxCurrentTCB may be changed from any nesting level, the outermost irq_vec
+ * picks up the new task when the last handler returns.
+ */
+void vPortYieldFromISR( void )
+{
+unsigned portBASE_TYPE uxSavedInterruptStatus;
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	vTaskSwitchContext();
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+}
+#endif
+
 void vPortEnterCritical( void )
 {
 	/* Disable interrupts as per portDISABLE_INTERRUPTS(); */
@@ -113,7 +113,33 @@ typedef struct QueueDefinition
 	signed portBASE_TYPE xRxLock;			/*< Stores the number of items received from the queue (removed from the queue) while the queue was locked.  Set to queueUNLOCKED when the queue is not locked. */
 	signed portBASE_TYPE xTxLock;			/*< Stores the number of items transmitted to the queue (added to the queue) while the queue was locked.  Set to queueUNLOCKED when the queue is not locked. */
 
+	#if ( configUSE_QUEUE_SETS == 1 )
+		struct QueueDefinition *pxQueueSetContainer;	/*< The queue set the queue is a member of, or NULL. */
+		unsigned portBASE_TYPE uxSetMembersLength;		/*< Sum of the lengths of the members when the queue is a set. */
+	#endif
+
+	#if ( configGENERATE_LOCK_STATS == 1 )
+		unsigned long long ullTakenTime;		/*< Cycle count when the mutex was last taken. */
+		unsigned long ulTakes;					/*< Times the mutex was taken. */
+		unsigned long ulContended;				/*< Takes that found the mutex held and waited for it. */
+		unsigned long ulMaxHold;				/*< Longest time the mutex was held, in cycles. */
+		unsigned long ulMaxWait;				/*< Longest wait of a contended take, in cycles. */
+		struct QueueDefinition *pxNextMutex;	/*< Next mutex in the list walked by uxQueueGetLockStats(). */
+	#endif
+
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		unsigned char ucStaticallyAllocated;	/*< Set to pdTRUE if the memory of the queue was provided by the application, so vQueueDelete() does not free it. */
+	#endif
+
 } xQUEUE;
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	/* xStaticQueue in FreeRTOS.h must have the same size as xQUEUE.  The array
+	size is negative, and the build fails, if it does not. */
+	typedef char queueSTATIC_QUEUE_SIZE_CHECK[ ( sizeof( xStaticQueue ) == sizeof( xQUEUE ) ) ? 1 : -1 ];
+
+#endif
 /*-----------------------------------------------------------*/
 
 /*
@@ -123,6 +149,15 @@ typedef struct QueueDefinition
  */
 typedef xQUEUE * xQueueHandle;
 
+/*
+ * The item of a zero copy queue, as defined in queue.h.
+ */
+typedef struct QueueBufferDefinition
+{
+	void *pvData;
+	size_t xLength;
+} xQueueBuffer;
+
 /*
  * Prototypes for public functions are included here so we don't have to
  * include the API header file (as it defines xQueueHandle differently).  These
@@ -137,6 +172,13 @@ signed portBASE_TYPE xQueueGenericReceive( xQueueHandle pxQueue, void * const pv
 signed portBASE_TYPE xQueueReceiveFromISR( xQueueHandle pxQueue, void * const pvBuffer, signed portBASE_TYPE *pxTaskWoken ) PRIVILEGED_FUNCTION;
 xQueueHandle xQueueCreateMutex( void ) PRIVILEGED_FUNCTION;
 xQueueHandle xQueueCreateCountingSemaphore( unsigned portBASE_TYPE uxCountValue, unsigned portBASE_TYPE uxInitialCount ) PRIVILEGED_FUNCTION;
+xQueueHandle xQueueCreateStatic( unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize, unsigned char *pucQueueStorage, xStaticQueue *pxStaticQueue ) PRIVILEGED_FUNCTION;
+xQueueHandle xQueueCreateMutexStatic( xStaticQueue *pxStaticQueue ) PRIVILEGED_FUNCTION;
+xQueueHandle xQueueCreateSemaphoreStatic( unsigned portBASE_TYPE uxCountValue, unsigned portBASE_TYPE uxInitialCount, xStaticQueue *pxStaticQueue ) PRIVILEGED_FUNCTION;
+signed portBASE_TYPE xQueueSendBuffer( xQueueHandle xQueue, void *pvData, size_t xLength, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+signed portBASE_TYPE xQueueReceiveBuffer( xQueueHandle xQueue, void **ppvData, size_t *pxLength, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+signed portBASE_TYPE xQueueSendBufferFromISR( xQueueHandle xQueue, void *pvData, size_t xLength, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+signed portBASE_TYPE xQueueReceiveBufferFromISR( xQueueHandle xQueue, void **ppvData, size_t *pxLength, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 portBASE_TYPE xQueueTakeMutexRecursive( xQueueHandle xMutex, portTickType xBlockTime ) PRIVILEGED_FUNCTION;
 portBASE_TYPE xQueueGiveMutexRecursive( xQueueHandle xMutex ) PRIVILEGED_FUNCTION;
 signed portBASE_TYPE xQueueAltGenericSend( xQueueHandle pxQueue, const void * const pvItemToQueue, portTickType xTicksToWait, portBASE_TYPE xCopyPosition ) PRIVILEGED_FUNCTION;
@@ -144,6 +186,16 @@ signed portBASE_TYPE xQueueAltGenericReceive( xQueueHandle pxQueue, void * const
 signed portBASE_TYPE xQueueIsQueueEmptyFromISR( const xQueueHandle pxQueue ) PRIVILEGED_FUNCTION;
 signed portBASE_TYPE xQueueIsQueueFullFromISR( const xQueueHandle pxQueue ) PRIVILEGED_FUNCTION;
 unsigned portBASE_TYPE uxQueueMessagesWaitingFromISR( const xQueueHandle pxQueue ) PRIVILEGED_FUNCTION;
+#if ( configUSE_QUEUE_SETS == 1 )
+	xQueueHandle xQueueCreateSet( unsigned portBASE_TYPE uxEventQueueLength ) PRIVILEGED_FUNCTION;
+	portBASE_TYPE xQueueAddToSet( xQueueHandle xQueueOrSemaphore, xQueueHandle xQueueSet ) PRIVILEGED_FUNCTION;
+	portBASE_TYPE xQueueRemoveFromSet( xQueueHandle xQueueOrSemaphore, xQueueHandle xQueueSet ) PRIVILEGED_FUNCTION;
+	xQueueHandle xQueueSelectFromSet( xQueueHandle xQueueSet, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+	xQueueHandle xQueueSelectFromSetFromISR( xQueueHandle xQueueSet ) PRIVILEGED_FUNCTION;
+#endif
+#if ( configGENERATE_LOCK_STATS == 1 )
+	unsigned portBASE_TYPE uxQueueGetLockStats( xQueueLockStats *pxStats, unsigned portBASE_TYPE uxMaxLocks ) PRIVILEGED_FUNCTION;
+#endif
 
 /*
  * Co-routine queue functions differ from task queue functions.  Co-routines are
@@ -216,6 +268,45 @@ static void prvCopyDataToQueue( xQUEUE *pxQueue, const void *pvItemToQueue, port
  * Copies an item out of a queue.
  */
 static void prvCopyDataFromQueue( xQUEUE * const pxQueue, const void *pvBuffer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Sets the members of a newly created queue, whose pcHead already points to
+ * the storage area, to describe an empty queue.
+ */
+static void prvInitialiseNewQueue( xQUEUE *pxNewQueue, unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize ) PRIVILEGED_FUNCTION;
+
+/*
+ * Sets the members of a newly created queue to describe a mutex that is
+ * available.
+ */
+#if ( configUSE_MUTEXES == 1 )
+	static void prvInitialiseMutex( xQUEUE *pxNewQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * Posts the handle of pxQueue to the queue set pxQueue is a member of, in
+ * place of waking a task blocked on pxQueue itself.  Must be called from a
+ * critical section.
+ *
+ * @return pdTRUE if a task blocked on the set was woken and has a priority
+ * higher than the calling task, otherwise pdFALSE.
+ */
+#if ( configUSE_QUEUE_SETS == 1 )
+	static signed portBASE_TYPE prvNotifyQueueSetContainer( xQUEUE *pxQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * Update the stats of a mutex when it is taken, ullWaitStart is the cycle
+ * count when the taker found it held or 0 if it did not, and when it is
+ * given back.  Must be called from a critical section.
+ */
+#if ( configGENERATE_LOCK_STATS == 1 )
+	static void prvLockStatsTaken( xQUEUE *pxQueue, unsigned long long ullWaitStart ) PRIVILEGED_FUNCTION;
+	static void prvLockStatsGiven( xQUEUE *pxQueue ) PRIVILEGED_FUNCTION;
+
+	/* The mutexes, most recently created first. */
+	static xQUEUE *pxLockStatsList = NULL;
+#endif
 /*-----------------------------------------------------------*/
 
 /*
@@ -262,20 +353,13 @@ size_t xQueueSizeInBytes;
 			pxNewQueue->pcHead = ( signed char * ) pvPortMalloc( xQueueSizeInBytes );
 			if( pxNewQueue->pcHead != NULL )
 			{
-				/* Initialise the queue members as described above where the
-				queue type is defined. */
-				pxNewQueue->pcTail = pxNewQueue->pcHead + ( uxQueueLength * uxItemSize );
-				pxNewQueue->uxMessagesWaiting = 0;
-				pxNewQueue->pcWriteTo = pxNewQueue->pcHead;
-				pxNewQueue->pcReadFrom = pxNewQueue->pcHead + ( ( uxQueueLength - 1 ) * uxItemSize );
-				pxNewQueue->uxLength = uxQueueLength;
-				pxNewQueue->uxItemSize = uxItemSize;
-				pxNewQueue->xRxLock = queueUNLOCKED;
-				pxNewQueue->xTxLock = queueUNLOCKED;
-
-				/* Likewise ensure the event queues start with the correct state. */
-				vListInitialise( &( pxNewQueue->xTasksWaitingToSend ) );
-				vListInitialise( &( pxNewQueue->xTasksWaitingToReceive ) );
+				prvInitialiseNewQueue( pxNewQueue, uxQueueLength, uxItemSize );
+
+				#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+				{
+					pxNewQueue->ucStaticallyAllocated = pdFALSE;
+				}
+				#endif
 
 				traceQUEUE_CREATE( pxNewQueue );
 				return  pxNewQueue;
@@ -294,6 +378,95 @@ size_t xQueueSizeInBytes;
 }
 /*-----------------------------------------------------------*/
 
+static void prvInitialiseNewQueue( xQUEUE *pxNewQueue, unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize )
+{
+	/* Initialise the queue members as described above where the queue type
+	is defined. */
+	pxNewQueue->pcTail = pxNewQueue->pcHead + ( uxQueueLength * uxItemSize );
+	pxNewQueue->uxMessagesWaiting = 0;
+	pxNewQueue->pcWriteTo = pxNewQueue->pcHead;
+	pxNewQueue->pcReadFrom = pxNewQueue->pcHead + ( ( uxQueueLength - 1 ) * uxItemSize );
+	pxNewQueue->uxLength = uxQueueLength;
+	pxNewQueue->uxItemSize = uxItemSize;
+	pxNewQueue->xRxLock = queueUNLOCKED;
+	pxNewQueue->xTxLock = queueUNLOCKED;
+
+	#if ( configUSE_QUEUE_SETS == 1 )
+	{
+		pxNewQueue->pxQueueSetContainer = NULL;
+		pxNewQueue->uxSetMembersLength = 0;
+	}
+	#endif
+
+	/* Likewise ensure the event queues start with the correct state. */
+	vListInitialise( &( pxNewQueue->xTasksWaitingToSend ) );
+	vListInitialise( &( pxNewQueue->xTasksWaitingToReceive ) );
+}
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	xQueueHandle xQueueCreateStatic( unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize, unsigned char *pucQueueStorage, xStaticQueue *pxStaticQueue )
+	{
+	xQUEUE *pxNewQueue;
+
+		/* The storage must be provided unless nothing is copied into the
+		queue. */
+		if( ( uxQueueLength == ( unsigned portBASE_TYPE ) 0 ) || ( pxStaticQueue == NULL ) || ( ( pucQueueStorage == NULL ) && ( uxItemSize != ( unsigned portBASE_TYPE ) 0 ) ) )
+		{
+			traceQUEUE_CREATE_FAILED();
+			return NULL;
+		}
+
+		pxNewQueue = ( xQUEUE * ) pxStaticQueue;
+
+		if( pucQueueStorage != NULL )
+		{
+			pxNewQueue->pcHead = ( signed char * ) pucQueueStorage;
+		}
+		else
+		{
+			/* pcHead must not be NULL as that marks a mutex, point it at the
+			queue structure itself as it is never dereferenced. */
+			pxNewQueue->pcHead = ( signed char * ) pxNewQueue;
+		}
+
+		prvInitialiseNewQueue( pxNewQueue, uxQueueLength, uxItemSize );
+		pxNewQueue->ucStaticallyAllocated = pdTRUE;
+
+		traceQUEUE_CREATE( pxNewQueue );
+
+		return pxNewQueue;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	xQueueHandle xQueueCreateSemaphoreStatic( unsigned portBASE_TYPE uxCountValue, unsigned portBASE_TYPE uxInitialCount, xStaticQueue *pxStaticQueue )
+	{
+	xQueueHandle pxHandle;
+
+		pxHandle = xQueueCreateStatic( uxCountValue, queueSEMAPHORE_QUEUE_ITEM_LENGTH, NULL, pxStaticQueue );
+
+		if( pxHandle != NULL )
+		{
+			pxHandle->uxMessagesWaiting = uxInitialCount;
+
+			traceCREATE_COUNTING_SEMAPHORE();
+		}
+		else
+		{
+			traceCREATE_COUNTING_SEMAPHORE_FAILED();
+		}
+
+		return pxHandle;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_MUTEXES == 1 )
 
 	xQueueHandle xQueueCreateMutex( void )
@@ -304,30 +477,13 @@ size_t xQueueSizeInBytes;
 		pxNewQueue = ( xQUEUE * ) pvPortMalloc( sizeof( xQUEUE ) );
 		if( pxNewQueue != NULL )
 		{
-			/* Information required for priority inheritance. */
-			pxNewQueue->pxMutexHolder = NULL;
-			pxNewQueue->uxQueueType = queueQUEUE_IS_MUTEX;
-
-			/* Queues used as a mutex no data is actually copied into or out
-			of the queue. */
-			pxNewQueue->pcWriteTo = NULL;
-			pxNewQueue->pcReadFrom = NULL;
-
-			/* Each mutex has a length of 1 (like a binary semaphore) and
-			an item size of 0 as nothing is actually copied into or out
-			of the mutex. */
-			pxNewQueue->uxMessagesWaiting = 0;
-			pxNewQueue->uxLength = 1;
-			pxNewQueue->uxItemSize = 0;
-			pxNewQueue->xRxLock = queueUNLOCKED;
-			pxNewQueue->xTxLock = queueUNLOCKED;
-
-			/* Ensure the event queues start with the correct state. */
-			vListInitialise( &( pxNewQueue->xTasksWaitingToSend ) );
-			vListInitialise( &( pxNewQueue->xTasksWaitingToReceive ) );
-
-			/* Start with the semaphore in the expected state. */
-			xQueueGenericSend( pxNewQueue, NULL, 0, queueSEND_TO_BACK );
+			#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+				pxNewQueue->ucStaticallyAllocated = pdFALSE;
+			}
+			#endif
+
+			prvInitialiseMutex( pxNewQueue );
 
 			traceCREATE_MUTEX( pxNewQueue );
 		}
@@ -342,6 +498,89 @@ size_t xQueueSizeInBytes;
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( ( configUSE_MUTEXES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+	xQueueHandle xQueueCreateMutexStatic( xStaticQueue *pxStaticQueue )
+	{
+	xQUEUE *pxNewQueue;
+
+		pxNewQueue = ( xQUEUE * ) pxStaticQueue;
+		if( pxNewQueue != NULL )
+		{
+			pxNewQueue->ucStaticallyAllocated = pdTRUE;
+
+			prvInitialiseMutex( pxNewQueue );
+
+			traceCREATE_MUTEX( pxNewQueue );
+		}
+		else
+		{
+			traceCREATE_MUTEX_FAILED();
+		}
+
+		return pxNewQueue;
+	}
+
+#endif /* configUSE_MUTEXES && configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+	static void prvInitialiseMutex( xQUEUE *pxNewQueue )
+	{
+		/* Information required for priority inheritance. */
+		pxNewQueue->pxMutexHolder = NULL;
+		pxNewQueue->uxQueueType = queueQUEUE_IS_MUTEX;
+
+		/* Queues used as a mutex no data is actually copied into or out
+		of the queue. */
+		pxNewQueue->pcWriteTo = NULL;
+		pxNewQueue->pcReadFrom = NULL;
+
+		/* Each mutex has a length of 1 (like a binary semaphore) and
+		an item size of 0 as nothing is actually copied into or out
+		of the mutex. */
+		pxNewQueue->uxMessagesWaiting = 0;
+		pxNewQueue->uxLength = 1;
+		pxNewQueue->uxItemSize = 0;
+		pxNewQueue->xRxLock = queueUNLOCKED;
+		pxNewQueue->xTxLock = queueUNLOCKED;
+
+		#if ( configUSE_QUEUE_SETS == 1 )
+		{
+			pxNewQueue->pxQueueSetContainer = NULL;
+			pxNewQueue->uxSetMembersLength = 0;
+		}
+		#endif
+
+		#if ( configGENERATE_LOCK_STATS == 1 )
+		{
+			pxNewQueue->ullTakenTime = 0ULL;
+			pxNewQueue->ulTakes = 0UL;
+			pxNewQueue->ulContended = 0UL;
+			pxNewQueue->ulMaxHold = 0UL;
+			pxNewQueue->ulMaxWait = 0UL;
+
+			taskENTER_CRITICAL();
+			{
+				pxNewQueue->pxNextMutex = pxLockStatsList;
+				pxLockStatsList = pxNewQueue;
+			}
+			taskEXIT_CRITICAL();
+		}
+		#endif
+
+		/* Ensure the event queues start with the correct state. */
+		vListInitialise( &( pxNewQueue->xTasksWaitingToSend ) );
+		vListInitialise( &( pxNewQueue->xTasksWaitingToReceive ) );
+
+		/* Start with the semaphore in the expected state. */
+		xQueueGenericSend( pxNewQueue, NULL, 0, queueSEND_TO_BACK );
+	}
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
 #if configUSE_RECURSIVE_MUTEXES == 1
 
 	portBASE_TYPE xQueueGiveMutexRecursive( xQueueHandle pxMutex )
@@ -467,6 +706,23 @@ xTimeOutType xTimeOut;
 				traceQUEUE_SEND( pxQueue );
 				prvCopyDataToQueue( pxQueue, pvItemToQueue, xCopyPosition );
 
+				#if ( configUSE_QUEUE_SETS == 1 )
+				{
+					/* A member of a set wakes the tasks blocked on the set,
+					no task blocks on the member itself. */
+					if( pxQueue->pxQueueSetContainer != NULL )
+					{
+						if( prvNotifyQueueSetContainer( pxQueue ) == pdTRUE )
+						{
+							portYIELD_WITHIN_API();
+						}
+
+						taskEXIT_CRITICAL();
+						return pdPASS;
+					}
+				}
+				#endif
+
 				/* If there was a task waiting for data to arrive on the
 				queue then unblock it now. */
 				if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
@@ -645,6 +901,9 @@ xTimeOutType xTimeOut;
 	signed portBASE_TYPE xEntryTimeSet = pdFALSE;
 	xTimeOutType xTimeOut;
 	signed char *pcOriginalReadPosition;
+	#if ( configGENERATE_LOCK_STATS == 1 )
+		unsigned long long ullWaitStart = 0ULL;
+	#endif
 
 		for( ;; )
 		{
@@ -671,6 +930,12 @@ xTimeOutType xTimeOut;
 								/* Record the information required to implement
 								priority inheritance should it become necessary. */
 								pxQueue->pxMutexHolder = xTaskGetCurrentTaskHandle();
+
+								#if ( configGENERATE_LOCK_STATS == 1 )
+								{
+									prvLockStatsTaken( pxQueue, ullWaitStart );
+								}
+								#endif
 							}
 						}
 						#endif
@@ -721,6 +986,12 @@ xTimeOutType xTimeOut;
 					{
 						vTaskSetTimeOutState( &xTimeOut );
 						xEntryTimeSet = pdTRUE;
+
+						#if ( configGENERATE_LOCK_STATS == 1 )
+						{
+							ullWaitStart = portGET_LOCK_CYCLES();
+						}
+						#endif
 					}
 				}
 			}
@@ -786,6 +1057,16 @@ unsigned portBASE_TYPE uxSavedInterruptStatus;
 			be done when the queue is unlocked later. */
 			if( pxQueue->xTxLock == queueUNLOCKED )
 			{
+				#if ( configUSE_QUEUE_SETS == 1 )
+				if( pxQueue->pxQueueSetContainer != NULL )
+				{
+					if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+					{
+						*pxHigherPriorityTaskWoken = pdTRUE;
+					}
+				}
+				else
+				#endif
 				if( !listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) )
 				{
 					if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
@@ -822,6 +1103,9 @@ signed portBASE_TYPE xQueueGenericReceive( xQueueHandle pxQueue, void * const pv
 signed portBASE_TYPE xEntryTimeSet = pdFALSE;
 xTimeOutType xTimeOut;
 signed char *pcOriginalReadPosition;
+#if ( configGENERATE_LOCK_STATS == 1 )
+	unsigned long long ullWaitStart = 0ULL;
+#endif
 
 	/* This function relaxes the coding standard somewhat to allow return
 	statements within the function itself.  This is done in the interest
@@ -854,6 +1138,12 @@ signed char *pcOriginalReadPosition;
 							/* Record the information required to implement
 							priority inheritance should it become necessary. */
 							pxQueue->pxMutexHolder = xTaskGetCurrentTaskHandle();
+
+							#if ( configGENERATE_LOCK_STATS == 1 )
+							{
+								prvLockStatsTaken( pxQueue, ullWaitStart );
+							}
+							#endif
 						}
 					}
 					#endif
@@ -908,6 +1198,13 @@ signed char *pcOriginalReadPosition;
 					configure the timeout structure. */
 					vTaskSetTimeOutState( &xTimeOut );
 					xEntryTimeSet = pdTRUE;
+
+					#if ( configGENERATE_LOCK_STATS == 1 )
+					{
+						/* Only used if the queue is a mutex. */
+						ullWaitStart = portGET_LOCK_CYCLES();
+					}
+					#endif
 				}
 			}
 		}
@@ -1041,11 +1338,104 @@ void vQueueDelete( xQueueHandle pxQueue )
 {
 	traceQUEUE_DELETE( pxQueue );
 	vQueueUnregisterQueue( pxQueue );
+
+	#if ( configGENERATE_LOCK_STATS == 1 )
+	{
+	xQUEUE **ppxMutex;
+
+		if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+		{
+			taskENTER_CRITICAL();
+			{
+				for( ppxMutex = &pxLockStatsList; *ppxMutex != NULL; ppxMutex = &( ( *ppxMutex )->pxNextMutex ) )
+				{
+					if( *ppxMutex == pxQueue )
+					{
+						*ppxMutex = pxQueue->pxNextMutex;
+						break;
+					}
+				}
+			}
+			taskEXIT_CRITICAL();
+		}
+	}
+	#endif
+
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	{
+		/* Memory provided by the application is left alone. */
+		if( pxQueue->ucStaticallyAllocated != pdFALSE )
+		{
+			return;
+		}
+	}
+	#endif
+
 	vPortFree( pxQueue->pcHead );
 	vPortFree( pxQueue );
 }
 /*-----------------------------------------------------------*/
 
+signed portBASE_TYPE xQueueSendBuffer( xQueueHandle xQueue, void *pvData, size_t xLength, portTickType xTicksToWait )
+{
+xQueueBuffer xBuffer;
+
+	xBuffer.pvData = pvData;
+	xBuffer.xLength = xLength;
+
+	return xQueueGenericSend( xQueue, &xBuffer, xTicksToWait, queueSEND_TO_BACK );
+}
+/*-----------------------------------------------------------*/
+
+signed portBASE_TYPE xQueueReceiveBuffer( xQueueHandle xQueue, void **ppvData, size_t *pxLength, portTickType xTicksToWait )
+{
+xQueueBuffer xBuffer;
+signed portBASE_TYPE xReturn;
+
+	xReturn = xQueueGenericReceive( xQueue, &xBuffer, xTicksToWait, pdFALSE );
+	if( xReturn == pdPASS )
+	{
+		*ppvData = xBuffer.pvData;
+		if( pxLength != NULL )
+		{
+			*pxLength = xBuffer.xLength;
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+signed portBASE_TYPE xQueueSendBufferFromISR( xQueueHandle xQueue, void *pvData, size_t xLength, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+xQueueBuffer xBuffer;
+
+	xBuffer.pvData = pvData;
+	xBuffer.xLength = xLength;
+
+	return xQueueGenericSendFromISR( xQueue, &xBuffer, pxHigherPriorityTaskWoken, queueSEND_TO_BACK );
+}
+/*-----------------------------------------------------------*/
+
+signed portBASE_TYPE xQueueReceiveBufferFromISR( xQueueHandle xQueue, void **ppvData, size_t *pxLength, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+xQueueBuffer xBuffer;
+signed portBASE_TYPE xReturn;
+
+	xReturn = xQueueReceiveFromISR( xQueue, &xBuffer, pxHigherPriorityTaskWoken );
+	if( xReturn == pdPASS )
+	{
+		*ppvData = xBuffer.pvData;
+		if( pxLength != NULL )
+		{
+			*pxLength = xBuffer.xLength;
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
 static void prvCopyDataToQueue( xQUEUE *pxQueue, const void *pvItemToQueue, portBASE_TYPE xPosition )
 {
 	if( pxQueue->uxItemSize == ( unsigned portBASE_TYPE ) 0 )
@@ -1055,6 +1445,11 @@ static void prvCopyDataToQueue( xQUEUE *pxQueue, const void *pvItemToQueue, port
 			if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
 			{
 				/* The mutex is no longer being held. */
+				#if ( configGENERATE_LOCK_STATS == 1 )
+				{
+					prvLockStatsGiven( pxQueue );
+				}
+				#endif
 				vTaskPriorityDisinherit( ( void * ) pxQueue->pxMutexHolder );
 				pxQueue->pxMutexHolder = NULL;
 			}
@@ -1111,6 +1506,22 @@ static void prvUnlockQueue( xQueueHandle pxQueue )
 		/* See if data was added to the queue while it was locked. */
 		while( pxQueue->xTxLock > queueLOCKED_UNMODIFIED )
 		{
+			#if ( configUSE_QUEUE_SETS == 1 )
+			{
+				/* The set is told once per item posted while locked. */
+				if( pxQueue->pxQueueSetContainer != NULL )
+				{
+					if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+					{
+						vTaskMissedYield();
+					}
+
+					--( pxQueue->xTxLock );
+					continue;
+				}
+			}
+			#endif
+
 			/* Data was posted while the queue was locked.  Are any tasks
 			blocked waiting for data to become available? */
 			if( !listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) )
@@ -1206,6 +1617,160 @@ signed portBASE_TYPE xReturn;
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_QUEUE_SETS == 1 )
+
+	xQueueHandle xQueueCreateSet( unsigned portBASE_TYPE uxEventQueueLength )
+	{
+	xQueueHandle pxQueue;
+
+		/* A set is a queue of the handles of its members that received an
+		item, one handle per item. */
+		pxQueue = xQueueCreate( uxEventQueueLength, sizeof( xQUEUE * ) );
+
+		return pxQueue;
+	}
+
+#endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SETS == 1 )
+
+	portBASE_TYPE xQueueAddToSet( xQueueHandle xQueueOrSemaphore, xQueueHandle xQueueSet )
+	{
+	portBASE_TYPE xReturn;
+	portBASE_TYPE xFits;
+
+		taskENTER_CRITICAL();
+		{
+			/* Every item queued to a member puts its handle in the set, the
+			set must hold the items of all its members or a send to a member
+			would succeed without the set being told. */
+			xFits = ( xQueueSet->uxLength - xQueueSet->uxSetMembersLength >= xQueueOrSemaphore->uxLength );
+			configASSERT( xFits );
+
+			/* A queue can only be in one set.  It must be empty as the set
+			would not know about the items already queued, and it must not be
+			a mutex as a give restores the priority of the holder before the
+			set is told. */
+			if( ( xFits == pdFALSE ) || ( xQueueOrSemaphore->pxQueueSetContainer != NULL ) || ( xQueueOrSemaphore->uxMessagesWaiting != ( unsigned portBASE_TYPE ) 0 ) || ( xQueueOrSemaphore->uxQueueType == queueQUEUE_IS_MUTEX ) )
+			{
+				xReturn = pdFAIL;
+			}
+			else
+			{
+				xQueueOrSemaphore->pxQueueSetContainer = xQueueSet;
+				xQueueSet->uxSetMembersLength += xQueueOrSemaphore->uxLength;
+				xReturn = pdPASS;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+#endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SETS == 1 )
+
+	portBASE_TYPE xQueueRemoveFromSet( xQueueHandle xQueueOrSemaphore, xQueueHandle xQueueSet )
+	{
+	portBASE_TYPE xReturn;
+
+		taskENTER_CRITICAL();
+		{
+			/* The set may still hold the handle of a queue that is not empty,
+			it can only be removed once it has been drained. */
+			if( ( xQueueOrSemaphore->pxQueueSetContainer != xQueueSet ) || ( xQueueOrSemaphore->uxMessagesWaiting != ( unsigned portBASE_TYPE ) 0 ) )
+			{
+				xReturn = pdFAIL;
+			}
+			else
+			{
+				xQueueOrSemaphore->pxQueueSetContainer = NULL;
+				xQueueSet->uxSetMembersLength -= xQueueOrSemaphore->uxLength;
+				xReturn = pdPASS;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+#endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SETS == 1 )
+
+	xQueueHandle xQueueSelectFromSet( xQueueHandle xQueueSet, portTickType xTicksToWait )
+	{
+	xQueueHandle xReturn = NULL;
+
+		/* The oldest handle in the set is the member to read from next. */
+		( void ) xQueueGenericReceive( xQueueSet, &xReturn, xTicksToWait, pdFALSE );
+
+		return xReturn;
+	}
+
+#endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SETS == 1 )
+
+	xQueueHandle xQueueSelectFromSetFromISR( xQueueHandle xQueueSet )
+	{
+	xQueueHandle xReturn = NULL;
+	signed portBASE_TYPE xTaskWoken = pdFALSE;
+
+		/* No task blocks to send to a set, nothing can be woken. */
+		( void ) xQueueReceiveFromISR( xQueueSet, &xReturn, &xTaskWoken );
+
+		return xReturn;
+	}
+
+#endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SETS == 1 )
+
+	static signed portBASE_TYPE prvNotifyQueueSetContainer( xQUEUE *pxQueue )
+	{
+	xQUEUE *pxQueueSetContainer = pxQueue->pxQueueSetContainer;
+	signed portBASE_TYPE xReturn = pdFALSE;
+
+		/* xQueueAddToSet() keeps the total length of the members within the
+		length of the set, which cannot be full here. */
+		if( pxQueueSetContainer->uxMessagesWaiting < pxQueueSetContainer->uxLength )
+		{
+			traceQUEUE_SEND( pxQueueSetContainer );
+			prvCopyDataToQueue( pxQueueSetContainer, &pxQueue, queueSEND_TO_BACK );
+
+			if( pxQueueSetContainer->xTxLock == queueUNLOCKED )
+			{
+				if( listLIST_IS_EMPTY( &( pxQueueSetContainer->xTasksWaitingToReceive ) ) == pdFALSE )
+				{
+					if( xTaskRemoveFromEventList( &( pxQueueSetContainer->xTasksWaitingToReceive ) ) != pdFALSE )
+					{
+						xReturn = pdTRUE;
+					}
+				}
+			}
+			else
+			{
+				/* The task that unlocks the set wakes the receiver. */
+				++( pxQueueSetContainer->xTxLock );
+			}
+		}
+		else
+		{
+			traceQUEUE_SEND_FAILED( pxQueueSetContainer );
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
 #if configUSE_CO_ROUTINES == 1
 signed portBASE_TYPE xQueueCRSend( xQueueHandle pxQueue, const void *pvItemToQueue, portTickType xTicksToWait )
 {
@@ -1463,3 +2028,96 @@ signed portBASE_TYPE xReturn;
 
 #endif
 
+/*-----------------------------------------------------------*/
+
+#if ( configGENERATE_LOCK_STATS == 1 )
+
+	static void prvLockStatsMax( unsigned long *pulMax, unsigned long long ullCycles )
+	{
+		if( ullCycles > 0xffffffffULL )
+		{
+			ullCycles = 0xffffffffULL;
+		}
+
+		if( ( unsigned long ) ullCycles > *pulMax )
+		{
+			*pulMax = ( unsigned long ) ullCycles;
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvLockStatsTaken( xQUEUE *pxQueue, unsigned long long ullWaitStart )
+	{
+	unsigned long long ullNow = portGET_LOCK_CYCLES();
+
+		pxQueue->ullTakenTime = ullNow;
+		( pxQueue->ulTakes )++;
+
+		if( ullWaitStart != 0ULL )
+		{
+			( pxQueue->ulContended )++;
+			prvLockStatsMax( &( pxQueue->ulMaxWait ), ullNow - ullWaitStart );
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvLockStatsGiven( xQUEUE *pxQueue )
+	{
+		/* The give made by prvInitialiseMutex() has no holder. */
+		if( pxQueue->pxMutexHolder != NULL )
+		{
+			prvLockStatsMax( &( pxQueue->ulMaxHold ), portGET_LOCK_CYCLES() - pxQueue->ullTakenTime );
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	unsigned portBASE_TYPE uxQueueGetLockStats( xQueueLockStats *pxStats, unsigned portBASE_TYPE uxMaxLocks )
+	{
+	unsigned portBASE_TYPE uxLocks = 0;
+	xQUEUE *pxMutex;
+	#if configQUEUE_REGISTRY_SIZE > 0
+		unsigned portBASE_TYPE ux;
+	#endif
+
+		/* The list only changes when a mutex is created or deleted, the stats
+		of every mutex are copied in a critical section so they are consistent
+		with each other. */
+		vTaskSuspendAll();
+		{
+			for( pxMutex = pxLockStatsList; ( pxMutex != NULL ) && ( uxLocks < uxMaxLocks ); pxMutex = pxMutex->pxNextMutex )
+			{
+				pxStats[ uxLocks ].xHandle = ( void * ) pxMutex;
+				pxStats[ uxLocks ].pcName = NULL;
+
+				#if configQUEUE_REGISTRY_SIZE > 0
+				{
+					for( ux = 0; ux < configQUEUE_REGISTRY_SIZE; ux++ )
+					{
+						if( ( xQueueRegistry[ ux ].xHandle == pxMutex ) && ( xQueueRegistry[ ux ].pcQueueName != NULL ) )
+						{
+							pxStats[ uxLocks ].pcName = xQueueRegistry[ ux ].pcQueueName;
+							break;
+						}
+					}
+				}
+				#endif
+
+				taskENTER_CRITICAL();
+				{
+					pxStats[ uxLocks ].ulTakes = pxMutex->ulTakes;
+					pxStats[ uxLocks ].ulContended = pxMutex->ulContended;
+					pxStats[ uxLocks ].ulMaxHold = pxMutex->ulMaxHold;
+					pxStats[ uxLocks ].ulMaxWait = pxMutex->ulMaxWait;
+				}
+				taskEXIT_CRITICAL();
+
+				uxLocks++;
+			}
+		}
+		( void ) xTaskResumeAll();
+
+		return uxLocks;
+	}
+
+#endif /* configGENERATE_LOCK_STATS */
+
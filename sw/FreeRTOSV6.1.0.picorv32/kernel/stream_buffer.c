@@ -0,0 +1,683 @@
+/*
+    FreeRTOS V6.1.0 - Copyright (C) 2010 Real Time Engineers Ltd.
+
+    ***************************************************************************
+    *                                                                         *
+    * If you are:                                                             *
+    *                                                                         *
+    *    + New to FreeRTOS,                                                   *
+    *    + Wanting to learn FreeRTOS or multitasking in general quickly       *
+    *    + Looking for basic training,                                        *
+    *    + Wanting to improve your FreeRTOS skills and productivity           *
+    *                                                                         *
+    * then take a look at the FreeRTOS books - available as PDF or paperback  *
+    *                                                                         *
+    *        "Using the FreeRTOS Real Time Kernel - a Practical Guide"        *
+    *                  http://www.FreeRTOS.org/Documentation                  *
+    *                                                                         *
+    * A pdf reference manual is also available.  Both are usually delivered   *
+    * to your inbox within 20 minutes to two hours when purchased between 8am *
+    * and 8pm GMT (although please allow up to 24 hours in case of            *
+    * exceptional circumstances).  Thank you for your support!                *
+    *                                                                         *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    ***NOTE*** The exception to the GPL is included to allow you to distribute
+    a combined work that includes FreeRTOS without being obliged to provide the
+    source code for proprietary components outside of the FreeRTOS kernel.
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public 
+    License and the FreeRTOS license exception along with FreeRTOS; if not it 
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained 
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+
+/*
+ * Stream and message buffers.  A single writer and a single reader share a
+ * circular byte buffer.  The writer only moves xHead and the reader only
+ * moves xTail, so the data is copied without a critical section.  A critical
+ * section is only entered to block on or wake from one of the two event lists
+ * of the buffer, as the alternative queue API does.  The task notification
+ * value of the tasks is left alone.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stream_buffer.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* Bits of ucFlags. */
+#define sbFLAGS_IS_MESSAGE_BUFFER		( ( unsigned char ) 1 )
+#define sbFLAGS_IS_STATICALLY_ALLOCATED	( ( unsigned char ) 2 )
+
+/* The bytes must be in the buffer before the index that makes them visible to
+the other side is moved, and out of it before the index that frees them is
+moved. */
+#define sbMEMORY_BARRIER()				mb()
+
+/*
+ * Definition of the buffer.  It holds xLength - 1 bytes at most, one byte is
+ * kept free so a full buffer can be told from an empty one without a count
+ * that both sides would have to update.
+ */
+typedef struct StreamBufferDefinition
+{
+	volatile size_t xTail;						/*< Next byte to read.  Only written by the reader. */
+	volatile size_t xHead;						/*< Next byte to write.  Only written by the writer. */
+	size_t xLength;								/*< The size of pucBuffer. */
+	size_t xTriggerLevelBytes;					/*< The number of bytes that wakes a blocked reader. */
+	xList xTasksWaitingToSend;					/*< The writer, while it is blocked on a full buffer. */
+	xList xTasksWaitingToReceive;				/*< The reader, while it is blocked on an empty buffer. */
+	unsigned char *pucBuffer;					/*< The storage area. */
+	unsigned char ucFlags;						/*< sbFLAGS_ bits. */
+} xSTREAM_BUFFER;
+
+/* xStaticStreamBuffer in stream_buffer.h must have the same size as
+xSTREAM_BUFFER.  The array size is negative, and the build fails, if it does
+not. */
+typedef char sbSTATIC_STREAM_BUFFER_SIZE_CHECK[ ( sizeof( xStaticStreamBuffer ) == sizeof( xSTREAM_BUFFER ) ) ? 1 : -1 ];
+
+/*
+ * The number of bytes in the buffer and the number of bytes that can still be
+ * written.
+ */
+static size_t prvBytesInBuffer( const xSTREAM_BUFFER * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
+static size_t prvSpacesInBuffer( const xSTREAM_BUFFER * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copy xCount bytes to or from the buffer starting at index xIndex, wrapping
+ * at the end of the storage area.  Returns the index following the bytes, the
+ * caller publishes it.
+ */
+static size_t prvWriteBytes( xSTREAM_BUFFER * const pxStreamBuffer, const unsigned char *pucData, size_t xCount, size_t xIndex ) PRIVILEGED_FUNCTION;
+static size_t prvReadBytes( const xSTREAM_BUFFER * const pxStreamBuffer, unsigned char *pucData, size_t xCount, size_t xIndex ) PRIVILEGED_FUNCTION;
+
+/*
+ * The writer and reader side data paths shared by the task and ISR APIs.
+ * Neither blocks.  They return the number of bytes of payload moved.
+ */
+static size_t prvWriteToBuffer( xSTREAM_BUFFER * const pxStreamBuffer, const void *pvTxData, size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+static size_t prvReadFromBuffer( xSTREAM_BUFFER * const pxStreamBuffer, void *pvRxData, size_t xBufferLengthBytes ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns pdTRUE if the data now in the buffer should wake the reader.
+ */
+static portBASE_TYPE prvReaderShouldBeWoken( const xSTREAM_BUFFER * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Wake the task blocked on pxEventList, if there is one.  The task version
+ * yields to it if it has a higher priority, the ISR version sets
+ * *pxHigherPriorityTaskWoken instead.
+ */
+static void prvWakeWaitingTask( xList * const pxEventList ) PRIVILEGED_FUNCTION;
+static void prvWakeWaitingTaskFromISR( xList * const pxEventList, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+static void prvInitialiseNewStreamBuffer( xSTREAM_BUFFER * const pxStreamBuffer, unsigned char * const pucBuffer, size_t xBufferSizeBytes, size_t xTriggerLevelBytes, unsigned char ucFlags ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+xStreamBufferHandle xStreamBufferGenericCreate( size_t xBufferSizeBytes, size_t xTriggerLevelBytes, portBASE_TYPE xIsMessageBuffer )
+{
+xSTREAM_BUFFER *pxStreamBuffer;
+unsigned char ucFlags = 0;
+
+	if( xIsMessageBuffer != pdFALSE )
+	{
+		/* A message buffer must at least hold a length and one byte. */
+		if( xBufferSizeBytes <= sizeof( size_t ) )
+		{
+			return NULL;
+		}
+		ucFlags = sbFLAGS_IS_MESSAGE_BUFFER;
+	}
+
+	if( xTriggerLevelBytes == ( size_t ) 0 )
+	{
+		xTriggerLevelBytes = ( size_t ) 1;
+	}
+
+	if( ( xBufferSizeBytes == ( size_t ) 0 ) || ( xTriggerLevelBytes > xBufferSizeBytes ) )
+	{
+		return NULL;
+	}
+
+	/* The storage area follows the structure in the same allocation, with
+	the extra byte that is always kept free. */
+	pxStreamBuffer = ( xSTREAM_BUFFER * ) pvPortMalloc( sizeof( xSTREAM_BUFFER ) + xBufferSizeBytes + ( size_t ) 1 );
+	if( pxStreamBuffer != NULL )
+	{
+		prvInitialiseNewStreamBuffer( pxStreamBuffer, ( unsigned char * ) &( pxStreamBuffer[ 1 ] ), xBufferSizeBytes + ( size_t ) 1, xTriggerLevelBytes, ucFlags );
+	}
+
+	return ( xStreamBufferHandle ) pxStreamBuffer;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	xStreamBufferHandle xStreamBufferGenericCreateStatic( size_t xBufferSizeBytes, size_t xTriggerLevelBytes, portBASE_TYPE xIsMessageBuffer, unsigned char *pucStreamBufferStorage, xStaticStreamBuffer *pxStaticStreamBuffer )
+	{
+	xSTREAM_BUFFER *pxStreamBuffer = ( xSTREAM_BUFFER * ) pxStaticStreamBuffer;
+	unsigned char ucFlags = sbFLAGS_IS_STATICALLY_ALLOCATED;
+
+		if( ( pucStreamBufferStorage == NULL ) || ( pxStaticStreamBuffer == NULL ) )
+		{
+			return NULL;
+		}
+
+		if( xIsMessageBuffer != pdFALSE )
+		{
+			if( xBufferSizeBytes <= sizeof( size_t ) )
+			{
+				return NULL;
+			}
+			ucFlags |= sbFLAGS_IS_MESSAGE_BUFFER;
+		}
+
+		if( xTriggerLevelBytes == ( size_t ) 0 )
+		{
+			xTriggerLevelBytes = ( size_t ) 1;
+		}
+
+		if( ( xBufferSizeBytes == ( size_t ) 0 ) || ( xTriggerLevelBytes > xBufferSizeBytes ) )
+		{
+			return NULL;
+		}
+
+		prvInitialiseNewStreamBuffer( pxStreamBuffer, pucStreamBufferStorage, xBufferSizeBytes + ( size_t ) 1, xTriggerLevelBytes, ucFlags );
+
+		return ( xStreamBufferHandle ) pxStreamBuffer;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+void vStreamBufferDelete( xStreamBufferHandle xStreamBuffer )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+
+	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_STATICALLY_ALLOCATED ) == 0 )
+	{
+		vPortFree( pxStreamBuffer );
+	}
+	else
+	{
+		/* The memory belongs to the application, just make the structure
+		unusable. */
+		memset( pxStreamBuffer, 0x00, sizeof( xSTREAM_BUFFER ) );
+	}
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSend( xStreamBufferHandle xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, portTickType xTicksToWait )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+xTimeOutType xTimeOut;
+size_t xRequired = xDataLengthBytes;
+size_t xSpace, xWritten;
+
+	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != 0 )
+	{
+		/* A message is written whole or not at all. */
+		xRequired += sizeof( size_t );
+		if( xRequired >= pxStreamBuffer->xLength )
+		{
+			return 0;
+		}
+	}
+	else if( xRequired >= pxStreamBuffer->xLength )
+	{
+		/* Wait for the buffer to empty at most, the rest is not written. */
+		xRequired = pxStreamBuffer->xLength - ( size_t ) 1;
+	}
+
+	if( xTicksToWait != ( portTickType ) 0 )
+	{
+		vTaskSetTimeOutState( &xTimeOut );
+
+		for( ;; )
+		{
+			/* The reader looks at the event list in a critical section
+			after it frees space, so it either sees this task on the list
+			or freed the space before the test. */
+			portENTER_CRITICAL();
+			{
+				xSpace = prvSpacesInBuffer( pxStreamBuffer );
+				if( xSpace < xRequired )
+				{
+					vTaskPlaceOnEventList( &( pxStreamBuffer->xTasksWaitingToSend ), xTicksToWait );
+				}
+			}
+			portEXIT_CRITICAL();
+
+			if( xSpace >= xRequired )
+			{
+				break;
+			}
+
+			/* Not on the ready list any more, runs again once the reader
+			removes it from the event list or the block time expires. */
+			portYIELD_WITHIN_API();
+
+			if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+			{
+				break;
+			}
+		}
+	}
+
+	xWritten = prvWriteToBuffer( pxStreamBuffer, pvTxData, xDataLengthBytes );
+
+	if( ( xWritten > ( size_t ) 0 ) && ( prvReaderShouldBeWoken( pxStreamBuffer ) != pdFALSE ) )
+	{
+		prvWakeWaitingTask( &( pxStreamBuffer->xTasksWaitingToReceive ) );
+	}
+
+	return xWritten;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSendFromISR( xStreamBufferHandle xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+size_t xWritten;
+
+	xWritten = prvWriteToBuffer( pxStreamBuffer, pvTxData, xDataLengthBytes );
+
+	if( ( xWritten > ( size_t ) 0 ) && ( prvReaderShouldBeWoken( pxStreamBuffer ) != pdFALSE ) )
+	{
+		prvWakeWaitingTaskFromISR( &( pxStreamBuffer->xTasksWaitingToReceive ), pxHigherPriorityTaskWoken );
+	}
+
+	return xWritten;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferReceive( xStreamBufferHandle xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, portTickType xTicksToWait )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+xTimeOutType xTimeOut;
+size_t xBytes, xRead;
+
+	if( xTicksToWait != ( portTickType ) 0 )
+	{
+		vTaskSetTimeOutState( &xTimeOut );
+
+		for( ;; )
+		{
+			portENTER_CRITICAL();
+			{
+				xBytes = prvBytesInBuffer( pxStreamBuffer );
+				if( xBytes == ( size_t ) 0 )
+				{
+					vTaskPlaceOnEventList( &( pxStreamBuffer->xTasksWaitingToReceive ), xTicksToWait );
+				}
+			}
+			portEXIT_CRITICAL();
+
+			if( xBytes != ( size_t ) 0 )
+			{
+				break;
+			}
+
+			/* The writer only wakes this task once the trigger level is
+			reached.  Bytes below the trigger level are returned when the
+			block time expires. */
+			portYIELD_WITHIN_API();
+
+			if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+			{
+				break;
+			}
+		}
+	}
+
+	xRead = prvReadFromBuffer( pxStreamBuffer, pvRxData, xBufferLengthBytes );
+
+	if( xRead > ( size_t ) 0 )
+	{
+		prvWakeWaitingTask( &( pxStreamBuffer->xTasksWaitingToSend ) );
+	}
+
+	return xRead;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferReceiveFromISR( xStreamBufferHandle xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+size_t xRead;
+
+	xRead = prvReadFromBuffer( pxStreamBuffer, pvRxData, xBufferLengthBytes );
+
+	if( xRead > ( size_t ) 0 )
+	{
+		prvWakeWaitingTaskFromISR( &( pxStreamBuffer->xTasksWaitingToSend ), pxHigherPriorityTaskWoken );
+	}
+
+	return xRead;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xStreamBufferIsEmpty( xStreamBufferHandle xStreamBuffer )
+{
+const xSTREAM_BUFFER * const pxStreamBuffer = ( const xSTREAM_BUFFER * ) xStreamBuffer;
+
+	return ( pxStreamBuffer->xHead == pxStreamBuffer->xTail ) ? pdTRUE : pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xStreamBufferIsFull( xStreamBufferHandle xStreamBuffer )
+{
+const xSTREAM_BUFFER * const pxStreamBuffer = ( const xSTREAM_BUFFER * ) xStreamBuffer;
+size_t xMinimum = ( size_t ) 0;
+
+	/* A message buffer is full when not even a one byte message fits. */
+	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != 0 )
+	{
+		xMinimum = sizeof( size_t );
+	}
+
+	return ( prvSpacesInBuffer( pxStreamBuffer ) <= xMinimum ) ? pdTRUE : pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferBytesAvailable( xStreamBufferHandle xStreamBuffer )
+{
+	return prvBytesInBuffer( ( const xSTREAM_BUFFER * ) xStreamBuffer );
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSpacesAvailable( xStreamBufferHandle xStreamBuffer )
+{
+	return prvSpacesInBuffer( ( const xSTREAM_BUFFER * ) xStreamBuffer );
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xStreamBufferSetTriggerLevel( xStreamBufferHandle xStreamBuffer, size_t xTriggerLevel )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+
+	if( xTriggerLevel == ( size_t ) 0 )
+	{
+		xTriggerLevel = ( size_t ) 1;
+	}
+
+	if( xTriggerLevel >= pxStreamBuffer->xLength )
+	{
+		return pdFALSE;
+	}
+
+	pxStreamBuffer->xTriggerLevelBytes = xTriggerLevel;
+	return pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xStreamBufferReset( xStreamBufferHandle xStreamBuffer )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+portBASE_TYPE xReturn = pdFAIL;
+
+	portENTER_CRITICAL();
+	{
+		if( ( listLIST_IS_EMPTY( &( pxStreamBuffer->xTasksWaitingToReceive ) ) != pdFALSE ) && ( listLIST_IS_EMPTY( &( pxStreamBuffer->xTasksWaitingToSend ) ) != pdFALSE ) )
+		{
+			pxStreamBuffer->xHead = ( size_t ) 0;
+			pxStreamBuffer->xTail = ( size_t ) 0;
+			xReturn = pdPASS;
+		}
+	}
+	portEXIT_CRITICAL();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvBytesInBuffer( const xSTREAM_BUFFER * const pxStreamBuffer )
+{
+size_t xCount;
+
+	xCount = pxStreamBuffer->xLength + pxStreamBuffer->xHead;
+	xCount -= pxStreamBuffer->xTail;
+	if( xCount >= pxStreamBuffer->xLength )
+	{
+		xCount -= pxStreamBuffer->xLength;
+	}
+
+	return xCount;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvSpacesInBuffer( const xSTREAM_BUFFER * const pxStreamBuffer )
+{
+	return ( pxStreamBuffer->xLength - ( size_t ) 1 ) - prvBytesInBuffer( pxStreamBuffer );
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvWriteBytes( xSTREAM_BUFFER * const pxStreamBuffer, const unsigned char *pucData, size_t xCount, size_t xIndex )
+{
+size_t xFirst;
+
+	/* Up to the end of the storage area, then the rest from the start. */
+	xFirst = pxStreamBuffer->xLength - xIndex;
+	if( xFirst > xCount )
+	{
+		xFirst = xCount;
+	}
+
+	memcpy( ( void * ) &( pxStreamBuffer->pucBuffer[ xIndex ] ), ( const void * ) pucData, xFirst );
+	if( xCount > xFirst )
+	{
+		memcpy( ( void * ) pxStreamBuffer->pucBuffer, ( const void * ) &( pucData[ xFirst ] ), xCount - xFirst );
+	}
+
+	xIndex += xCount;
+	if( xIndex >= pxStreamBuffer->xLength )
+	{
+		xIndex -= pxStreamBuffer->xLength;
+	}
+
+	return xIndex;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvReadBytes( const xSTREAM_BUFFER * const pxStreamBuffer, unsigned char *pucData, size_t xCount, size_t xIndex )
+{
+size_t xFirst;
+
+	xFirst = pxStreamBuffer->xLength - xIndex;
+	if( xFirst > xCount )
+	{
+		xFirst = xCount;
+	}
+
+	memcpy( ( void * ) pucData, ( const void * ) &( pxStreamBuffer->pucBuffer[ xIndex ] ), xFirst );
+	if( xCount > xFirst )
+	{
+		memcpy( ( void * ) &( pucData[ xFirst ] ), ( const void * ) pxStreamBuffer->pucBuffer, xCount - xFirst );
+	}
+
+	xIndex += xCount;
+	if( xIndex >= pxStreamBuffer->xLength )
+	{
+		xIndex -= pxStreamBuffer->xLength;
+	}
+
+	return xIndex;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvWriteToBuffer( xSTREAM_BUFFER * const pxStreamBuffer, const void *pvTxData, size_t xDataLengthBytes )
+{
+size_t xSpace, xHead;
+
+	/* Only this side moves xHead.  The reader can only add space while the
+	bytes are copied. */
+	xSpace = prvSpacesInBuffer( pxStreamBuffer );
+	xHead = pxStreamBuffer->xHead;
+
+	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != 0 )
+	{
+		if( ( xDataLengthBytes + sizeof( size_t ) ) > xSpace )
+		{
+			return 0;
+		}
+
+		xHead = prvWriteBytes( pxStreamBuffer, ( const unsigned char * ) &xDataLengthBytes, sizeof( size_t ), xHead );
+	}
+	else if( xDataLengthBytes > xSpace )
+	{
+		xDataLengthBytes = xSpace;
+	}
+
+	if( xDataLengthBytes > ( size_t ) 0 )
+	{
+		xHead = prvWriteBytes( pxStreamBuffer, ( const unsigned char * ) pvTxData, xDataLengthBytes, xHead );
+	}
+
+	sbMEMORY_BARRIER();
+	pxStreamBuffer->xHead = xHead;
+
+	return xDataLengthBytes;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvReadFromBuffer( xSTREAM_BUFFER * const pxStreamBuffer, void *pvRxData, size_t xBufferLengthBytes )
+{
+size_t xBytes, xTail, xMessageLength;
+
+	/* Only this side moves xTail.  The writer can only add bytes while they
+	are copied. */
+	xBytes = prvBytesInBuffer( pxStreamBuffer );
+	xTail = pxStreamBuffer->xTail;
+
+	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != 0 )
+	{
+		/* The writer publishes a length and its message together. */
+		if( xBytes < sizeof( size_t ) )
+		{
+			return 0;
+		}
+
+		xTail = prvReadBytes( pxStreamBuffer, ( unsigned char * ) &xMessageLength, sizeof( size_t ), xTail );
+
+		/* A message that does not fit is left in the buffer. */
+		if( xMessageLength > xBufferLengthBytes )
+		{
+			return 0;
+		}
+
+		xBufferLengthBytes = xMessageLength;
+	}
+	else if( xBufferLengthBytes > xBytes )
+	{
+		xBufferLengthBytes = xBytes;
+	}
+
+	if( xBufferLengthBytes > ( size_t ) 0 )
+	{
+		xTail = prvReadBytes( pxStreamBuffer, ( unsigned char * ) pvRxData, xBufferLengthBytes, xTail );
+	}
+
+	sbMEMORY_BARRIER();
+	pxStreamBuffer->xTail = xTail;
+
+	return xBufferLengthBytes;
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvReaderShouldBeWoken( const xSTREAM_BUFFER * const pxStreamBuffer )
+{
+	/* Every message is worth waking the reader for. */
+	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != 0 )
+	{
+		return pdTRUE;
+	}
+
+	return ( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes ) ? pdTRUE : pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWakeWaitingTask( xList * const pxEventList )
+{
+signed portBASE_TYPE xYieldRequired = pdFALSE;
+
+	/* The task that blocks adds itself to the list in a critical section,
+	so the list is only looked at in one. */
+	portENTER_CRITICAL();
+	{
+		if( listLIST_IS_EMPTY( pxEventList ) == pdFALSE )
+		{
+			xYieldRequired = xTaskRemoveFromEventList( pxEventList );
+		}
+	}
+	portEXIT_CRITICAL();
+
+	if( xYieldRequired != pdFALSE )
+	{
+		portYIELD_WITHIN_API();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvWakeWaitingTaskFromISR( xList * const pxEventList, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+unsigned portBASE_TYPE uxSavedInterruptStatus;
+
+	/* A nested irq may use the same buffer from the other side. */
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		if( listLIST_IS_EMPTY( pxEventList ) == pdFALSE )
+		{
+			if( ( xTaskRemoveFromEventList( pxEventList ) != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+			{
+				*pxHigherPriorityTaskWoken = pdTRUE;
+			}
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewStreamBuffer( xSTREAM_BUFFER * const pxStreamBuffer, unsigned char * const pucBuffer, size_t xBufferSizeBytes, size_t xTriggerLevelBytes, unsigned char ucFlags )
+{
+	pxStreamBuffer->xTail = ( size_t ) 0;
+	pxStreamBuffer->xHead = ( size_t ) 0;
+	pxStreamBuffer->xLength = xBufferSizeBytes;
+	pxStreamBuffer->xTriggerLevelBytes = xTriggerLevelBytes;
+	vListInitialise( &( pxStreamBuffer->xTasksWaitingToSend ) );
+	vListInitialise( &( pxStreamBuffer->xTasksWaitingToReceive ) );
+	pxStreamBuffer->pucBuffer = pucBuffer;
+	pxStreamBuffer->ucFlags = ucFlags;
+}
+
@@ -64,6 +64,8 @@ task.h is included from an application file. */
 #include "FreeRTOS.h"
 #include "task.h"
 #include "StackMacros.h"
+#include "event_groups.h"
+#include "croutine.h"
 
 #undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
 
@@ -114,8 +116,50 @@ typedef struct tskTaskControlBlock
 		unsigned long ulRunTimeCounter;		/*< Used for calculating how much CPU time each task is utilising. */
 	#endif
 
+	#if ( configGENERATE_CYCLE_STATS == 1 )
+		unsigned long long ullCycleCounter;	/*< Cycles used by the task, accumulated by traceTASK_SWITCHED_OUT(). */
+	#endif
+
+	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+		volatile unsigned long ulNotifiedValue;	/*< The value sent to the task by xTaskNotify(). */
+		volatile unsigned char ucNotifyState;	/*< One of the taskNOTIFICATION states below. */
+	#endif
+
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		unsigned char ucStaticallyAllocated;	/*< One of the tskSTATICALLY_ALLOCATED values below, tells prvDeleteTCB() what to free. */
+	#endif
+
+	#if ( configGENERATE_STACK_STATS == 1 )
+		unsigned short usStackDepth;			/*< The stack size in words, reported by uxTaskGetStackStats(). */
+	#endif
+
 } tskTCB;
 
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	/*
+	 * Values that can be assigned to the ucStaticallyAllocated member of the
+	 * TCB.
+	 */
+	#define tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB		( ( unsigned char ) 0 )
+	#define tskSTATICALLY_ALLOCATED_STACK_ONLY			( ( unsigned char ) 1 )
+	#define tskSTATICALLY_ALLOCATED_STACK_AND_TCB		( ( unsigned char ) 2 )
+
+	/*
+	 * xStaticTask in task.h must have the same size as the TCB.  The array
+	 * size is negative, and the build fails, if it does not.
+	 */
+	typedef char tskSTATIC_TCB_SIZE_CHECK[ ( sizeof( xStaticTask ) == sizeof( tskTCB ) ) ? 1 : -1 ];
+
+#endif
+
+/*
+ * Values that can be assigned to the ucNotifyState member of the TCB.
+ */
+#define taskNOT_WAITING_NOTIFICATION	( ( unsigned char ) 0 )
+#define taskWAITING_NOTIFICATION		( ( unsigned char ) 1 )
+#define taskNOTIFICATION_RECEIVED		( ( unsigned char ) 2 )
+
 
 /*
  * Some kernel aware debuggers require data to be viewed to be global, rather
@@ -131,10 +175,32 @@ PRIVILEGED_DATA tskTCB * volatile pxCurrentTCB = NULL;
 /* Lists for ready and blocked tasks. --------------------*/
 
 PRIVILEGED_DATA static xList pxReadyTasksLists[ configMAX_PRIORITIES ];	/*< Prioritised ready tasks. */
-PRIVILEGED_DATA static xList xDelayedTaskList1;							/*< Delayed tasks. */
-PRIVILEGED_DATA static xList xDelayedTaskList2;							/*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
-PRIVILEGED_DATA static xList * volatile pxDelayedTaskList ;				/*< Points to the delayed task list currently being used. */
-PRIVILEGED_DATA static xList * volatile pxOverflowDelayedTaskList;		/*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+#if ( configUSE_DELAY_WHEEL == 1 )
+
+	/* Delayed tasks are kept in a two level timing wheel rather than in a
+	sorted list.  Level one has a slot for each of the next tskWHEEL_SLOTS
+	ticks, level two a slot for each of the next tskWHEEL_SLOTS blocks of
+	tskWHEEL_SLOTS ticks, a task delayed further waits in the far list.  A
+	task is added to the end of its slot, all the tasks of a level one slot
+	are woken on its tick, a level two slot is spread over level one when its
+	block starts and the far list is spread over the wheel each time level two
+	turns over. */
+	#define tskWHEEL_SLOTS		( ( portTickType ) 1 << configDELAY_WHEEL_BITS )
+	#define tskWHEEL_MASK		( tskWHEEL_SLOTS - ( portTickType ) 1 )
+	#define tskWHEEL_LEVEL_TWO	( tskWHEEL_SLOTS )
+	#define tskWHEEL_FAR		( tskWHEEL_SLOTS * 2 )
+	#define tskWHEEL_LISTS		( tskWHEEL_FAR + 1 )
+
+	PRIVILEGED_DATA static xList xDelayWheel[ tskWHEEL_LISTS ];			/*< Delayed tasks, level one slots, level two slots and the far list. */
+
+#else
+
+	PRIVILEGED_DATA static xList xDelayedTaskList1;							/*< Delayed tasks. */
+	PRIVILEGED_DATA static xList xDelayedTaskList2;							/*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
+	PRIVILEGED_DATA static xList * volatile pxDelayedTaskList ;				/*< Points to the delayed task list currently being used. */
+	PRIVILEGED_DATA static xList * volatile pxOverflowDelayedTaskList;		/*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+
+#endif
 PRIVILEGED_DATA static xList xPendingReadyList;							/*< Tasks that have been readied while the scheduler was suspended.  They will be moved to the ready queue when the scheduler is resumed. */
 
 #if ( INCLUDE_vTaskDelete == 1 )
@@ -154,7 +220,7 @@ PRIVILEGED_DATA static xList xPendingReadyList;							/*< Tasks that have been r
 PRIVILEGED_DATA static volatile unsigned portBASE_TYPE uxCurrentNumberOfTasks 	= ( unsigned portBASE_TYPE ) 0;
 PRIVILEGED_DATA static volatile portTickType xTickCount 						= ( portTickType ) 0;
 PRIVILEGED_DATA static unsigned portBASE_TYPE uxTopUsedPriority	 				= tskIDLE_PRIORITY;
-PRIVILEGED_DATA static volatile unsigned portBASE_TYPE uxTopReadyPriority 		= tskIDLE_PRIORITY;
+PRIVILEGED_DATA static volatile unsigned portBASE_TYPE uxTopReadyPriority 		= tskIDLE_PRIORITY;	/*< The top ready priority, or a bitmap of the ready priorities when configUSE_PORT_OPTIMISED_TASK_SELECTION is 1. */
 PRIVILEGED_DATA static volatile signed portBASE_TYPE xSchedulerRunning 			= pdFALSE;
 PRIVILEGED_DATA static volatile unsigned portBASE_TYPE uxSchedulerSuspended	 	= ( unsigned portBASE_TYPE ) pdFALSE;
 PRIVILEGED_DATA static volatile unsigned portBASE_TYPE uxMissedTicks 			= ( unsigned portBASE_TYPE ) 0;
@@ -170,6 +236,26 @@ PRIVILEGED_DATA static unsigned portBASE_TYPE uxTaskNumber 						= ( unsigned po
 
 #endif
 
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	/* The idle task is created from these so starting the scheduler does not
+	use the heap. */
+	PRIVILEGED_DATA static xStaticTask xIdleTaskTCB;
+	PRIVILEGED_DATA static portSTACK_TYPE xIdleTaskStack[ tskIDLE_STACK_SIZE ];
+
+#endif
+
+/*
+ * Set in the event list item value of a task while the value holds the bits
+ * the task waits for in an event group rather than its priority.  Changing
+ * the priority of the task must then not overwrite the value.
+ */
+#if ( configUSE_16_BIT_TICKS == 1 )
+	#define taskEVENT_LIST_ITEM_VALUE_IN_USE	( ( portTickType ) 0x8000U )
+#else
+	#define taskEVENT_LIST_ITEM_VALUE_IN_USE	( ( portTickType ) 0x80000000UL )
+#endif
+
 /* Debugging and trace facilities private variables and macros. ------------*/
 
 /*
@@ -240,6 +326,62 @@ PRIVILEGED_DATA static unsigned portBASE_TYPE uxTaskNumber 						= ( unsigned po
 #endif
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+
+	/* uxTopReadyPriority holds the priority of the highest priority ready
+	state task, it is only a hint and is walked down to the first non-empty
+	ready list when a task is selected. */
+	#define taskRECORD_READY_PRIORITY( uxPriority )															\
+	{																										\
+		if( ( uxPriority ) > uxTopReadyPriority )															\
+		{																									\
+			uxTopReadyPriority = ( uxPriority );															\
+		}																									\
+	}
+
+	#define taskSELECT_HIGHEST_PRIORITY_TASK()																\
+	{																										\
+		/* Find the highest priority queue that contains ready tasks. */									\
+		while( listLIST_IS_EMPTY( &( pxReadyTasksLists[ uxTopReadyPriority ] ) ) )							\
+		{																									\
+			--uxTopReadyPriority;																			\
+		}																									\
+																											\
+		/* listGET_OWNER_OF_NEXT_ENTRY walks through the list, so the tasks of the						\
+		same priority get an equal share of the processor time. */										\
+		listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopReadyPriority ] ) );		\
+	}
+
+	/* Nothing to do, the lists are checked when a task is selected. */
+	#define taskRESET_READY_PRIORITY( uxPriority )
+
+#else
+
+	/* uxTopReadyPriority holds a bitmap of the priorities that have ready
+	tasks, the port finds the highest set bit. */
+	#define taskRECORD_READY_PRIORITY( uxPriority )	portRECORD_READY_PRIORITY( uxPriority, uxTopReadyPriority )
+
+	#define taskSELECT_HIGHEST_PRIORITY_TASK()																\
+	{																										\
+	unsigned portBASE_TYPE uxTopPriority;																	\
+																											\
+		portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopReadyPriority );									\
+		listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );			\
+	}
+
+	/* Must be used after a task is removed from a list that might be a ready
+	list, the bit is only cleared once the ready list is empty. */
+	#define taskRESET_READY_PRIORITY( uxPriority )															\
+	{																										\
+		if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ ( uxPriority ) ] ) ) == 0 )						\
+		{																									\
+			portRESET_READY_PRIORITY( ( uxPriority ), uxTopReadyPriority );									\
+		}																									\
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
 /*
  * Place the task represented by pxTCB into the appropriate ready queue for
  * the task.  It is inserted at the end of the list.  One quirk of this is
@@ -249,10 +391,8 @@ PRIVILEGED_DATA static unsigned portBASE_TYPE uxTaskNumber 						= ( unsigned po
  */
 #define prvAddTaskToReadyQueue( pxTCB )																			\
 {																												\
-	if( pxTCB->uxPriority > uxTopReadyPriority )																\
-	{																											\
-		uxTopReadyPriority = pxTCB->uxPriority;																	\
-	}																											\
+	traceMOVED_TASK_TO_READY_STATE( pxTCB );																	\
+	taskRECORD_READY_PRIORITY( pxTCB->uxPriority );															\
 	vListInsertEnd( ( xList * ) &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xGenericListItem ) );	\
 }
 /*-----------------------------------------------------------*/
@@ -342,11 +482,66 @@ static portTASK_FUNCTION_PROTO( prvIdleTask, pvParameters );
  */
 static void prvCheckTasksWaitingTermination( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Place the calling task, already removed from its ready list, in the delayed
+ * list that matches xTimeToWake.
+ */
+static void prvAddCurrentTaskToDelayedList( portTickType xTimeToWake ) PRIVILEGED_FUNCTION;
+
+/*
+ * Remove the calling task, already placed in an event list, from its ready
+ * list and block it for up to xTicksToWait ticks, forever for portMAX_DELAY.
+ */
+static void prvAddCurrentTaskToBlockedList( portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+#if ( configUSE_DELAY_WHEEL == 1 )
+
+	/*
+	 * Add a delayed task list item to the wheel slot of xTimeToWake.
+	 * xNextTick is the first tick vTaskIncrementTick() has not processed yet,
+	 * xTimeToWake must not be before it.
+	 */
+	static void prvDelayWheelInsert( xListItem *pxItem, portTickType xTimeToWake, portTickType xNextTick ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Wake the tasks due on xTickCount, moving the tasks of the block that
+	 * starts on it down the wheel first.
+	 */
+	static void prvDelayWheelTick( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Returns the number of ticks the idle task can sleep for: until the next
+ * task leaves the delayed list, or until the tick count wraps if no task is
+ * delayed, so the delayed lists are swapped by a real tick.  Returns 0 if
+ * another task is ready at the idle priority.  With the delay wheel the sleep
+ * also ends at the next block start, where the wheel is moved on.
+ */
+#if ( configUSE_TICKLESS_IDLE == 1 )
+
+	static portTickType prvGetExpectedIdleTime( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Move a task that is blocked in xTaskNotifyWait() or ulTaskNotifyTake() to
+ * the ready list, or to the pending ready list if the scheduler is suspended.
+ * Must be called with interrupts disabled.  Returns pdTRUE if the task has a
+ * priority above the calling task.
+ */
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	static portBASE_TYPE prvNotifyUnblockTask( tskTCB *pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * Allocates memory from the heap for a TCB and associated stack.  Checks the
- * allocation was successful.
+ * allocation was successful.  If pxTaskBuffer is not NULL the TCB and the
+ * stack are the ones provided by the caller and nothing is allocated.
  */
-static tskTCB *prvAllocateTCBAndStack( unsigned short usStackDepth, portSTACK_TYPE *puxStackBuffer ) PRIVILEGED_FUNCTION;
+static tskTCB *prvAllocateTCBAndStack( unsigned short usStackDepth, portSTACK_TYPE *puxStackBuffer, xStaticTask * const pxTaskBuffer ) PRIVILEGED_FUNCTION;
 
 /*
  * Called from vTaskList.  vListTasks details all the tasks currently under
@@ -363,6 +558,26 @@ static tskTCB *prvAllocateTCBAndStack( unsigned short usStackDepth, portSTACK_TY
 
 #endif
 
+/*
+ * Called from uxTaskGetCycleStats.  Copies the cycle counts of the tasks in
+ * pxList into pxStats, starting at uxIndex, and returns the next free index.
+ */
+#if ( configGENERATE_CYCLE_STATS == 1 )
+
+	static unsigned portBASE_TYPE prvCycleStatsWithinSingleList( xTaskCycleStats *pxStats, unsigned portBASE_TYPE uxIndex, unsigned portBASE_TYPE uxMaxTasks, xList *pxList ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Called from uxTaskGetStackStats.  Measures the stacks of the tasks in pxList
+ * into pxStats, starting at uxIndex, and returns the next free index.
+ */
+#if ( configGENERATE_STACK_STATS == 1 )
+
+	static unsigned portBASE_TYPE prvStackStatsWithinSingleList( xTaskStackStats *pxStats, unsigned portBASE_TYPE uxIndex, unsigned portBASE_TYPE uxMaxTasks, xList *pxList ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * When a task is created, the stack of the task is filled with a known value.
  * This function determines the 'high water mark' of the task stack by
@@ -383,14 +598,14 @@ static tskTCB *prvAllocateTCBAndStack( unsigned short usStackDepth, portSTACK_TY
  * TASK CREATION API documented in task.h
  *----------------------------------------------------------*/
 
-signed portBASE_TYPE xTaskGenericCreate( pdTASK_CODE pxTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, unsigned portBASE_TYPE uxPriority, xTaskHandle *pxCreatedTask, portSTACK_TYPE *puxStackBuffer, const xMemoryRegion * const xRegions )
+signed portBASE_TYPE xTaskGenericCreate( pdTASK_CODE pxTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, unsigned portBASE_TYPE uxPriority, xTaskHandle *pxCreatedTask, portSTACK_TYPE *puxStackBuffer, const xMemoryRegion * const xRegions, xStaticTask * const pxTaskBuffer )
 {
 signed portBASE_TYPE xReturn;
 tskTCB * pxNewTCB;
 
 	/* Allocate the memory required by the TCB and stack for the new task,
 	checking that the allocation was successful. */
-	pxNewTCB = prvAllocateTCBAndStack( usStackDepth, puxStackBuffer );
+	pxNewTCB = prvAllocateTCBAndStack( usStackDepth, puxStackBuffer, pxTaskBuffer );
 
 	if( pxNewTCB != NULL )
 	{
@@ -557,6 +772,7 @@ tskTCB * pxNewTCB;
 			the termination list and free up any memory allocated by the
 			scheduler for the TCB and stack. */
 			vListRemove( &( pxTCB->xGenericListItem ) );
+			taskRESET_READY_PRIORITY( pxTCB->uxPriority );
 
 			/* Is the task waiting on an event also? */
 			if( pxTCB->xEventListItem.pvContainer )
@@ -646,22 +862,9 @@ tskTCB * pxNewTCB;
 				ourselves to the blocked list as the same list item is used for
 				both lists. */
 				vListRemove( ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
+				taskRESET_READY_PRIORITY( pxCurrentTCB->uxPriority );
 
-				/* The list item will be inserted in wake time order. */
-				listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xGenericListItem ), xTimeToWake );
-
-				if( xTimeToWake < xTickCount )
-				{
-					/* Wake time has overflowed.  Place this item in the
-					overflow list. */
-					vListInsert( ( xList * ) pxOverflowDelayedTaskList, ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
-				}
-				else
-				{
-					/* The wake time has not overflowed, so we can use the
-					current block list. */
-					vListInsert( ( xList * ) pxDelayedTaskList, ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
-				}
+				prvAddCurrentTaskToDelayedList( xTimeToWake );
 			}
 		}
 		xAlreadyYielded = xTaskResumeAll();
@@ -707,22 +910,9 @@ tskTCB * pxNewTCB;
 				ourselves to the blocked list as the same list item is used for
 				both lists. */
 				vListRemove( ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
+				taskRESET_READY_PRIORITY( pxCurrentTCB->uxPriority );
 
-				/* The list item will be inserted in wake time order. */
-				listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xGenericListItem ), xTimeToWake );
-
-				if( xTimeToWake < xTickCount )
-				{
-					/* Wake time has overflowed.  Place this item in the
-					overflow list. */
-					vListInsert( ( xList * ) pxOverflowDelayedTaskList, ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
-				}
-				else
-				{
-					/* The wake time has not overflowed, so we can use the
-					current block list. */
-					vListInsert( ( xList * ) pxDelayedTaskList, ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
-				}
+				prvAddCurrentTaskToDelayedList( xTimeToWake );
 			}
 			xAlreadyYielded = xTaskResumeAll();
 		}
@@ -838,7 +1028,10 @@ tskTCB * pxNewTCB;
 				}
 				#endif
 
-				listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( configMAX_PRIORITIES - ( portTickType ) uxNewPriority ) );
+				if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0 )
+				{
+					listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( configMAX_PRIORITIES - ( portTickType ) uxNewPriority ) );
+				}
 
 				/* If the task is in the blocked or suspended list we need do
 				nothing more than change it's priority variable. However, if
@@ -850,6 +1043,7 @@ tskTCB * pxNewTCB;
 					it to it's new ready list.  As we are in a critical section we
 					can do this even if the scheduler is suspended. */
 					vListRemove( &( pxTCB->xGenericListItem ) );
+					taskRESET_READY_PRIORITY( uxCurrentPriority );
 					prvAddTaskToReadyQueue( pxTCB );
 				}
 
@@ -887,6 +1081,7 @@ tskTCB * pxNewTCB;
 
 			/* Remove task from the ready/delayed list and place in the	suspended list. */
 			vListRemove( &( pxTCB->xGenericListItem ) );
+			taskRESET_READY_PRIORITY( pxTCB->uxPriority );
 
 			/* Is the task waiting on an event also? */
 			if( pxTCB->xEventListItem.pvContainer )
@@ -1048,7 +1243,26 @@ void vTaskStartScheduler( void )
 portBASE_TYPE xReturn;
 
 	/* Add the idle task at the lowest priority. */
-	xReturn = xTaskCreate( prvIdleTask, ( signed char * ) "IDLE", tskIDLE_STACK_SIZE, ( void * ) NULL, ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), ( xTaskHandle * ) NULL );
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	{
+		xReturn = xTaskCreateStatic( prvIdleTask, ( signed char * ) "IDLE", tskIDLE_STACK_SIZE, ( void * ) NULL, ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), ( xTaskHandle * ) NULL, xIdleTaskStack, &xIdleTaskTCB );
+	}
+	#else
+	{
+		xReturn = xTaskCreate( prvIdleTask, ( signed char * ) "IDLE", tskIDLE_STACK_SIZE, ( void * ) NULL, ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), ( xTaskHandle * ) NULL );
+	}
+	#endif
+
+	#if ( INCLUDE_xEventGroupSetBitsFromISR == 1 )
+	{
+		if( xReturn == pdPASS )
+		{
+			/* The task that sets the event group bits on behalf of the
+			interrupts. */
+			xReturn = xEventGroupCreateDaemon();
+		}
+	}
+	#endif
 
 	if( xReturn == pdPASS )
 	{
@@ -1244,15 +1458,29 @@ unsigned portBASE_TYPE uxTaskGetNumberOfTasks( void )
 				}
 			}while( uxQueue > ( unsigned short ) tskIDLE_PRIORITY );
 
-			if( !listLIST_IS_EMPTY( pxDelayedTaskList ) )
+			#if ( configUSE_DELAY_WHEEL == 1 )
 			{
-				prvListTaskWithinSingleList( pcWriteBuffer, ( xList * ) pxDelayedTaskList, tskBLOCKED_CHAR );
+				for( uxQueue = 0; uxQueue < tskWHEEL_LISTS; uxQueue++ )
+				{
+					if( !listLIST_IS_EMPTY( &( xDelayWheel[ uxQueue ] ) ) )
+					{
+						prvListTaskWithinSingleList( pcWriteBuffer, &( xDelayWheel[ uxQueue ] ), tskBLOCKED_CHAR );
+					}
+				}
 			}
-
-			if( !listLIST_IS_EMPTY( pxOverflowDelayedTaskList ) )
+			#else
 			{
-				prvListTaskWithinSingleList( pcWriteBuffer, ( xList * ) pxOverflowDelayedTaskList, tskBLOCKED_CHAR );
+				if( !listLIST_IS_EMPTY( pxDelayedTaskList ) )
+				{
+					prvListTaskWithinSingleList( pcWriteBuffer, ( xList * ) pxDelayedTaskList, tskBLOCKED_CHAR );
+				}
+
+				if( !listLIST_IS_EMPTY( pxOverflowDelayedTaskList ) )
+				{
+					prvListTaskWithinSingleList( pcWriteBuffer, ( xList * ) pxOverflowDelayedTaskList, tskBLOCKED_CHAR );
+				}
 			}
+			#endif
 
 			#if( INCLUDE_vTaskDelete == 1 )
 			{
@@ -1309,15 +1537,29 @@ unsigned portBASE_TYPE uxTaskGetNumberOfTasks( void )
 				}
 			}while( uxQueue > ( unsigned short ) tskIDLE_PRIORITY );
 
-			if( !listLIST_IS_EMPTY( pxDelayedTaskList ) )
+			#if ( configUSE_DELAY_WHEEL == 1 )
 			{
-				prvGenerateRunTimeStatsForTasksInList( pcWriteBuffer, ( xList * ) pxDelayedTaskList, ulTotalRunTime );
+				for( uxQueue = 0; uxQueue < tskWHEEL_LISTS; uxQueue++ )
+				{
+					if( !listLIST_IS_EMPTY( &( xDelayWheel[ uxQueue ] ) ) )
+					{
+						prvGenerateRunTimeStatsForTasksInList( pcWriteBuffer, &( xDelayWheel[ uxQueue ] ), ulTotalRunTime );
+					}
+				}
 			}
-
-			if( !listLIST_IS_EMPTY( pxOverflowDelayedTaskList ) )
+			#else
 			{
-				prvGenerateRunTimeStatsForTasksInList( pcWriteBuffer, ( xList * ) pxOverflowDelayedTaskList, ulTotalRunTime );
+				if( !listLIST_IS_EMPTY( pxDelayedTaskList ) )
+				{
+					prvGenerateRunTimeStatsForTasksInList( pcWriteBuffer, ( xList * ) pxDelayedTaskList, ulTotalRunTime );
+				}
+
+				if( !listLIST_IS_EMPTY( pxOverflowDelayedTaskList ) )
+				{
+					prvGenerateRunTimeStatsForTasksInList( pcWriteBuffer, ( xList * ) pxOverflowDelayedTaskList, ulTotalRunTime );
+				}
 			}
+			#endif
 
 			#if ( INCLUDE_vTaskDelete == 1 )
 			{
@@ -1343,6 +1585,162 @@ unsigned portBASE_TYPE uxTaskGetNumberOfTasks( void )
 #endif
 /*----------------------------------------------------------*/
 
+#if ( configGENERATE_CYCLE_STATS == 1 )
+
+	unsigned portBASE_TYPE uxTaskGetCycleStats( xTaskCycleStats *pxStats, unsigned portBASE_TYPE uxMaxTasks )
+	{
+	unsigned portBASE_TYPE uxQueue;
+	unsigned portBASE_TYPE uxIndex = 0;
+
+		vTaskSuspendAll();
+		{
+			/* Bring the count of the calling task up to date, the other tasks
+			were charged when they were switched out. */
+			portENTER_CRITICAL();
+			{
+				pxCurrentTCB->ullCycleCounter += portGET_TASK_CYCLES();
+			}
+			portEXIT_CRITICAL();
+
+			uxQueue = uxTopUsedPriority + 1;
+
+			do
+			{
+				uxQueue--;
+
+				if( !listLIST_IS_EMPTY( &( pxReadyTasksLists[ uxQueue ] ) ) )
+				{
+					uxIndex = prvCycleStatsWithinSingleList( pxStats, uxIndex, uxMaxTasks, ( xList * ) &( pxReadyTasksLists[ uxQueue ] ) );
+				}
+			}while( uxQueue > ( unsigned short ) tskIDLE_PRIORITY );
+
+			#if ( configUSE_DELAY_WHEEL == 1 )
+			{
+				for( uxQueue = 0; uxQueue < tskWHEEL_LISTS; uxQueue++ )
+				{
+					if( !listLIST_IS_EMPTY( &( xDelayWheel[ uxQueue ] ) ) )
+					{
+						uxIndex = prvCycleStatsWithinSingleList( pxStats, uxIndex, uxMaxTasks, &( xDelayWheel[ uxQueue ] ) );
+					}
+				}
+			}
+			#else
+			{
+				if( !listLIST_IS_EMPTY( pxDelayedTaskList ) )
+				{
+					uxIndex = prvCycleStatsWithinSingleList( pxStats, uxIndex, uxMaxTasks, ( xList * ) pxDelayedTaskList );
+				}
+
+				if( !listLIST_IS_EMPTY( pxOverflowDelayedTaskList ) )
+				{
+					uxIndex = prvCycleStatsWithinSingleList( pxStats, uxIndex, uxMaxTasks, ( xList * ) pxOverflowDelayedTaskList );
+				}
+			}
+			#endif
+
+			#if ( INCLUDE_vTaskDelete == 1 )
+			{
+				if( !listLIST_IS_EMPTY( &xTasksWaitingTermination ) )
+				{
+					uxIndex = prvCycleStatsWithinSingleList( pxStats, uxIndex, uxMaxTasks, ( xList * ) &xTasksWaitingTermination );
+				}
+			}
+			#endif
+
+			#if ( INCLUDE_vTaskSuspend == 1 )
+			{
+				if( !listLIST_IS_EMPTY( &xSuspendedTaskList ) )
+				{
+					uxIndex = prvCycleStatsWithinSingleList( pxStats, uxIndex, uxMaxTasks, ( xList * ) &xSuspendedTaskList );
+				}
+			}
+			#endif
+		}
+		xTaskResumeAll();
+
+		return uxIndex;
+	}
+
+#endif
+/*----------------------------------------------------------*/
+
+#if ( configGENERATE_STACK_STATS == 1 )
+
+	unsigned portBASE_TYPE uxTaskGetStackStats( xTaskStackStats *pxStats, unsigned portBASE_TYPE uxMaxTasks )
+	{
+	unsigned portBASE_TYPE uxQueue;
+	unsigned portBASE_TYPE uxIndex = 0;
+
+		vTaskSuspendAll();
+		{
+			uxQueue = uxTopUsedPriority + 1;
+
+			do
+			{
+				uxQueue--;
+
+				if( !listLIST_IS_EMPTY( &( pxReadyTasksLists[ uxQueue ] ) ) )
+				{
+					uxIndex = prvStackStatsWithinSingleList( pxStats, uxIndex, uxMaxTasks, ( xList * ) &( pxReadyTasksLists[ uxQueue ] ) );
+				}
+			}while( uxQueue > ( unsigned short ) tskIDLE_PRIORITY );
+
+			#if ( configUSE_DELAY_WHEEL == 1 )
+			{
+				for( uxQueue = 0; uxQueue < tskWHEEL_LISTS; uxQueue++ )
+				{
+					if( !listLIST_IS_EMPTY( &( xDelayWheel[ uxQueue ] ) ) )
+					{
+						uxIndex = prvStackStatsWithinSingleList( pxStats, uxIndex, uxMaxTasks, &( xDelayWheel[ uxQueue ] ) );
+					}
+				}
+			}
+			#else
+			{
+				if( !listLIST_IS_EMPTY( pxDelayedTaskList ) )
+				{
+					uxIndex = prvStackStatsWithinSingleList( pxStats, uxIndex, uxMaxTasks, ( xList * ) pxDelayedTaskList );
+				}
+
+				if( !listLIST_IS_EMPTY( pxOverflowDelayedTaskList ) )
+				{
+					uxIndex = prvStackStatsWithinSingleList( pxStats, uxIndex, uxMaxTasks, ( xList * ) pxOverflowDelayedTaskList );
+				}
+			}
+			#endif
+
+			#if ( INCLUDE_vTaskDelete == 1 )
+			{
+				if( !listLIST_IS_EMPTY( &xTasksWaitingTermination ) )
+				{
+					uxIndex = prvStackStatsWithinSingleList( pxStats, uxIndex, uxMaxTasks, ( xList * ) &xTasksWaitingTermination );
+				}
+			}
+			#endif
+
+			#if ( INCLUDE_vTaskSuspend == 1 )
+			{
+				if( !listLIST_IS_EMPTY( &xSuspendedTaskList ) )
+				{
+					uxIndex = prvStackStatsWithinSingleList( pxStats, uxIndex, uxMaxTasks, ( xList * ) &xSuspendedTaskList );
+				}
+			}
+			#endif
+
+			/* Tasks readied by an interrupt while the lists are walked. */
+			if( !listLIST_IS_EMPTY( &xPendingReadyList ) )
+			{
+				uxIndex = prvStackStatsWithinSingleList( pxStats, uxIndex, uxMaxTasks, ( xList * ) &xPendingReadyList );
+			}
+		}
+		xTaskResumeAll();
+
+		return uxIndex;
+	}
+
+#endif
+/*----------------------------------------------------------*/
+
 #if ( configUSE_TRACE_FACILITY == 1 )
 
 	void vTaskStartTrace( signed char * pcBuffer, unsigned long ulBufferSize )
@@ -1395,22 +1793,34 @@ void vTaskIncrementTick( void )
 		++xTickCount;
 		if( xTickCount == ( portTickType ) 0 )
 		{
+			#if ( configUSE_DELAY_WHEEL == 0 )
+			{
 			xList *pxTemp;
 
-			/* Tick count has overflowed so we need to swap the delay lists.
-			If there are any items in pxDelayedTaskList here then there is
-			an error! */
-			pxTemp = pxDelayedTaskList;
-			pxDelayedTaskList = pxOverflowDelayedTaskList;
-			pxOverflowDelayedTaskList = pxTemp;
+				/* Tick count has overflowed so we need to swap the delay lists.
+				If there are any items in pxDelayedTaskList here then there is
+				an error! */
+				pxTemp = pxDelayedTaskList;
+				pxDelayedTaskList = pxOverflowDelayedTaskList;
+				pxOverflowDelayedTaskList = pxTemp;
+			}
+			#endif
 			xNumOfOverflows++;
 		}
 
 		/* See if this tick has made a timeout expire. */
-		prvCheckDelayedTasks();
-	}
-	else
-	{
+		#if ( configUSE_DELAY_WHEEL == 1 )
+		{
+			prvDelayWheelTick();
+		}
+		#else
+		{
+			prvCheckDelayedTasks();
+		}
+		#endif
+	}
+	else
+	{
 		++uxMissedTicks;
 
 		/* The tick hook gets called at regular intervals, even if the
@@ -1441,6 +1851,49 @@ void vTaskIncrementTick( void )
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TICKLESS_IDLE == 1 )
+
+	void vTaskStepTick( portTickType xTicksToJump )
+	{
+		/* The port never sleeps past the expected idle time, so no delayed
+		task is due, the tick count does not wrap and no delay wheel block
+		starts: the tick count can be moved directly rather than through
+		vTaskIncrementTick(). */
+		xTickCount += xTicksToJump;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TICKLESS_IDLE == 1 )
+
+	eSleepModeStatus eTaskConfirmSleepModeStatus( void )
+	{
+	eSleepModeStatus eReturn = eStandardSleep;
+
+		if( listCURRENT_LIST_LENGTH( &xPendingReadyList ) != ( unsigned portBASE_TYPE ) 0 )
+		{
+			/* A task was readied by an interrupt while the scheduler was
+			suspended. */
+			eReturn = eAbortSleep;
+		}
+		else if( xMissedYield != pdFALSE )
+		{
+			eReturn = eAbortSleep;
+		}
+		else if( uxMissedTicks != ( unsigned portBASE_TYPE ) 0 )
+		{
+			/* The expected idle time was computed from a tick count that
+			is now late. */
+			eReturn = eAbortSleep;
+		}
+
+		return eReturn;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
 #if ( ( INCLUDE_vTaskCleanUpResources == 1 ) && ( INCLUDE_vTaskSuspend == 1 ) )
 
 	void vTaskCleanUpResources( void )
@@ -1459,28 +1912,47 @@ void vTaskIncrementTick( void )
 			{
 				listGET_OWNER_OF_NEXT_ENTRY( pxTCB, &( pxReadyTasksLists[ usQueue ] ) );
 				vListRemove( ( xListItem * ) &( pxTCB->xGenericListItem ) );
+				taskRESET_READY_PRIORITY( usQueue );
 
 				prvDeleteTCB( ( tskTCB * ) pxTCB );
 			}
 		}while( usQueue > ( unsigned short ) tskIDLE_PRIORITY );
 
-		/* Remove any TCB's from the delayed queue. */
-		while( !listLIST_IS_EMPTY( &xDelayedTaskList1 ) )
+		#if ( configUSE_DELAY_WHEEL == 1 )
 		{
-			listGET_OWNER_OF_NEXT_ENTRY( pxTCB, &xDelayedTaskList1 );
-			vListRemove( ( xListItem * ) &( pxTCB->xGenericListItem ) );
+			/* Remove any TCB's from the delay wheel. */
+			for( usQueue = 0; usQueue < ( unsigned short ) tskWHEEL_LISTS; usQueue++ )
+			{
+				while( !listLIST_IS_EMPTY( &( xDelayWheel[ usQueue ] ) ) )
+				{
+					listGET_OWNER_OF_NEXT_ENTRY( pxTCB, &( xDelayWheel[ usQueue ] ) );
+					vListRemove( ( xListItem * ) &( pxTCB->xGenericListItem ) );
 
-			prvDeleteTCB( ( tskTCB * ) pxTCB );
+					prvDeleteTCB( ( tskTCB * ) pxTCB );
+				}
+			}
 		}
-
-		/* Remove any TCB's from the overflow delayed queue. */
-		while( !listLIST_IS_EMPTY( &xDelayedTaskList2 ) )
+		#else
 		{
-			listGET_OWNER_OF_NEXT_ENTRY( pxTCB, &xDelayedTaskList2 );
-			vListRemove( ( xListItem * ) &( pxTCB->xGenericListItem ) );
+			/* Remove any TCB's from the delayed queue. */
+			while( !listLIST_IS_EMPTY( &xDelayedTaskList1 ) )
+			{
+				listGET_OWNER_OF_NEXT_ENTRY( pxTCB, &xDelayedTaskList1 );
+				vListRemove( ( xListItem * ) &( pxTCB->xGenericListItem ) );
 
-			prvDeleteTCB( ( tskTCB * ) pxTCB );
+				prvDeleteTCB( ( tskTCB * ) pxTCB );
+			}
+
+			/* Remove any TCB's from the overflow delayed queue. */
+			while( !listLIST_IS_EMPTY( &xDelayedTaskList2 ) )
+			{
+				listGET_OWNER_OF_NEXT_ENTRY( pxTCB, &xDelayedTaskList2 );
+				vListRemove( ( xListItem * ) &( pxTCB->xGenericListItem ) );
+
+				prvDeleteTCB( ( tskTCB * ) pxTCB );
+			}
 		}
+		#endif
 
 		while( !listLIST_IS_EMPTY( &xSuspendedTaskList ) )
 		{
@@ -1610,15 +2082,7 @@ void vTaskSwitchContext( void )
 	taskFIRST_CHECK_FOR_STACK_OVERFLOW();
 	taskSECOND_CHECK_FOR_STACK_OVERFLOW();
 
-	/* Find the highest priority queue that contains ready tasks. */
-	while( listLIST_IS_EMPTY( &( pxReadyTasksLists[ uxTopReadyPriority ] ) ) )
-	{
-		--uxTopReadyPriority;
-	}
-
-	/* listGET_OWNER_OF_NEXT_ENTRY walks through the list, so the tasks of the
-	same priority get an equal share of the processor time. */
-	listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopReadyPriority ] ) );
+	taskSELECT_HIGHEST_PRIORITY_TASK();
 
 	traceTASK_SWITCHED_IN();
 	vWriteTraceToBuffer();
@@ -1627,8 +2091,6 @@ void vTaskSwitchContext( void )
 
 void vTaskPlaceOnEventList( const xList * const pxEventList, portTickType xTicksToWait )
 {
-portTickType xTimeToWake;
-
 	/* THIS FUNCTION MUST BE CALLED WITH INTERRUPTS DISABLED OR THE
 	SCHEDULER SUSPENDED. */
 
@@ -1637,10 +2099,34 @@ portTickType xTimeToWake;
 	is the first to be woken by the event. */
 	vListInsert( ( xList * ) pxEventList, ( xListItem * ) &( pxCurrentTCB->xEventListItem ) );
 
+	prvAddCurrentTaskToBlockedList( xTicksToWait );
+}
+/*-----------------------------------------------------------*/
+
+void vTaskPlaceOnUnorderedEventList( xList * pxEventList, portTickType xItemValue, portTickType xTicksToWait )
+{
+	/* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is used
+	by the event groups, which are not accessed from interrupts. */
+
+	/* The item value holds what the task waits for, not its priority.  The
+	list is walked in full whenever the event occurs so the order does not
+	matter. */
+	listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+	vListInsertEnd( pxEventList, ( xListItem * ) &( pxCurrentTCB->xEventListItem ) );
+
+	prvAddCurrentTaskToBlockedList( xTicksToWait );
+}
+/*-----------------------------------------------------------*/
+
+static void prvAddCurrentTaskToBlockedList( portTickType xTicksToWait )
+{
+portTickType xTimeToWake;
+
 	/* We must remove ourselves from the ready list before adding ourselves
 	to the blocked list as the same list item is used for both lists.  We have
 	exclusive access to the ready lists as the scheduler is locked. */
 	vListRemove( ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
+	taskRESET_READY_PRIORITY( pxCurrentTCB->uxPriority );
 
 
 	#if ( INCLUDE_vTaskSuspend == 1 )
@@ -1657,19 +2143,7 @@ portTickType xTimeToWake;
 			/* Calculate the time at which the task should be woken if the event does
 			not occur.  This may overflow but this doesn't matter. */
 			xTimeToWake = xTickCount + xTicksToWait;
-
-			listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xGenericListItem ), xTimeToWake );
-
-			if( xTimeToWake < xTickCount )
-			{
-				/* Wake time has overflowed.  Place this item in the overflow list. */
-				vListInsert( ( xList * ) pxOverflowDelayedTaskList, ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
-			}
-			else
-			{
-				/* The wake time has not overflowed, so we can use the current block list. */
-				vListInsert( ( xList * ) pxDelayedTaskList, ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
-			}
+			prvAddCurrentTaskToDelayedList( xTimeToWake );
 		}
 	}
 	#else
@@ -1677,21 +2151,56 @@ portTickType xTimeToWake;
 			/* Calculate the time at which the task should be woken if the event does
 			not occur.  This may overflow but this doesn't matter. */
 			xTimeToWake = xTickCount + xTicksToWait;
+			prvAddCurrentTaskToDelayedList( xTimeToWake );
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
 
-			listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xGenericListItem ), xTimeToWake );
+signed portBASE_TYPE xTaskRemoveFromUnorderedEventList( xListItem * pxEventListItem, portTickType xItemValue )
+{
+tskTCB *pxUnblockedTCB;
+portBASE_TYPE xReturn;
 
-			if( xTimeToWake < xTickCount )
-			{
-				/* Wake time has overflowed.  Place this item in the overflow list. */
-				vListInsert( ( xList * ) pxOverflowDelayedTaskList, ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
-			}
-			else
-			{
-				/* The wake time has not overflowed, so we can use the current block list. */
-				vListInsert( ( xList * ) pxDelayedTaskList, ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
-			}
+	/* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  The ready
+	and delayed lists can be accessed: the interrupts use the pending ready
+	list while the scheduler is suspended. */
+
+	/* Tell the task why it was woken, e.g. the bits that were set. */
+	listSET_LIST_ITEM_VALUE( pxEventListItem, xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+
+	pxUnblockedTCB = ( tskTCB * ) listGET_LIST_ITEM_OWNER( pxEventListItem );
+	vListRemove( pxEventListItem );
+
+	vListRemove( &( pxUnblockedTCB->xGenericListItem ) );
+	prvAddTaskToReadyQueue( pxUnblockedTCB );
+
+	if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+	{
+		/* Switch as soon as the scheduler is resumed. */
+		xMissedYield = pdTRUE;
+		xReturn = pdTRUE;
 	}
-	#endif
+	else
+	{
+		xReturn = pdFALSE;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+portTickType uxTaskResetEventItemValue( void )
+{
+portTickType uxReturn;
+
+	uxReturn = listGET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ) );
+
+	/* The task is running, it is not in an event list: give the item back
+	its priority value for the queues. */
+	listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), ( ( portTickType ) configMAX_PRIORITIES - ( portTickType ) pxCurrentTCB->uxPriority ) );
+
+	return uxReturn;
 }
 /*-----------------------------------------------------------*/
 
@@ -1846,6 +2355,34 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 		}
 		#endif
 
+		#if ( configUSE_TICKLESS_IDLE == 1 )
+		{
+		portTickType xExpectedIdleTime;
+
+			/* A first test without suspending the scheduler, so the
+			scheduler is not suspended and resumed all the time when the
+			next wake time is close. */
+			xExpectedIdleTime = prvGetExpectedIdleTime();
+
+			if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
+			{
+				vTaskSuspendAll();
+				{
+					/* The delayed lists cannot change now, except from
+					interrupts through the pending ready list, which the
+					port checks with eTaskConfirmSleepModeStatus(). */
+					xExpectedIdleTime = prvGetExpectedIdleTime();
+
+					if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
+					{
+						portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime );
+					}
+				}
+				( void ) xTaskResumeAll();
+			}
+		}
+		#endif
+
 		#if ( configUSE_IDLE_HOOK == 1 )
 		{
 			extern void vApplicationIdleHook( void );
@@ -1871,6 +2408,74 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
  * File private functions documented at the top of the file.
  *----------------------------------------------------------*/
 
+#if ( configUSE_TICKLESS_IDLE == 1 )
+
+	static portTickType prvGetExpectedIdleTime( void )
+	{
+	portTickType xReturn;
+	tskTCB *pxTCB;
+
+		if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( unsigned portBASE_TYPE ) 1 )
+		{
+			/* Another task shares the idle priority and runs on the next
+			time slice. */
+			xReturn = ( portTickType ) 0;
+		}
+		else
+		{
+			#if ( configUSE_DELAY_WHEEL == 1 )
+			{
+			portTickType xTick = xTickCount;
+
+				/* Every task due before the next block start is in a level
+				one slot. */
+				( void ) pxTCB;
+				do
+				{
+					xTick++;
+				} while( ( ( xTick & tskWHEEL_MASK ) != ( portTickType ) 0 ) && listLIST_IS_EMPTY( &( xDelayWheel[ xTick & tskWHEEL_MASK ] ) ) );
+
+				xReturn = xTick - xTickCount;
+			}
+			#else
+			{
+				if( listLIST_IS_EMPTY( pxDelayedTaskList ) )
+				{
+					/* Tasks delayed past the wrap are in the overflow list.
+					Stop at the wrap so a real tick swaps the lists. */
+					xReturn = portMAX_DELAY - xTickCount;
+				}
+				else
+				{
+					/* The list is ordered by wake time. */
+					pxTCB = ( tskTCB * ) listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList );
+					xReturn = listGET_LIST_ITEM_VALUE( &( pxTCB->xGenericListItem ) ) - xTickCount;
+				}
+			}
+			#endif
+		}
+
+		#if ( configUSE_CO_ROUTINES == 1 )
+		{
+		portTickType xCoRoutineIdleTime;
+
+			/* The delayed co-routines are woken by the idle hook, not by the
+			tick. */
+			xCoRoutineIdleTime = xCoRoutineGetExpectedIdleTime();
+
+			if( xCoRoutineIdleTime < xReturn )
+			{
+				xReturn = xCoRoutineIdleTime;
+			}
+		}
+		#endif
+
+		return xReturn;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
 
 
 static void prvInitialiseTCBVariables( tskTCB *pxTCB, const signed char * const pcName, unsigned portBASE_TYPE uxPriority, const xMemoryRegion * const xRegions, unsigned short usStackDepth )
@@ -1921,12 +2526,31 @@ static void prvInitialiseTCBVariables( tskTCB *pxTCB, const signed char * const
 	}
 	#endif
 
+	#if ( configGENERATE_STACK_STATS == 1 )
+	{
+		pxTCB->usStackDepth = usStackDepth;
+	}
+	#endif
+
 	#if ( configGENERATE_RUN_TIME_STATS == 1 )
 	{
 		pxTCB->ulRunTimeCounter = 0UL;
 	}
 	#endif
 
+	#if ( configGENERATE_CYCLE_STATS == 1 )
+	{
+		pxTCB->ullCycleCounter = 0ULL;
+	}
+	#endif
+
+	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+	{
+		pxTCB->ulNotifiedValue = 0UL;
+		pxTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+	}
+	#endif
+
 	#if ( portUSING_MPU_WRAPPERS == 1 )
 	{
 		vPortStoreTaskMPUSettings( &( pxTCB->xMPUSettings ), xRegions, pxTCB->pxStack, usStackDepth );
@@ -1940,6 +2564,122 @@ static void prvInitialiseTCBVariables( tskTCB *pxTCB, const signed char * const
 }
 /*-----------------------------------------------------------*/
 
+static void prvAddCurrentTaskToDelayedList( portTickType xTimeToWake )
+{
+	/* The list item will be inserted in wake time order. */
+	listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xGenericListItem ), xTimeToWake );
+
+	#if ( configUSE_DELAY_WHEEL == 1 )
+	{
+		/* A task due on the current tick is woken by the next one, as it
+		would be from the sorted list. */
+		if( xTimeToWake == xTickCount )
+		{
+			xTimeToWake++;
+		}
+		prvDelayWheelInsert( ( xListItem * ) &( pxCurrentTCB->xGenericListItem ), xTimeToWake, xTickCount + ( portTickType ) 1 );
+	}
+	#else
+	{
+		if( xTimeToWake < xTickCount )
+		{
+			/* Wake time has overflowed.  Place this item in the overflow list. */
+			vListInsert( ( xList * ) pxOverflowDelayedTaskList, ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
+		}
+		else
+		{
+			/* The wake time has not overflowed, so we can use the current block list. */
+			vListInsert( ( xList * ) pxDelayedTaskList, ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
+		}
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_DELAY_WHEEL == 1 )
+
+	static void prvDelayWheelInsert( xListItem *pxItem, portTickType xTimeToWake, portTickType xNextTick )
+	{
+	portTickType xDelta, xBlocks;
+	unsigned portBASE_TYPE uxList;
+
+		/* Blocks from the one of xNextTick to the one of xTimeToWake,
+		written so that it does not overflow. */
+		xDelta = xTimeToWake - xNextTick;
+		xBlocks = ( xDelta >> configDELAY_WHEEL_BITS ) + ( ( ( xNextTick & tskWHEEL_MASK ) + ( xDelta & tskWHEEL_MASK ) ) >> configDELAY_WHEEL_BITS );
+
+		if( xBlocks == ( portTickType ) 0 )
+		{
+			/* Due before the block ends. */
+			uxList = ( unsigned portBASE_TYPE ) ( xTimeToWake & tskWHEEL_MASK );
+		}
+		else if( xBlocks < tskWHEEL_SLOTS )
+		{
+			/* Not the slot of the block of xNextTick, that one may still have
+			to be spread over level one. */
+			uxList = ( unsigned portBASE_TYPE ) ( tskWHEEL_LEVEL_TWO + ( ( xTimeToWake >> configDELAY_WHEEL_BITS ) & tskWHEEL_MASK ) );
+		}
+		else
+		{
+			uxList = ( unsigned portBASE_TYPE ) tskWHEEL_FAR;
+		}
+
+		vListInsertEnd( &( xDelayWheel[ uxList ] ), pxItem );
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvDelayWheelTick( void )
+	{
+	xList *pxList;
+	xListItem *pxItem;
+	tskTCB *pxTCB;
+	portTickType xBlock;
+	unsigned portBASE_TYPE uxItems;
+
+		if( ( xTickCount & tskWHEEL_MASK ) == ( portTickType ) 0 )
+		{
+			xBlock = ( xTickCount >> configDELAY_WHEEL_BITS ) & tskWHEEL_MASK;
+
+			/* The far list first, its tasks due in this block go to level
+			one, the rest to level two or back to the far list. */
+			if( xBlock == ( portTickType ) 0 )
+			{
+				pxList = &( xDelayWheel[ tskWHEEL_FAR ] );
+				for( uxItems = listCURRENT_LIST_LENGTH( pxList ); uxItems > ( unsigned portBASE_TYPE ) 0; uxItems-- )
+				{
+					pxItem = ( xListItem * ) pxList->xListEnd.pxNext;
+					vListRemove( pxItem );
+					prvDelayWheelInsert( pxItem, listGET_LIST_ITEM_VALUE( pxItem ), xTickCount );
+				}
+			}
+
+			/* Every task of the level two slot is due in this block. */
+			pxList = &( xDelayWheel[ tskWHEEL_LEVEL_TWO + xBlock ] );
+			while( !listLIST_IS_EMPTY( pxList ) )
+			{
+				pxItem = ( xListItem * ) pxList->xListEnd.pxNext;
+				vListRemove( pxItem );
+				vListInsertEnd( &( xDelayWheel[ listGET_LIST_ITEM_VALUE( pxItem ) & tskWHEEL_MASK ] ), pxItem );
+			}
+		}
+
+		/* Every task of the level one slot is due now. */
+		pxList = &( xDelayWheel[ xTickCount & tskWHEEL_MASK ] );
+		while( ( pxTCB = ( tskTCB * ) listGET_OWNER_OF_HEAD_ENTRY( pxList ) ) != NULL )
+		{
+			vListRemove( &( pxTCB->xGenericListItem ) );
+			/* Is the task waiting on an event also? */
+			if( pxTCB->xEventListItem.pvContainer )
+			{
+				vListRemove( &( pxTCB->xEventListItem ) );
+			}
+			prvAddTaskToReadyQueue( pxTCB );
+		}
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
 #if ( portUSING_MPU_WRAPPERS == 1 )
 
 	void vTaskAllocateMPURegions( xTaskHandle xTaskToModify, const xMemoryRegion * const xRegions )
@@ -1968,8 +2708,19 @@ unsigned portBASE_TYPE uxPriority;
 		vListInitialise( ( xList * ) &( pxReadyTasksLists[ uxPriority ] ) );
 	}
 
-	vListInitialise( ( xList * ) &xDelayedTaskList1 );
-	vListInitialise( ( xList * ) &xDelayedTaskList2 );
+	#if ( configUSE_DELAY_WHEEL == 1 )
+	{
+		for( uxPriority = 0; uxPriority < tskWHEEL_LISTS; uxPriority++ )
+		{
+			vListInitialise( &( xDelayWheel[ uxPriority ] ) );
+		}
+	}
+	#else
+	{
+		vListInitialise( ( xList * ) &xDelayedTaskList1 );
+		vListInitialise( ( xList * ) &xDelayedTaskList2 );
+	}
+	#endif
 	vListInitialise( ( xList * ) &xPendingReadyList );
 
 	#if ( INCLUDE_vTaskDelete == 1 )
@@ -1984,10 +2735,14 @@ unsigned portBASE_TYPE uxPriority;
 	}
 	#endif
 
-	/* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
-	using list2. */
-	pxDelayedTaskList = &xDelayedTaskList1;
-	pxOverflowDelayedTaskList = &xDelayedTaskList2;
+	#if ( configUSE_DELAY_WHEEL == 0 )
+	{
+		/* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
+		using list2. */
+		pxDelayedTaskList = &xDelayedTaskList1;
+		pxOverflowDelayedTaskList = &xDelayedTaskList2;
+	}
+	#endif
 }
 /*-----------------------------------------------------------*/
 
@@ -2026,24 +2781,66 @@ static void prvCheckTasksWaitingTermination( void )
 }
 /*-----------------------------------------------------------*/
 
-static tskTCB *prvAllocateTCBAndStack( unsigned short usStackDepth, portSTACK_TYPE *puxStackBuffer )
+static tskTCB *prvAllocateTCBAndStack( unsigned short usStackDepth, portSTACK_TYPE *puxStackBuffer, xStaticTask * const pxTaskBuffer )
 {
 tskTCB *pxNewTCB;
 
-	/* Allocate space for the TCB.  Where the memory comes from depends on
-	the implementation of the port malloc function. */
-	pxNewTCB = ( tskTCB * ) pvPortMalloc( sizeof( tskTCB ) );
-
-	if( pxNewTCB != NULL )
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
 	{
-		/* Allocate space for the stack used by the task being created.
-		The base of the stack memory stored in the TCB so the task can
-		be deleted later if required. */
-		pxNewTCB->pxStack = ( portSTACK_TYPE * ) pvPortMallocAligned( ( ( ( size_t )usStackDepth ) * sizeof( portSTACK_TYPE ) ), puxStackBuffer );
-
-		if( pxNewTCB->pxStack == NULL )
+		if( pxTaskBuffer != NULL )
 		{
-			/* Could not allocate the stack.  Delete the allocated TCB. */
+			/* The TCB and the stack are provided by the caller, both are
+			required. */
+			if( puxStackBuffer == NULL )
+			{
+				return NULL;
+			}
+
+			pxNewTCB = ( tskTCB * ) pxTaskBuffer;
+			pxNewTCB->pxStack = puxStackBuffer;
+			pxNewTCB->ucStaticallyAllocated = tskSTATICALLY_ALLOCATED_STACK_AND_TCB;
+
+			/* Just to help debugging. */
+			memset( pxNewTCB->pxStack, tskSTACK_FILL_BYTE, usStackDepth * sizeof( portSTACK_TYPE ) );
+
+			return pxNewTCB;
+		}
+	}
+	#else
+	{
+		( void ) pxTaskBuffer;
+	}
+	#endif
+
+	/* Allocate space for the TCB.  Where the memory comes from depends on
+	the implementation of the port malloc function. */
+	pxNewTCB = ( tskTCB * ) pvPortMalloc( sizeof( tskTCB ) );
+
+	if( pxNewTCB != NULL )
+	{
+		#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		{
+			/* A stack buffer passed in by the caller is not freed with the
+			TCB. */
+			if( puxStackBuffer != NULL )
+			{
+				pxNewTCB->ucStaticallyAllocated = tskSTATICALLY_ALLOCATED_STACK_ONLY;
+			}
+			else
+			{
+				pxNewTCB->ucStaticallyAllocated = tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB;
+			}
+		}
+		#endif
+
+		/* Allocate space for the stack used by the task being created.
+		The base of the stack memory stored in the TCB so the task can
+		be deleted later if required. */
+		pxNewTCB->pxStack = ( portSTACK_TYPE * ) pvPortMallocAligned( ( ( ( size_t )usStackDepth ) * sizeof( portSTACK_TYPE ) ), puxStackBuffer );
+
+		if( pxNewTCB->pxStack == NULL )
+		{
+			/* Could not allocate the stack.  Delete the allocated TCB. */
 			vPortFree( pxNewTCB );
 			pxNewTCB = NULL;
 		}
@@ -2139,6 +2936,63 @@ tskTCB *pxNewTCB;
 #endif
 /*-----------------------------------------------------------*/
 
+#if ( configGENERATE_CYCLE_STATS == 1 )
+
+	static unsigned portBASE_TYPE prvCycleStatsWithinSingleList( xTaskCycleStats *pxStats, unsigned portBASE_TYPE uxIndex, unsigned portBASE_TYPE uxMaxTasks, xList *pxList )
+	{
+	volatile tskTCB *pxNextTCB, *pxFirstTCB;
+
+		listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList );
+		do
+		{
+			listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList );
+
+			if( uxIndex < uxMaxTasks )
+			{
+				pxStats[ uxIndex ].xHandle = ( xTaskHandle ) pxNextTCB;
+				pxStats[ uxIndex ].pcTaskName = ( const signed char * ) pxNextTCB->pcTaskName;
+				pxStats[ uxIndex ].uxPriority = pxNextTCB->uxPriority;
+				pxStats[ uxIndex ].ullCycles = pxNextTCB->ullCycleCounter;
+				uxIndex++;
+			}
+
+		} while( pxNextTCB != pxFirstTCB );
+
+		return uxIndex;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configGENERATE_STACK_STATS == 1 )
+
+	static unsigned portBASE_TYPE prvStackStatsWithinSingleList( xTaskStackStats *pxStats, unsigned portBASE_TYPE uxIndex, unsigned portBASE_TYPE uxMaxTasks, xList *pxList )
+	{
+	volatile tskTCB *pxNextTCB, *pxFirstTCB;
+
+		listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList );
+		do
+		{
+			listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList );
+
+			if( uxIndex < uxMaxTasks )
+			{
+				pxStats[ uxIndex ].xHandle = ( xTaskHandle ) pxNextTCB;
+				pxStats[ uxIndex ].pcTaskName = ( const signed char * ) pxNextTCB->pcTaskName;
+				pxStats[ uxIndex ].uxPriority = pxNextTCB->uxPriority;
+				pxStats[ uxIndex ].usStackDepth = pxNextTCB->usStackDepth;
+				pxStats[ uxIndex ].usHighWaterMark = ( unsigned short ) uxTaskGetStackHighWaterMark( ( xTaskHandle ) pxNextTCB );
+				uxIndex++;
+			}
+
+		} while( pxNextTCB != pxFirstTCB );
+
+		return uxIndex;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
 #if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) )
 
 	static unsigned short usTaskCheckFreeStackSpace( const unsigned char * pucStackByte )
@@ -2193,8 +3047,25 @@ tskTCB *pxNewTCB;
 	{
 		/* Free up the memory allocated by the scheduler for the task.  It is up to
 		the task to free any memory allocated at the application level. */
-		vPortFreeAligned( pxTCB->pxStack );
-		vPortFree( pxTCB );
+		#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		{
+			/* Memory provided by the application is left alone. */
+			if( pxTCB->ucStaticallyAllocated == tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB )
+			{
+				vPortFreeAligned( pxTCB->pxStack );
+				vPortFree( pxTCB );
+			}
+			else if( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_ONLY )
+			{
+				vPortFree( pxTCB );
+			}
+		}
+		#else
+		{
+			vPortFreeAligned( pxTCB->pxStack );
+			vPortFree( pxTCB );
+		}
+		#endif
 	}
 
 #endif
@@ -2220,6 +3091,23 @@ tskTCB *pxNewTCB;
 
 /*-----------------------------------------------------------*/
 
+#if ( INCLUDE_pcTaskGetTaskName == 1 )
+
+	signed char *pcTaskGetTaskName( xTaskHandle xTaskToQuery )
+	{
+	tskTCB *pxTCB;
+
+		/* The name is not changed after the task is created, no critical
+		section is needed. */
+		pxTCB = prvGetTCBFromHandle( xTaskToQuery );
+
+		return &( pxTCB->pcTaskName[ 0 ] );
+	}
+
+#endif
+
+/*-----------------------------------------------------------*/
+
 #if ( INCLUDE_xTaskGetSchedulerState == 1 )
 
 	portBASE_TYPE xTaskGetSchedulerState( void )
@@ -2256,14 +3144,19 @@ tskTCB *pxNewTCB;
 
 		if( pxTCB->uxPriority < pxCurrentTCB->uxPriority )
 		{
-			/* Adjust the mutex holder state to account for its new priority. */
-			listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), configMAX_PRIORITIES - ( portTickType ) pxCurrentTCB->uxPriority );
+			/* Adjust the mutex holder state to account for its new priority,
+			unless the holder waits in an event group. */
+			if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0 )
+			{
+				listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), configMAX_PRIORITIES - ( portTickType ) pxCurrentTCB->uxPriority );
+			}
 
 			/* If the task being modified is in the ready state it will need to
 			be moved in to a new list. */
 			if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xGenericListItem ) ) )
 			{
 				vListRemove( &( pxTCB->xGenericListItem ) );
+				taskRESET_READY_PRIORITY( pxTCB->uxPriority );
 
 				/* Inherit the priority before being moved into the new list. */
 				pxTCB->uxPriority = pxCurrentTCB->uxPriority;
@@ -2293,6 +3186,7 @@ tskTCB *pxNewTCB;
 				/* We must be the running task to be able to give the mutex back.
 				Remove ourselves from the ready list we currently appear in. */
 				vListRemove( &( pxTCB->xGenericListItem ) );
+				taskRESET_READY_PRIORITY( pxTCB->uxPriority );
 
 				/* Disinherit the priority before adding ourselves into the new
 				ready list. */
@@ -2306,6 +3200,318 @@ tskTCB *pxNewTCB;
 #endif
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	static portBASE_TYPE prvNotifyUnblockTask( tskTCB *pxTCB )
+	{
+		if( uxSchedulerSuspended == ( unsigned portBASE_TYPE ) pdFALSE )
+		{
+			/* The task is in a delayed list or, when blocked without a
+			timeout, in the suspended list. */
+			vListRemove( &( pxTCB->xGenericListItem ) );
+			prvAddTaskToReadyQueue( pxTCB );
+		}
+		else
+		{
+			/* The delayed and ready lists cannot be accessed, the task is
+			moved when the scheduler is resumed. */
+			vListInsertEnd( ( xList * ) &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+		}
+
+		return ( pxTCB->uxPriority > pxCurrentTCB->uxPriority ) ? pdTRUE : pdFALSE;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	static void prvNotifyBlockCurrentTask( portTickType xTicksToWait )
+	{
+		/* Interrupts are disabled, the ready lists can be accessed directly.
+		The same list item is used for the ready and the blocked lists. */
+		vListRemove( ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
+		taskRESET_READY_PRIORITY( pxCurrentTCB->uxPriority );
+
+		#if ( INCLUDE_vTaskSuspend == 1 )
+		{
+			if( xTicksToWait == portMAX_DELAY )
+			{
+				/* Block without a timeout. */
+				vListInsertEnd( ( xList * ) &xSuspendedTaskList, ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
+			}
+			else
+			{
+				prvAddCurrentTaskToDelayedList( xTickCount + xTicksToWait );
+			}
+		}
+		#else
+		{
+			prvAddCurrentTaskToDelayedList( xTickCount + xTicksToWait );
+		}
+		#endif
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	/* Update the notification value of pxTCB as selected by eAction.  Must be
+	called with interrupts disabled. */
+	static portBASE_TYPE prvNotifyUpdateValue( tskTCB *pxTCB, unsigned long ulValue, eNotifyAction eAction )
+	{
+	portBASE_TYPE xReturn = pdPASS;
+
+		switch( eAction )
+		{
+			case eSetBits :
+				pxTCB->ulNotifiedValue |= ulValue;
+				break;
+
+			case eIncrement :
+				( pxTCB->ulNotifiedValue )++;
+				break;
+
+			case eSetValueWithOverwrite :
+				pxTCB->ulNotifiedValue = ulValue;
+				break;
+
+			case eSetValueWithoutOverwrite :
+				if( pxTCB->ucNotifyState != taskNOTIFICATION_RECEIVED )
+				{
+					pxTCB->ulNotifiedValue = ulValue;
+				}
+				else
+				{
+					/* The value could not be written to the task. */
+					xReturn = pdFAIL;
+				}
+				break;
+
+			case eNoAction :
+			default :
+				/* The task is being notified without its notify value being
+				updated. */
+				break;
+		}
+
+		return xReturn;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	portBASE_TYPE xTaskNotify( xTaskHandle xTaskToNotify, unsigned long ulValue, eNotifyAction eAction )
+	{
+	tskTCB * pxTCB = ( tskTCB * ) xTaskToNotify;
+	portBASE_TYPE xReturn;
+	portBASE_TYPE xYieldRequired = pdFALSE;
+	unsigned char ucOriginalNotifyState;
+
+		portENTER_CRITICAL();
+		{
+			ucOriginalNotifyState = pxTCB->ucNotifyState;
+
+			xReturn = prvNotifyUpdateValue( pxTCB, ulValue, eAction );
+			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+
+			/* If the task is blocked waiting for a notification then unblock
+			it now. */
+			if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
+			{
+				xYieldRequired = prvNotifyUnblockTask( pxTCB );
+			}
+		}
+		portEXIT_CRITICAL();
+
+		if( xYieldRequired == pdTRUE )
+		{
+			portYIELD_WITHIN_API();
+		}
+
+		return xReturn;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	portBASE_TYPE xTaskNotifyFromISR( xTaskHandle xTaskToNotify, unsigned long ulValue, eNotifyAction eAction, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+	{
+	tskTCB * pxTCB = ( tskTCB * ) xTaskToNotify;
+	portBASE_TYPE xReturn;
+	unsigned char ucOriginalNotifyState;
+	unsigned portBASE_TYPE uxSavedInterruptStatus;
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			ucOriginalNotifyState = pxTCB->ucNotifyState;
+
+			xReturn = prvNotifyUpdateValue( pxTCB, ulValue, eAction );
+			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+
+			if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
+			{
+				if( prvNotifyUnblockTask( pxTCB ) == pdTRUE )
+				{
+					/* The notified task has a priority above the currently
+					executing task so a yield is required. */
+					if( pxHigherPriorityTaskWoken != NULL )
+					{
+						*pxHigherPriorityTaskWoken = pdTRUE;
+					}
+				}
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		return xReturn;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	void vTaskNotifyGiveFromISR( xTaskHandle xTaskToNotify, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+	{
+		( void ) xTaskNotifyFromISR( xTaskToNotify, 0, eIncrement, pxHigherPriorityTaskWoken );
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	portBASE_TYPE xTaskNotifyWait( unsigned long ulBitsToClearOnEntry, unsigned long ulBitsToClearOnExit, unsigned long *pulNotificationValue, portTickType xTicksToWait )
+	{
+	portBASE_TYPE xReturn;
+	portBASE_TYPE xYieldRequired = pdFALSE;
+
+		portENTER_CRITICAL();
+		{
+			/* Only block if a notification is not already pending. */
+			if( pxCurrentTCB->ucNotifyState != taskNOTIFICATION_RECEIVED )
+			{
+				/* Clear bits in the task's notification value as bits may get
+				set	by the notifying task or interrupt.  This can be used to
+				clear the value to zero. */
+				pxCurrentTCB->ulNotifiedValue &= ~ulBitsToClearOnEntry;
+
+				/* Mark this task as waiting for a notification. */
+				pxCurrentTCB->ucNotifyState = taskWAITING_NOTIFICATION;
+
+				if( xTicksToWait > ( portTickType ) 0 )
+				{
+					prvNotifyBlockCurrentTask( xTicksToWait );
+					xYieldRequired = pdTRUE;
+				}
+			}
+		}
+		portEXIT_CRITICAL();
+
+		/* The task is not in a ready list any more, it runs again when it is
+		notified or the timeout expires. */
+		if( xYieldRequired == pdTRUE )
+		{
+			portYIELD_WITHIN_API();
+		}
+
+		portENTER_CRITICAL();
+		{
+			if( pulNotificationValue != NULL )
+			{
+				/* Output the current notification value, which may or may not
+				have changed. */
+				*pulNotificationValue = pxCurrentTCB->ulNotifiedValue;
+			}
+
+			/* If ucNotifyValue is set then either the task never entered the
+			blocked state (because a notification was already pending) or the
+			task unblocked because of a notification.  Otherwise the task
+			unblocked because of a timeout. */
+			if( pxCurrentTCB->ucNotifyState != taskNOTIFICATION_RECEIVED )
+			{
+				/* A notification was not received. */
+				xReturn = pdFALSE;
+			}
+			else
+			{
+				/* A notification was already pending or a notification was
+				received while the task was waiting. */
+				pxCurrentTCB->ulNotifiedValue &= ~ulBitsToClearOnExit;
+				xReturn = pdTRUE;
+			}
+
+			pxCurrentTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+		}
+		portEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	unsigned long ulTaskNotifyTake( portBASE_TYPE xClearCountOnExit, portTickType xTicksToWait )
+	{
+	unsigned long ulReturn;
+	portBASE_TYPE xYieldRequired = pdFALSE;
+
+		portENTER_CRITICAL();
+		{
+			/* Only block if the notification count is not already non-zero. */
+			if( pxCurrentTCB->ulNotifiedValue == 0UL )
+			{
+				/* Mark this task as waiting for a notification. */
+				pxCurrentTCB->ucNotifyState = taskWAITING_NOTIFICATION;
+
+				if( xTicksToWait > ( portTickType ) 0 )
+				{
+					prvNotifyBlockCurrentTask( xTicksToWait );
+					xYieldRequired = pdTRUE;
+				}
+			}
+		}
+		portEXIT_CRITICAL();
+
+		if( xYieldRequired == pdTRUE )
+		{
+			portYIELD_WITHIN_API();
+		}
+
+		portENTER_CRITICAL();
+		{
+			ulReturn = pxCurrentTCB->ulNotifiedValue;
+
+			if( ulReturn != 0UL )
+			{
+				if( xClearCountOnExit != pdFALSE )
+				{
+					pxCurrentTCB->ulNotifiedValue = 0UL;
+				}
+				else
+				{
+					pxCurrentTCB->ulNotifiedValue = ulReturn - 1;
+				}
+			}
+
+			pxCurrentTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+		}
+		portEXIT_CRITICAL();
+
+		return ulReturn;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
 #if ( portCRITICAL_NESTING_IN_TCB == 1 )
 
 	void vTaskEnterCritical( void )
@@ -0,0 +1,140 @@
+// This is free and unencumbered software released into the public domain.
+//
+// Anyone is free to copy, modify, publish, use, compile, sell, or
+// distribute this software, either in source code form or as a compiled
+// binary, for any purpose, commercial or non-commercial, and by any
+// means.
+
+#include <stddef.h>
+#include <string.h>
+#include <system.h>
+#include <ring.h>
+
+int ring_init(struct ring *r, void *buf, unsigned int entries,
+		unsigned int esize)
+{
+	if (entries == 0 || (entries & (entries - 1)) != 0)
+		return -1;
+
+	r->buf = buf;
+	r->esize = esize;
+	r->mask = entries - 1;
+	r->head = 0;
+	r->tail = 0;
+	return 0;
+}
+
+// copy n entries from the ring index i on, in at most two pieces
+static void ring_copy_in(struct ring *r, unsigned int i, const void *src,
+		unsigned int n)
+{
+	unsigned int off = i & r->mask;
+	unsigned int first = r->mask + 1 - off;
+
+	if (first > n)
+		first = n;
+	memcpy(r->buf + off * r->esize, src, first * r->esize);
+	if (n > first)
+		memcpy(r->buf, (const unsigned char *)src + first * r->esize,
+			(n - first) * r->esize);
+}
+
+static void ring_copy_out(struct ring *r, unsigned int i, void *dst,
+		unsigned int n)
+{
+	unsigned int off = i & r->mask;
+	unsigned int first = r->mask + 1 - off;
+
+	if (first > n)
+		first = n;
+	memcpy(dst, r->buf + off * r->esize, first * r->esize);
+	if (n > first)
+		memcpy((unsigned char *)dst + first * r->esize, r->buf,
+			(n - first) * r->esize);
+}
+
+unsigned int ring_enqueue(struct ring *r, const void *src, unsigned int n)
+{
+	unsigned int tail = r->tail;
+	unsigned int space = r->mask + 1 - (tail - r->head);
+
+	if (n > space)
+		n = space;
+	if (n == 0)
+		return 0;
+
+	ring_copy_in(r, tail, src, n);
+	// the entries are written before the consumer can see them
+	barrier();
+	r->tail = tail + n;
+	return n;
+}
+
+unsigned int ring_dequeue(struct ring *r, void *dst, unsigned int n)
+{
+	unsigned int head = r->head;
+	unsigned int count = r->tail - head;
+
+	if (n > count)
+		n = count;
+	if (n == 0)
+		return 0;
+
+	// the tail is read before the entries it covers
+	barrier();
+	ring_copy_out(r, head, dst, n);
+	// and the entries are read before the producer may overwrite them
+	barrier();
+	r->head = head + n;
+	return n;
+}
+
+void *ring_write_peek(struct ring *r, unsigned int *n)
+{
+	unsigned int tail = r->tail;
+	unsigned int off = tail & r->mask;
+	unsigned int space = r->mask + 1 - (tail - r->head);
+
+	if (space > r->mask + 1 - off)
+		space = r->mask + 1 - off;
+	*n = space;
+	return r->buf + off * r->esize;
+}
+
+void ring_write_commit(struct ring *r, unsigned int n)
+{
+	barrier();
+	r->tail += n;
+}
+
+void *ring_read_peek(struct ring *r, unsigned int *n)
+{
+	unsigned int head = r->head;
+	unsigned int off = head & r->mask;
+	unsigned int count = r->tail - head;
+
+	if (count > r->mask + 1 - off)
+		count = r->mask + 1 - off;
+	*n = count;
+	barrier();
+	return r->buf + off * r->esize;
+}
+
+void ring_read_commit(struct ring *r, unsigned int n)
+{
+	barrier();
+	r->head += n;
+}
+
+unsigned int ring_mp_enqueue(struct ring *r, const void *src, unsigned int n)
+{
+	unsigned int flags;
+
+	// the copy is done with irq masked too: a producer that reserved
+	// entries and was preempted before filling them would hold back the
+	// tail of all the others
+	flags = __irq_save();
+	n = ring_enqueue(r, src, n);
+	__irq_restore(flags);
+	return n;
+}
@@ -535,3 +535,23 @@ int bcmp(const char *s1, const char *s2, size_t len)
 	return len;
 }
 
+
+/** Compare two memory areas.
+ *
+ * @param s1		Pointer to the first area to compare.
+ * @param s2		Pointer to the second area to compare.
+ * @param len		Size of both areas in bytes.
+ * @return		Zero if the areas match, otherwise the difference of
+ * 			the first differing bytes taken as unsigned char.
+ */
+int memcmp(const void *s1, const void *s2, size_t len)
+{
+	const unsigned char *p1 = s1;
+	const unsigned char *p2 = s2;
+
+	for (; len; len--, p1++, p2++) {
+		if (*p1 != *p2)
+			return *p1 - *p2;
+	}
+	return 0;
+}
@@ -91,10 +91,57 @@
 /* Scheduler includes. */
 #include "FreeRTOS.h"
 #include "task.h"
+#include "croutine.h"
 
 /* Hardware specific definitions. */
 #include "system.h"
 
+/* Demo application includes. */
+#include "qbench.h"
+#include "dbench.h"
+#include "ybench.h"
+#include "cbench.h"
+#include "ibench.h"
+#include "mbench.h"
+#include "rbench.h"
+#include "fbench.h"
+#include "sbench.h"
+#include "lbench.h"
+
+/* Set to 1 to run the queue throughput benchmark, see demo/qbench.c. */
+#define mainQUEUE_BENCH		0
+
+/* Set to 1 to run the delayed task list benchmark, see demo/dbench.c. */
+#define mainDELAY_BENCH		0
+
+/* Set to 1 to run the context switch ping-pong benchmark, see demo/ybench.c. */
+#define mainYIELD_BENCH		0
+
+/* Set to 1 to run the co-routine benchmark, see demo/cbench.c. */
+#define mainCOROUTINE_BENCH	0
+
+/* Set to 1 to run the critical section benchmark, see demo/ibench.c. */
+#define mainCRITICAL_BENCH	0
+
+/* Set to 1 to run the mutex priority inheritance check and benchmark, see
+demo/mbench.c. */
+#define mainMUTEX_BENCH		0
+
+/* Set to 1 to run the ring buffer benchmark and stress test, see
+demo/rbench.c. */
+#define mainRING_BENCH		0
+
+/* Set to 1 to run the instruction fetch benchmark, see demo/fbench.c. */
+#define mainFETCH_BENCH		0
+
+/* Set to 1 to run the SRAM memcpy benchmark, see demo/sbench.c. */
+#define mainSRAM_BENCH		0
+
+/* make IRQ_BENCH=1 runs the irq latency benchmark, see demo/lbench.c. */
+#ifndef mainIRQ_BENCH
+#define mainIRQ_BENCH		0
+#endif
+
 
 /*-----------------------------------------------------------*/
 
@@ -106,10 +153,48 @@ static void prvSetupHardware( void );
 
 /*-----------------------------------------------------------*/
 
+/*
+ * TCBs and stacks of the test tasks, in .bss so creating the tasks does not
+ * use the heap.  Add __sram1 to move a buffer to SRAM1.
+ */
+#define mainTEST_TASKS		4
+
+static xStaticTask xTestTaskTCB[ mainTEST_TASKS ];
+static portSTACK_TYPE xTestTaskStack[ mainTEST_TASKS ][ configMINIMAL_STACK_SIZE ];
+
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_IDLE_HOOK == 1 )
+void vApplicationIdleHook( void )
+{
+	#if ( configUSE_CO_ROUTINES == 1 )
+	{
+		/* Runs one co-routine per pass of the idle task. */
+		vCoRoutineSchedule();
+	}
+	#endif
+}
+#endif
+
 #if ( configUSE_TICK_HOOK == 1 )
 void vApplicationTickHook( void )
 {
+	#if ( mainIRQ_BENCH == 1 )
+	{
+		vIrqBenchTick();
+	}
+	#endif
+}
+#endif
+
+#if ( configCHECK_FOR_STACK_OVERFLOW > 0 )
+void vApplicationStackOverflowHook( xTaskHandle *pxTask, signed char *pcTaskName )
+{
+	( void ) pxTask;
 
+	/* Called on the switch out of the task, its stack and maybe the memory
+	below it are already corrupted. */
+	panic( "stack overflow in task %s\n", pcTaskName );
 }
 #endif
 
@@ -232,10 +317,70 @@ int main( void )
 	prvSetupHardware();
 
 	/* Create Tasks */
-	xTaskCreate( vTestFun1, ( signed portCHAR * ) "TestFun1", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, NULL );
-	xTaskCreate( vTestFun2, ( signed portCHAR * ) "TestFun2", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, NULL );
-	xTaskCreate( vTestFun3, ( signed portCHAR * ) "TestFun3", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, NULL );
-	xTaskCreate( vTestFun4, ( signed portCHAR * ) "TestFun4", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, NULL );
+	xTaskCreateStatic( vTestFun1, ( signed portCHAR * ) "TestFun1", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, NULL, xTestTaskStack[ 0 ], &xTestTaskTCB[ 0 ] );
+	xTaskCreateStatic( vTestFun2, ( signed portCHAR * ) "TestFun2", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, NULL, xTestTaskStack[ 1 ], &xTestTaskTCB[ 1 ] );
+	xTaskCreateStatic( vTestFun3, ( signed portCHAR * ) "TestFun3", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, NULL, xTestTaskStack[ 2 ], &xTestTaskTCB[ 2 ] );
+	xTaskCreateStatic( vTestFun4, ( signed portCHAR * ) "TestFun4", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, NULL, xTestTaskStack[ 3 ], &xTestTaskTCB[ 3 ] );
+
+	#if ( mainQUEUE_BENCH == 1 )
+	{
+		vStartQueueBench( tskIDLE_PRIORITY + 3 );
+	}
+	#endif
+
+	#if ( mainDELAY_BENCH == 1 )
+	{
+		vStartDelayBench( tskIDLE_PRIORITY + 2 );
+	}
+	#endif
+
+	#if ( mainYIELD_BENCH == 1 )
+	{
+		vStartYieldBench( tskIDLE_PRIORITY + 3 );
+	}
+	#endif
+
+	#if ( mainCOROUTINE_BENCH == 1 )
+	{
+		vStartCoRoutineBench( tskIDLE_PRIORITY + 2 );
+	}
+	#endif
+
+	#if ( mainCRITICAL_BENCH == 1 )
+	{
+		vStartCriticalBench( tskIDLE_PRIORITY + 2 );
+	}
+	#endif
+
+	#if ( mainMUTEX_BENCH == 1 )
+	{
+		vStartMutexBench( tskIDLE_PRIORITY + 2 );
+	}
+	#endif
+
+	#if ( mainRING_BENCH == 1 )
+	{
+		vStartRingBench( tskIDLE_PRIORITY + 2 );
+	}
+	#endif
+
+	#if ( mainFETCH_BENCH == 1 )
+	{
+		vStartFetchBench( tskIDLE_PRIORITY + 2 );
+	}
+	#endif
+
+	#if ( mainSRAM_BENCH == 1 )
+	{
+		vStartSramBench( tskIDLE_PRIORITY + 2 );
+	}
+	#endif
+
+	#if ( mainIRQ_BENCH == 1 )
+	{
+		vStartIrqBench( tskIDLE_PRIORITY + 2 );
+	}
+	#endif
 
 	/* Now all the tasks have been started - start the scheduler.
 
@@ -0,0 +1,50 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ */
+
+/*
+ * host stand-in for the system.h of the firmware, for the lib code built
+ * into the host tests
+ *
+ * the firmware runs on one in-order core, masking irq serialises all the
+ * code that can touch the data: here a single lock taken by every thread
+ * plays that part. an irq can preempt the code between any two accesses,
+ * every barrier() is a point where the test may give the cpu to another
+ * thread, so the windows between the barriers are hit on a one cpu host too
+ */
+
+#ifndef _HOST_SYSTEM_H_
+#define _HOST_SYSTEM_H_
+
+#include <pthread.h>
+
+#if !defined(__i386__) && !defined(__x86_64__)
+/* the firmware barrier() is a compiler barrier only, which orders the
+ * accesses of two threads as the core does only on a TSO host */
+#error the host tests need an x86 host
+#endif
+
+extern pthread_mutex_t host_irq_lock;
+extern void host_preempt_point(void);
+
+#define barrier()		do { \
+	__asm__ __volatile__("": : :"memory"); \
+	host_preempt_point(); \
+} while (0)
+
+static inline unsigned int __irq_save(void)
+{
+	pthread_mutex_lock(&host_irq_lock);
+	return 0;
+}
+
+static inline void __irq_restore(unsigned int flags)
+{
+	(void)flags;
+	pthread_mutex_unlock(&host_irq_lock);
+}
+
+#endif /* _HOST_SYSTEM_H_ */
@@ -0,0 +1,267 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ */
+
+/*
+ * decode the irq trace printed by irq_trace_dump() on the console
+ *
+ * IRQTRACE BEGIN <count> <clk hz>
+ * IRQTRACE <seq> <irq> <depth> <pc> <entry cycle> <exit cycle>
+ * IRQTRACE END
+ *
+ * and print per irq line statistics and log2 histograms of the handler
+ * time (entry to exit) and of the interval between two entries
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <getopt.h>
+
+#define NR_IRQS		32
+#define NR_BUCKETS	32
+#define NO_EXIT		0xffffffff
+
+struct irq_stat {
+	unsigned long cnt;
+	unsigned long nested;
+	uint32_t min;
+	uint32_t max;
+	uint64_t sum;
+	unsigned long hist[NR_BUCKETS];
+	/* interval between entries */
+	int has_last;
+	uint32_t last_entry;
+	unsigned long icnt;
+	uint32_t imin;
+	uint32_t imax;
+	uint64_t isum;
+	unsigned long ihist[NR_BUCKETS];
+};
+
+static struct irq_stat stats[NR_IRQS];
+static unsigned long clk_hz;
+static int verbose;
+
+static const char short_opts[] = "+vi:c:";
+static const struct option long_opts[] = {
+	{ "verbose", no_argument,       NULL, 'v' },
+	{ "if",      required_argument, NULL, 'i' },
+	{ "clk",     required_argument, NULL, 'c' },
+	{ NULL,      no_argument,       NULL, 0 }
+};
+
+static void print_usage(char *prog)
+{
+	printf("USAGE (decode irq trace from a console log):\n");
+	printf("%s [-v] [-c clk_hz] [-i console.log]\n", prog);
+}
+
+static int log2_bucket(uint32_t v)
+{
+	int b = 0;
+
+	while (v > 1 && b < NR_BUCKETS - 1) {
+		v >>= 1;
+		b++;
+	}
+	return b;
+}
+
+static double cyc2us(uint64_t cyc)
+{
+	if (clk_hz == 0)
+		return 0.0;
+	return (double)cyc * 1000000.0 / (double)clk_hz;
+}
+
+static void print_hist(const char *name, unsigned long *hist, unsigned long cnt)
+{
+	unsigned long peak = 0;
+	int i, j, first = -1, last = -1;
+
+	for (i = 0; i < NR_BUCKETS; i++) {
+		if (hist[i] == 0)
+			continue;
+		if (first < 0)
+			first = i;
+		last = i;
+		if (hist[i] > peak)
+			peak = hist[i];
+	}
+	if (first < 0)
+		return;
+
+	printf("  %s histogram (cycles):\n", name);
+	for (i = first; i <= last; i++) {
+		int bar = (int)(hist[i] * 40 / peak);
+
+		printf("  %10lu .. %10lu %8lu %5.1f%% ",
+			i ? (1UL << i) : 0UL, (2UL << i) - 1, hist[i],
+			100.0 * hist[i] / cnt);
+		for (j = 0; j < bar; j++)
+			putchar('#');
+		putchar('\n');
+	}
+}
+
+static void add_event(unsigned int irq, unsigned int depth, uint32_t pc,
+		      uint32_t entry, uint32_t exit)
+{
+	struct irq_stat *s = &stats[irq];
+	uint32_t d;
+
+	if (exit == NO_EXIT) {
+		printf("irq %u at pc 0x%08x, entry 0x%08x: no exit (fault or still running)\n",
+			irq, pc, entry);
+	} else {
+		d = exit - entry;
+		if (s->cnt == 0 || d < s->min)
+			s->min = d;
+		if (d > s->max)
+			s->max = d;
+		s->sum += d;
+		s->hist[log2_bucket(d)]++;
+		s->cnt++;
+		if (depth > 1)
+			s->nested++;
+	}
+
+	if (s->has_last) {
+		d = entry - s->last_entry;
+		if (s->icnt == 0 || d < s->imin)
+			s->imin = d;
+		if (d > s->imax)
+			s->imax = d;
+		s->isum += d;
+		s->ihist[log2_bucket(d)]++;
+		s->icnt++;
+	}
+	s->has_last = 1;
+	s->last_entry = entry;
+}
+
+static void report(void)
+{
+	struct irq_stat *s;
+	int i;
+
+	for (i = 0; i < NR_IRQS; i++) {
+		s = &stats[i];
+		if (s->cnt == 0 && s->icnt == 0)
+			continue;
+
+		printf("\nirq %d: %lu events, %lu nested\n", i, s->cnt, s->nested);
+		if (s->cnt) {
+			printf("  handler  min %10u max %10u avg %10llu cycles",
+				s->min, s->max, (unsigned long long)(s->sum / s->cnt));
+			if (clk_hz)
+				printf(" (%.1f / %.1f / %.1f us)",
+					cyc2us(s->min), cyc2us(s->max),
+					cyc2us(s->sum / s->cnt));
+			putchar('\n');
+		}
+		if (s->icnt) {
+			printf("  interval min %10u max %10u avg %10llu cycles",
+				s->imin, s->imax, (unsigned long long)(s->isum / s->icnt));
+			if (clk_hz)
+				printf(" (jitter %.1f us)", cyc2us(s->imax - s->imin));
+			putchar('\n');
+		}
+		if (s->cnt)
+			print_hist("handler", s->hist, s->cnt);
+		if (s->icnt)
+			print_hist("interval", s->ihist, s->icnt);
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	FILE *fr = stdin;
+	char *ifname = NULL;
+	char line[256];
+	unsigned long user_clk = 0;
+	unsigned long cnt;
+	unsigned int seq, irq, depth, pc, entry, exit;
+	int in_dump = 0;
+	int dumps = 0;
+	int c;
+
+	while ((c = getopt_long(argc, argv, short_opts, long_opts, NULL)) != -1) {
+		switch (c) {
+		case 'v':
+			verbose = 1;
+			break;
+		case 'i':
+			if (optarg) {
+				ifname = optarg;
+			}
+			break;
+		case 'c':
+			if (optarg) {
+				user_clk = strtoul(optarg, NULL, 0);
+			}
+			break;
+		default:
+			print_usage(argv[0]);
+			return -1;
+		}
+	}
+
+	if (ifname) {
+		fr = fopen(ifname, "r");
+		if (fr == NULL) {
+			printf("can not open %s!!\n", ifname);
+			return -2;
+		}
+	}
+
+	while (fgets(line, sizeof(line), fr)) {
+		char *p = strstr(line, "IRQTRACE ");
+
+		if (p == NULL)
+			continue;
+		p += strlen("IRQTRACE ");
+
+		if (sscanf(p, "BEGIN %lu %lu", &cnt, &clk_hz) == 2) {
+			/* only the last dump of the log is decoded */
+			memset(stats, 0, sizeof(stats));
+			in_dump = 1;
+			dumps++;
+			continue;
+		}
+		if (strncmp(p, "END", 3) == 0) {
+			in_dump = 0;
+			continue;
+		}
+		if (!in_dump)
+			continue;
+		if (sscanf(p, "%x %u %u %x %x %x",
+			   &seq, &irq, &depth, &pc, &entry, &exit) != 6)
+			continue;
+		if (irq >= NR_IRQS)
+			continue;
+		if (verbose)
+			printf("%08x irq %2u depth %u pc 0x%08x entry 0x%08x exit 0x%08x\n",
+				seq, irq, depth, pc, entry, exit);
+		add_event(irq, depth, pc, entry, exit);
+	}
+
+	if (fr != stdin)
+		fclose(fr);
+
+	if (dumps == 0) {
+		printf("no irq trace found!!\n");
+		return -3;
+	}
+	if (user_clk)
+		clk_hz = user_clk;
+
+	report();
+
+	return 0;
+}
@@ -0,0 +1,563 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ */
+
+/*
+ * convert the kernel trace of hal/ktrace.c into a chrome trace (json),
+ * loaded by chrome://tracing or ui.perfetto.dev
+ *
+ * the trace is read from the console output of ktrace_dump()
+ *
+ * KTRACE BEGIN <count> <clk hz>
+ * KTRACE TASK <tcb> <name>
+ * KTRACE <cycle> <type> <arg> <obj>
+ * KTRACE END
+ *
+ * or from a binary memory dump holding struct ktrace_buf (-m), e.g. the
+ * sram written by the simulation
+ *
+ * tasks are the threads of the "tasks" process, irq lines the threads of the
+ * "irq" process. the ready to running latency of every task and the times a
+ * task ran while a higher priority one was ready are printed to stderr
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <getopt.h>
+
+/* keep in sync with include/ktrace.h */
+#define KTRACE_TASK_CREATE		1
+#define KTRACE_TASK_SWITCHED_IN		2
+#define KTRACE_TASK_SWITCHED_OUT	3
+#define KTRACE_TASK_READY		4
+#define KTRACE_TASK_DELAY		5
+#define KTRACE_TASK_SUSPEND		6
+#define KTRACE_TASK_RESUME		7
+#define KTRACE_TICK			8
+#define KTRACE_IRQ_ENTER		9
+#define KTRACE_IRQ_EXIT			10
+#define KTRACE_QUEUE_CREATE		11
+#define KTRACE_QUEUE_SEND		12
+#define KTRACE_QUEUE_SEND_FAILED	13
+#define KTRACE_QUEUE_RECEIVE		14
+#define KTRACE_QUEUE_RECEIVE_FAILED	15
+#define KTRACE_QUEUE_PEEK		16
+#define KTRACE_QUEUE_BLOCK_SEND		17
+#define KTRACE_QUEUE_BLOCK_RECEIVE	18
+#define KTRACE_QUEUE_SEND_ISR		19
+#define KTRACE_QUEUE_RECEIVE_ISR	20
+#define KTRACE_MUTEX_CREATE		21
+#define KTRACE_QUEUE_DELETE		22
+
+#define KTRACE_MAGIC		0x4352544b
+#define KTRACE_NAME_LEN		16
+/* sizeof(struct ktrace_event), sizeof(struct ktrace_task) of the target */
+#define KTRACE_EVENT_SIZE	12
+#define KTRACE_TASK_SIZE	(4 + KTRACE_NAME_LEN)
+#define KTRACE_HEADER_SIZE	24
+
+#define MAX_TASKS	256
+#define NR_IRQS		32
+#define PID_TASKS	1
+#define PID_IRQ		2
+#define TID_TICK	100
+
+struct event {
+	uint32_t cycle;
+	uint32_t obj;
+	unsigned int type;
+	unsigned int arg;
+};
+
+struct task {
+	uint32_t tcb;
+	char name[64];
+	unsigned int prio;
+	/* ready and not running since ready_ts, -1 if not */
+	double ready_ts;
+	unsigned long runs;
+	double run_us;
+	unsigned long lat_cnt;
+	double lat_sum;
+	double lat_max;
+};
+
+static struct event *events;
+static unsigned long nevents;
+static struct task tasks[MAX_TASKS];
+static int ntasks;
+static unsigned long clk_hz;
+static FILE *fw;
+static int first_json = 1;
+
+static const char short_opts[] = "+i:m:o:c:";
+static const struct option long_opts[] = {
+	{ "if",   required_argument, NULL, 'i' },
+	{ "mem",  required_argument, NULL, 'm' },
+	{ "of",   required_argument, NULL, 'o' },
+	{ "clk",  required_argument, NULL, 'c' },
+	{ NULL,   no_argument,       NULL, 0 }
+};
+
+static void print_usage(char *prog)
+{
+	printf("USAGE (convert a kernel trace to chrome trace json):\n");
+	printf("%s [-c clk_hz] [-i console.log | -m memory.bin] [-o trace.json]\n", prog);
+}
+
+static void add_event(uint32_t cycle, unsigned int type, unsigned int arg, uint32_t obj)
+{
+	static unsigned long size;
+
+	if (nevents == size) {
+		size = size ? size * 2 : 4096;
+		events = realloc(events, size * sizeof(*events));
+		if (events == NULL) {
+			printf("out of memory!!\n");
+			exit(-4);
+		}
+	}
+	events[nevents].cycle = cycle;
+	events[nevents].type = type;
+	events[nevents].arg = arg;
+	events[nevents].obj = obj;
+	nevents++;
+}
+
+static struct task *get_task(uint32_t tcb)
+{
+	struct task *t;
+	int i;
+
+	for (i = 0; i < ntasks; i++)
+		if (tasks[i].tcb == tcb)
+			return &tasks[i];
+	if (ntasks == MAX_TASKS)
+		return &tasks[MAX_TASKS - 1];
+
+	t = &tasks[ntasks++];
+	memset(t, 0, sizeof(*t));
+	t->tcb = tcb;
+	snprintf(t->name, sizeof(t->name), "task_%08x", tcb);
+	t->ready_ts = -1;
+	return t;
+}
+
+static int tid_of(struct task *t)
+{
+	return (int)(t - tasks) + 1;
+}
+
+static int read_log(FILE *fr)
+{
+	char line[256];
+	unsigned long cnt;
+	unsigned int cycle, type, arg, obj;
+	char name[64];
+	int in_dump = 0;
+	int dumps = 0;
+
+	while (fgets(line, sizeof(line), fr)) {
+		char *p = strstr(line, "KTRACE ");
+
+		if (p == NULL)
+			continue;
+		p += strlen("KTRACE ");
+
+		if (sscanf(p, "BEGIN %lu %lu", &cnt, &clk_hz) == 2) {
+			/* only the last dump of the log is converted */
+			nevents = 0;
+			ntasks = 0;
+			in_dump = 1;
+			dumps++;
+			continue;
+		}
+		if (strncmp(p, "END", 3) == 0) {
+			in_dump = 0;
+			continue;
+		}
+		if (!in_dump)
+			continue;
+		if (sscanf(p, "TASK %x %63s", &obj, name) == 2) {
+			strcpy(get_task(obj)->name, name);
+			continue;
+		}
+		if (sscanf(p, "%x %u %u %x", &cycle, &type, &arg, &obj) != 4)
+			continue;
+		add_event(cycle, type, arg, obj);
+	}
+
+	return dumps;
+}
+
+static uint32_t get_le32(const unsigned char *p)
+{
+	return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static int read_mem(const char *fname)
+{
+	FILE *fr;
+	unsigned char *buf, *p, *ev;
+	long size, off;
+	uint32_t entries, max_tasks, seq, nt, cnt, i;
+
+	fr = fopen(fname, "rb");
+	if (fr == NULL) {
+		printf("can not open %s!!\n", fname);
+		return -2;
+	}
+	fseek(fr, 0, SEEK_END);
+	size = ftell(fr);
+	fseek(fr, 0, SEEK_SET);
+	buf = malloc(size);
+	if (buf == NULL || fread(buf, 1, size, fr) != (size_t)size) {
+		printf("can not read %s!!\n", fname);
+		fclose(fr);
+		return -2;
+	}
+	fclose(fr);
+
+	for (off = 0; off + KTRACE_HEADER_SIZE <= size; off += 4) {
+		p = buf + off;
+		if (get_le32(p) != KTRACE_MAGIC)
+			continue;
+		entries = get_le32(p + 4);
+		max_tasks = get_le32(p + 8);
+		/* the magic alone may also be found in the code */
+		if (entries == 0 || (entries & (entries - 1)) != 0 || max_tasks > MAX_TASKS)
+			continue;
+		if (off + KTRACE_HEADER_SIZE + (long)max_tasks * KTRACE_TASK_SIZE +
+		    (long)entries * KTRACE_EVENT_SIZE > size)
+			continue;
+
+		clk_hz = get_le32(p + 12);
+		seq = get_le32(p + 16);
+		nt = get_le32(p + 20);
+		if (nt > max_tasks)
+			nt = max_tasks;
+
+		p += KTRACE_HEADER_SIZE;
+		for (i = 0; i < nt; i++) {
+			char name[KTRACE_NAME_LEN + 1];
+
+			memcpy(name, p + i * KTRACE_TASK_SIZE + 4, KTRACE_NAME_LEN);
+			name[KTRACE_NAME_LEN] = '\0';
+			strcpy(get_task(get_le32(p + i * KTRACE_TASK_SIZE))->name, name);
+		}
+
+		ev = p + max_tasks * KTRACE_TASK_SIZE;
+		cnt = (seq < entries) ? seq : entries;
+		for (i = seq - cnt; i != seq; i++) {
+			p = ev + (i & (entries - 1)) * KTRACE_EVENT_SIZE;
+			add_event(get_le32(p), p[8], p[9], get_le32(p + 4));
+		}
+		free(buf);
+		return 1;
+	}
+
+	free(buf);
+	return 0;
+}
+
+static void json_begin(void)
+{
+	if (!first_json)
+		fprintf(fw, ",\n");
+	first_json = 0;
+}
+
+static void json_name(int pid, int tid, const char *what, const char *name)
+{
+	json_begin();
+	if (tid < 0)
+		fprintf(fw, "{\"ph\":\"M\",\"pid\":%d,\"name\":\"%s\",\"args\":{\"name\":\"%s\"}}",
+			pid, what, name);
+	else
+		fprintf(fw, "{\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"name\":\"%s\",\"args\":{\"name\":\"%s\"}}",
+			pid, tid, what, name);
+}
+
+static void json_slice(int pid, int tid, const char *name, double ts, double dur, const char *args)
+{
+	json_begin();
+	fprintf(fw, "{\"ph\":\"X\",\"pid\":%d,\"tid\":%d,\"name\":\"%s\",\"ts\":%.3f,\"dur\":%.3f%s%s%s}",
+		pid, tid, name, ts, dur, args ? ",\"args\":{" : "", args ? args : "", args ? "}" : "");
+}
+
+static void json_instant(int pid, int tid, const char *name, double ts, const char *args)
+{
+	json_begin();
+	fprintf(fw, "{\"ph\":\"i\",\"s\":\"t\",\"pid\":%d,\"tid\":%d,\"name\":\"%s\",\"ts\":%.3f%s%s%s}",
+		pid, tid, name, ts, args ? ",\"args\":{" : "", args ? args : "", args ? "}" : "");
+}
+
+static const char *queue_event_name(unsigned int type)
+{
+	switch (type) {
+	case KTRACE_QUEUE_CREATE:		return "queue create";
+	case KTRACE_QUEUE_SEND:			return "queue send";
+	case KTRACE_QUEUE_SEND_FAILED:		return "queue send failed";
+	case KTRACE_QUEUE_RECEIVE:		return "queue receive";
+	case KTRACE_QUEUE_RECEIVE_FAILED:	return "queue receive failed";
+	case KTRACE_QUEUE_PEEK:			return "queue peek";
+	case KTRACE_QUEUE_BLOCK_SEND:		return "block on send";
+	case KTRACE_QUEUE_BLOCK_RECEIVE:	return "block on receive";
+	case KTRACE_QUEUE_SEND_ISR:		return "queue send from isr";
+	case KTRACE_QUEUE_RECEIVE_ISR:		return "queue receive from isr";
+	case KTRACE_MUTEX_CREATE:		return "mutex create";
+	case KTRACE_QUEUE_DELETE:		return "queue delete";
+	default:				return NULL;
+	}
+}
+
+static void convert(void)
+{
+	struct task *cur = NULL, *t;
+	double irq_entry[NR_IRQS];
+	int irq_seen[NR_IRQS];
+	int irq_stack[NR_IRQS];
+	int depth = 0;
+	unsigned long inversions = 0;
+	uint64_t now = 0;
+	uint32_t last = 0;
+	double ts = 0, slice_start = 0, lat;
+	char args[128];
+	const char *name;
+	unsigned long i;
+	int j;
+
+	memset(irq_seen, 0, sizeof(irq_seen));
+
+	fprintf(fw, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+	json_name(PID_TASKS, -1, "process_name", "tasks");
+	json_name(PID_IRQ, -1, "process_name", "irq");
+	json_name(PID_IRQ, TID_TICK, "thread_name", "tick");
+
+	for (i = 0; i < nevents; i++) {
+		struct event *e = &events[i];
+
+		/* the 32-bit cycle counter wraps, the events are in order */
+		if (i)
+			now += (uint32_t)(e->cycle - last);
+		last = e->cycle;
+		ts = (double)now * 1000000.0 / (double)clk_hz;
+
+		switch (e->type) {
+		case KTRACE_TASK_CREATE:
+			t = get_task(e->obj);
+			t->prio = e->arg;
+			json_instant(PID_TASKS, tid_of(t), "create", ts, NULL);
+			break;
+
+		case KTRACE_TASK_READY:
+			t = get_task(e->obj);
+			t->prio = e->arg;
+			if (t != cur && t->ready_ts < 0)
+				t->ready_ts = ts;
+			break;
+
+		case KTRACE_TASK_SWITCHED_IN:
+			t = get_task(e->obj);
+			t->prio = e->arg;
+			/* also at every tick, the same task is switched in */
+			if (t == cur)
+				break;
+
+			if (cur) {
+				snprintf(args, sizeof(args), "\"prio\":%u", cur->prio);
+				json_slice(PID_TASKS, tid_of(cur), cur->name, slice_start, ts - slice_start, args);
+				cur->run_us += ts - slice_start;
+			}
+			if (t->ready_ts >= 0) {
+				lat = ts - t->ready_ts;
+				t->lat_cnt++;
+				t->lat_sum += lat;
+				if (lat > t->lat_max)
+					t->lat_max = lat;
+				t->ready_ts = -1;
+			}
+			/* a higher priority task is kept waiting */
+			for (j = 0; j < ntasks; j++) {
+				if (&tasks[j] == t || tasks[j].ready_ts < 0 || tasks[j].prio <= t->prio)
+					continue;
+				snprintf(args, sizeof(args), "\"waiting\":\"%s\",\"running\":\"%s\"",
+					tasks[j].name, t->name);
+				json_instant(PID_TASKS, tid_of(&tasks[j]), "priority inversion", ts, args);
+				inversions++;
+			}
+			t->runs++;
+			cur = t;
+			slice_start = ts;
+			break;
+
+		case KTRACE_TASK_SWITCHED_OUT:
+			break;
+
+		case KTRACE_TASK_DELAY:
+			json_instant(PID_TASKS, tid_of(get_task(e->obj)), "delay", ts, NULL);
+			break;
+
+		case KTRACE_TASK_SUSPEND:
+			t = get_task(e->obj);
+			t->ready_ts = -1;
+			json_instant(PID_TASKS, tid_of(t), "suspend", ts, NULL);
+			break;
+
+		case KTRACE_TASK_RESUME:
+			json_instant(PID_TASKS, tid_of(get_task(e->obj)), "resume", ts, NULL);
+			break;
+
+		case KTRACE_TICK:
+			snprintf(args, sizeof(args), "\"count\":%u", e->obj);
+			json_instant(PID_IRQ, TID_TICK, "tick", ts, args);
+			break;
+
+		case KTRACE_IRQ_ENTER:
+			if (e->arg >= NR_IRQS)
+				break;
+			if (!irq_seen[e->arg]) {
+				snprintf(args, sizeof(args), "irq %u", e->arg);
+				json_name(PID_IRQ, e->arg, "thread_name", args);
+				irq_seen[e->arg] = 1;
+			}
+			irq_entry[e->arg] = ts;
+			if (depth < NR_IRQS)
+				irq_stack[depth++] = e->arg;
+			break;
+
+		case KTRACE_IRQ_EXIT:
+			if (e->arg >= NR_IRQS || !irq_seen[e->arg])
+				break;
+			snprintf(args, sizeof(args), "irq %u", e->arg);
+			json_slice(PID_IRQ, e->arg, args, irq_entry[e->arg], ts - irq_entry[e->arg], NULL);
+			if (depth)
+				depth--;
+			break;
+
+		default:
+			name = queue_event_name(e->type);
+			if (name == NULL)
+				break;
+			snprintf(args, sizeof(args), "\"queue\":\"0x%08x\"", e->obj);
+			if (e->type == KTRACE_QUEUE_SEND_ISR || e->type == KTRACE_QUEUE_RECEIVE_ISR)
+				json_instant(PID_IRQ, depth ? irq_stack[depth - 1] : 0, name, ts, args);
+			else if (cur)
+				json_instant(PID_TASKS, tid_of(cur), name, ts, args);
+			break;
+		}
+	}
+
+	if (cur && nevents) {
+		snprintf(args, sizeof(args), "\"prio\":%u", cur->prio);
+		json_slice(PID_TASKS, tid_of(cur), cur->name, slice_start, ts - slice_start, args);
+		cur->run_us += ts - slice_start;
+	}
+
+	for (j = 0; j < ntasks; j++) {
+		snprintf(args, sizeof(args), "%s (%u)", tasks[j].name, tasks[j].prio);
+		json_name(PID_TASKS, tid_of(&tasks[j]), "thread_name", args);
+	}
+	fprintf(fw, "\n]}\n");
+
+	fprintf(stderr, "%lu events, %.1f us\n", nevents, ts);
+	fprintf(stderr, "%-16s %4s %8s %12s %12s %12s\n",
+		"TASK", "PRIO", "RUNS", "RUN us", "LAT avg us", "LAT max us");
+	for (j = 0; j < ntasks; j++) {
+		t = &tasks[j];
+		fprintf(stderr, "%-16s %4u %8lu %12.1f %12.1f %12.1f\n",
+			t->name, t->prio, t->runs, t->run_us,
+			t->lat_cnt ? t->lat_sum / t->lat_cnt : 0.0, t->lat_max);
+	}
+	if (inversions)
+		fprintf(stderr, "%lu switches to a task while a higher priority one was ready\n",
+			inversions);
+}
+
+int main(int argc, char *argv[])
+{
+	FILE *fr = stdin;
+	char *ifname = NULL;
+	char *mfname = NULL;
+	char *ofname = NULL;
+	unsigned long user_clk = 0;
+	int found;
+	int c;
+
+	while ((c = getopt_long(argc, argv, short_opts, long_opts, NULL)) != -1) {
+		switch (c) {
+		case 'i':
+			if (optarg) {
+				ifname = optarg;
+			}
+			break;
+		case 'm':
+			if (optarg) {
+				mfname = optarg;
+			}
+			break;
+		case 'o':
+			if (optarg) {
+				ofname = optarg;
+			}
+			break;
+		case 'c':
+			if (optarg) {
+				user_clk = strtoul(optarg, NULL, 0);
+			}
+			break;
+		default:
+			print_usage(argv[0]);
+			return -1;
+		}
+	}
+
+	if (mfname) {
+		found = read_mem(mfname);
+		if (found < 0)
+			return found;
+	} else {
+		if (ifname) {
+			fr = fopen(ifname, "r");
+			if (fr == NULL) {
+				printf("can not open %s!!\n", ifname);
+				return -2;
+			}
+		}
+		found = read_log(fr);
+		if (fr != stdin)
+			fclose(fr);
+	}
+
+	if (found == 0) {
+		printf("no kernel trace found!!\n");
+		return -3;
+	}
+	if (user_clk)
+		clk_hz = user_clk;
+	if (clk_hz == 0) {
+		printf("unknown clock, use -c!!\n");
+		return -3;
+	}
+
+	fw = stdout;
+	if (ofname) {
+		fw = fopen(ofname, "w");
+		if (fw == NULL) {
+			printf("can not open %s!!\n", ofname);
+			return -2;
+		}
+	}
+
+	convert();
+
+	if (fw != stdout)
+		fclose(fw);
+
+	return 0;
+}
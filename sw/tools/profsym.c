@@ -0,0 +1,402 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ */
+
+/*
+ * symbolise the pc sampling profile of hal/profile.c and print a flat profile
+ *
+ * the histogram is read from the console output of profile_dump()
+ *
+ * PROF BEGIN <samples> <dropped>
+ * PROF TASK <index> <name>
+ * PROF <pc> <task index> <count>
+ * PROF END
+ *
+ * the symbols come from System.map (nm output) or the symbol table of the elf
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <getopt.h>
+#include <elf.h>
+
+#define MAX_TASKS	256
+/* see PROFILE_NO_TASK */
+#define NO_TASK		0xff
+
+struct sample {
+	uint32_t pc;
+	unsigned int task;
+	unsigned long count;
+};
+
+struct symbol {
+	uint32_t addr;
+	char *name;
+	unsigned long count;
+};
+
+static struct sample *samples;
+static unsigned long nsamples;
+static struct symbol *syms;
+static unsigned long nsyms;
+static char task_names[MAX_TASKS][64];
+static unsigned long total, dropped;
+
+static const char short_opts[] = "+i:s:e:n:t";
+static const struct option long_opts[] = {
+	{ "if",     required_argument, NULL, 'i' },
+	{ "map",    required_argument, NULL, 's' },
+	{ "elf",    required_argument, NULL, 'e' },
+	{ "num",    required_argument, NULL, 'n' },
+	{ "task",   no_argument,       NULL, 't' },
+	{ NULL,     no_argument,       NULL, 0 }
+};
+
+static void print_usage(char *prog)
+{
+	printf("USAGE (symbolise a pc sampling profile):\n");
+	printf("%s (-s System.map | -e os.elf) [-i console.log] [-n lines] [-t]\n", prog);
+	printf("  -t: a profile per task\n");
+}
+
+static void *grow(void *p, unsigned long n, unsigned long *size, size_t elem)
+{
+	if (n < *size)
+		return p;
+	*size = *size ? *size * 2 : 1024;
+	p = realloc(p, *size * elem);
+	if (p == NULL) {
+		printf("out of memory!!\n");
+		exit(-4);
+	}
+	return p;
+}
+
+static void add_symbol(uint32_t addr, const char *name)
+{
+	static unsigned long size;
+
+	syms = grow(syms, nsyms, &size, sizeof(*syms));
+	syms[nsyms].addr = addr;
+	syms[nsyms].name = strdup(name);
+	syms[nsyms].count = 0;
+	nsyms++;
+}
+
+static int read_map(const char *fname)
+{
+	FILE *fr;
+	char line[256], name[200];
+	unsigned int addr;
+	char type;
+
+	fr = fopen(fname, "r");
+	if (fr == NULL) {
+		printf("can not open %s!!\n", fname);
+		return -2;
+	}
+	while (fgets(line, sizeof(line), fr)) {
+		if (sscanf(line, "%x %c %199s", &addr, &type, name) != 3)
+			continue;
+		/* code only */
+		if (type != 'T' && type != 't' && type != 'W' && type != 'w')
+			continue;
+		add_symbol(addr, name);
+	}
+	fclose(fr);
+
+	return 0;
+}
+
+static int read_elf(const char *fname)
+{
+	FILE *fr;
+	unsigned char *buf;
+	Elf32_Ehdr *eh;
+	Elf32_Shdr *sh, *symtab, *strtab, *sec;
+	Elf32_Sym *sym;
+	long size;
+	unsigned int i, n;
+
+	fr = fopen(fname, "rb");
+	if (fr == NULL) {
+		printf("can not open %s!!\n", fname);
+		return -2;
+	}
+	fseek(fr, 0, SEEK_END);
+	size = ftell(fr);
+	fseek(fr, 0, SEEK_SET);
+	buf = malloc(size);
+	if (buf == NULL || fread(buf, 1, size, fr) != (size_t)size) {
+		printf("can not read %s!!\n", fname);
+		fclose(fr);
+		return -2;
+	}
+	fclose(fr);
+
+	/* the host is little endian like the target */
+	eh = (Elf32_Ehdr *)buf;
+	if (size < (long)sizeof(*eh) || memcmp(eh->e_ident, ELFMAG, SELFMAG) ||
+	    eh->e_ident[EI_CLASS] != ELFCLASS32 || eh->e_ident[EI_DATA] != ELFDATA2LSB) {
+		printf("%s is not a 32-bit little endian elf!!\n", fname);
+		return -2;
+	}
+
+	sh = (Elf32_Shdr *)(buf + eh->e_shoff);
+	symtab = NULL;
+	for (i = 0; i < eh->e_shnum; i++)
+		if (sh[i].sh_type == SHT_SYMTAB)
+			symtab = &sh[i];
+	if (symtab == NULL) {
+		printf("no symbol table in %s!!\n", fname);
+		return -2;
+	}
+	strtab = &sh[symtab->sh_link];
+
+	sym = (Elf32_Sym *)(buf + symtab->sh_offset);
+	n = symtab->sh_size / sizeof(*sym);
+	for (i = 0; i < n; i++) {
+		unsigned int type = ELF32_ST_TYPE(sym[i].st_info);
+
+		if (sym[i].st_shndx == SHN_UNDEF || sym[i].st_shndx >= eh->e_shnum)
+			continue;
+		/* functions and the labels of the assembly code */
+		if (type != STT_FUNC && type != STT_NOTYPE)
+			continue;
+		sec = &sh[sym[i].st_shndx];
+		if (!(sec->sh_flags & SHF_EXECINSTR))
+			continue;
+		add_symbol(sym[i].st_value, (char *)buf + strtab->sh_offset + sym[i].st_name);
+	}
+	free(buf);
+
+	return 0;
+}
+
+static int cmp_sym_addr(const void *a, const void *b)
+{
+	const struct symbol *x = a, *y = b;
+
+	if (x->addr != y->addr)
+		return x->addr < y->addr ? -1 : 1;
+	return strcmp(x->name, y->name);
+}
+
+static int cmp_sym_count(const void *a, const void *b)
+{
+	const struct symbol *x = a, *y = b;
+
+	if (x->count != y->count)
+		return x->count > y->count ? -1 : 1;
+	return x->addr < y->addr ? -1 : 1;
+}
+
+/* the symbol with the highest address <= pc */
+static struct symbol *find_symbol(uint32_t pc)
+{
+	unsigned long lo = 0, hi = nsyms;
+
+	if (nsyms == 0 || pc < syms[0].addr)
+		return NULL;
+	while (hi - lo > 1) {
+		unsigned long mid = (lo + hi) / 2;
+
+		if (syms[mid].addr <= pc)
+			lo = mid;
+		else
+			hi = mid;
+	}
+	return &syms[lo];
+}
+
+static int read_log(FILE *fr)
+{
+	static unsigned long size;
+	char line[256];
+	char name[64];
+	unsigned int pc, task;
+	unsigned long count;
+	int in_dump = 0;
+	int dumps = 0;
+
+	while (fgets(line, sizeof(line), fr)) {
+		char *p = strstr(line, "PROF ");
+
+		if (p == NULL)
+			continue;
+		p += strlen("PROF ");
+
+		if (sscanf(p, "BEGIN %lu %lu", &total, &dropped) == 2) {
+			/* only the last dump of the log is used */
+			nsamples = 0;
+			memset(task_names, 0, sizeof(task_names));
+			in_dump = 1;
+			dumps++;
+			continue;
+		}
+		if (strncmp(p, "END", 3) == 0) {
+			in_dump = 0;
+			continue;
+		}
+		if (!in_dump)
+			continue;
+		if (sscanf(p, "TASK %u %63s", &task, name) == 2) {
+			if (task < MAX_TASKS)
+				strcpy(task_names[task], name);
+			continue;
+		}
+		if (sscanf(p, "%x %u %lu", &pc, &task, &count) != 3)
+			continue;
+		samples = grow(samples, nsamples, &size, sizeof(*samples));
+		samples[nsamples].pc = pc;
+		samples[nsamples].task = task;
+		samples[nsamples].count = count;
+		nsamples++;
+	}
+
+	return dumps;
+}
+
+/* the flat profile of one task, or of every task for task < 0 */
+static void print_profile(int task, unsigned long lines)
+{
+	struct symbol *sorted;
+	struct symbol *s;
+	unsigned long sum = 0, unknown = 0, cum = 0, i;
+
+	for (i = 0; i < nsyms; i++)
+		syms[i].count = 0;
+	for (i = 0; i < nsamples; i++) {
+		if (task >= 0 && samples[i].task != (unsigned int)task)
+			continue;
+		s = find_symbol(samples[i].pc);
+		if (s)
+			s->count += samples[i].count;
+		else
+			unknown += samples[i].count;
+		sum += samples[i].count;
+	}
+	if (sum == 0)
+		return;
+
+	sorted = malloc(nsyms * sizeof(*sorted));
+	if (sorted == NULL) {
+		printf("out of memory!!\n");
+		exit(-4);
+	}
+	memcpy(sorted, syms, nsyms * sizeof(*sorted));
+	qsort(sorted, nsyms, sizeof(*sorted), cmp_sym_count);
+
+	printf("%7s %7s %9s  %s\n", "%", "cum %", "samples", "function");
+	for (i = 0; i < nsyms && i < lines && sorted[i].count; i++) {
+		cum += sorted[i].count;
+		printf("%7.2f %7.2f %9lu  %s\n", 100.0 * sorted[i].count / sum,
+			100.0 * cum / sum, sorted[i].count, sorted[i].name);
+	}
+	if (unknown)
+		printf("%7.2f %7s %9lu  (unknown)\n", 100.0 * unknown / sum, "", unknown);
+	free(sorted);
+}
+
+int main(int argc, char *argv[])
+{
+	FILE *fr = stdin;
+	char *ifname = NULL;
+	char *mapname = NULL;
+	char *elfname = NULL;
+	unsigned long lines = 30;
+	unsigned long sum;
+	int per_task = 0;
+	unsigned long i;
+	int task;
+	int ret;
+	int c;
+
+	while ((c = getopt_long(argc, argv, short_opts, long_opts, NULL)) != -1) {
+		switch (c) {
+		case 'i':
+			if (optarg) {
+				ifname = optarg;
+			}
+			break;
+		case 's':
+			if (optarg) {
+				mapname = optarg;
+			}
+			break;
+		case 'e':
+			if (optarg) {
+				elfname = optarg;
+			}
+			break;
+		case 'n':
+			if (optarg) {
+				lines = strtoul(optarg, NULL, 0);
+			}
+			break;
+		case 't':
+			per_task = 1;
+			break;
+		default:
+			print_usage(argv[0]);
+			return -1;
+		}
+	}
+
+	if (mapname)
+		ret = read_map(mapname);
+	else if (elfname)
+		ret = read_elf(elfname);
+	else {
+		print_usage(argv[0]);
+		return -1;
+	}
+	if (ret)
+		return ret;
+	qsort(syms, nsyms, sizeof(*syms), cmp_sym_addr);
+
+	if (ifname) {
+		fr = fopen(ifname, "r");
+		if (fr == NULL) {
+			printf("can not open %s!!\n", ifname);
+			return -2;
+		}
+	}
+	ret = read_log(fr);
+	if (fr != stdin)
+		fclose(fr);
+	if (ret == 0) {
+		printf("no profile found!!\n");
+		return -3;
+	}
+
+	printf("%lu samples, %lu dropped (hash table full)\n\n", total, dropped);
+	print_profile(-1, lines);
+
+	if (!per_task)
+		return 0;
+
+	for (task = 0; task < MAX_TASKS; task++) {
+		sum = 0;
+		for (i = 0; i < nsamples; i++)
+			if (samples[i].task == (unsigned int)task)
+				sum += samples[i].count;
+		if (sum == 0)
+			continue;
+		if (task == NO_TASK)
+			printf("\nno task, %lu samples\n", sum);
+		else if (task_names[task][0])
+			printf("\ntask %s, %lu samples\n", task_names[task], sum);
+		else
+			printf("\ntask %d, %lu samples\n", task, sum);
+		print_profile(task, lines);
+	}
+
+	return 0;
+}
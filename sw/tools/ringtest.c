@@ -0,0 +1,290 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ */
+
+/*
+ * host stress test of lib/ring.c of the firmware
+ *
+ * spsc: one producer thread and one consumer thread pass sequence numbers
+ * through a small ring, both sides switch between the copy calls and the
+ * zero copy peek/commit calls and use batches of random size, so the
+ * indexes wrap all the time. every entry read must be the next number
+ *
+ * mp: several producer threads use ring_mp_enqueue(), each entry holds the
+ * producer and its own sequence number. the consumer checks the numbers of
+ * every producer follow each other and that all of them arrived
+ *
+ * the firmware masks irq where host/system.h takes a lock, and every
+ * barrier() in ring.c gives the cpu away now and then, see there
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <getopt.h>
+#include <pthread.h>
+#include <sched.h>
+#include <system.h>
+#include <ring.h>
+
+#define RING_ENTRIES	64
+#define MAX_BATCH	24
+#define MAX_PRODUCERS	16
+
+pthread_mutex_t host_irq_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static unsigned long count = 1000000;
+static int producers = 4;
+static unsigned int preempt_mask = 15;
+static int verbose;
+
+static const char short_opts[] = "+vn:p:y:";
+static const struct option long_opts[] = {
+	{ "verbose",   no_argument,       NULL, 'v' },
+	{ "count",     required_argument, NULL, 'n' },
+	{ "producers", required_argument, NULL, 'p' },
+	{ "yield",     required_argument, NULL, 'y' },
+	{ NULL,        no_argument,       NULL, 0 }
+};
+
+static void print_usage(char *prog)
+{
+	printf("USAGE (stress lib/ring.c with threads):\n");
+	printf("%s [-v] [-n entries] [-p producers] [-y log2 barriers per yield]\n", prog);
+}
+
+/* called by every barrier() of ring.c */
+void host_preempt_point(void)
+{
+	static __thread unsigned int seed = 1;
+
+	if (preempt_mask == 0)
+		return;
+	seed = seed * 1103515245 + 12345;
+	if (((seed >> 16) & preempt_mask) == 0)
+		sched_yield();
+}
+
+static unsigned int batch(unsigned int *seed)
+{
+	*seed = *seed * 1103515245 + 12345;
+	return 1 + (*seed >> 16) % MAX_BATCH;
+}
+
+/* spsc */
+
+static struct ring spsc_ring;
+static uint32_t spsc_buf[RING_ENTRIES];
+static unsigned long spsc_errors;
+
+static void *spsc_producer(void *arg)
+{
+	uint32_t src[MAX_BATCH];
+	unsigned long seq = 0;
+	unsigned int seed = 1, n, i, sent, avail;
+	uint32_t *p;
+
+	(void)arg;
+	while (seq < count) {
+		n = batch(&seed);
+		if (n > count - seq)
+			n = count - seq;
+		if (seed & 0x100) {
+			for (i = 0; i < n; i++)
+				src[i] = seq + i;
+			sent = ring_enqueue(&spsc_ring, src, n);
+		} else {
+			p = ring_write_peek(&spsc_ring, &avail);
+			if (n > avail)
+				n = avail;
+			for (i = 0; i < n; i++)
+				p[i] = seq + i;
+			ring_write_commit(&spsc_ring, n);
+			sent = n;
+		}
+		seq += sent;
+		if (sent == 0)
+			sched_yield();
+	}
+	return NULL;
+}
+
+static void *spsc_consumer(void *arg)
+{
+	uint32_t dst[MAX_BATCH];
+	unsigned long seq = 0;
+	unsigned int seed = 2, n, i, avail;
+	uint32_t *p;
+
+	(void)arg;
+	while (seq < count) {
+		n = batch(&seed);
+		if (seed & 0x100) {
+			n = ring_dequeue(&spsc_ring, dst, n);
+			p = dst;
+		} else {
+			p = ring_read_peek(&spsc_ring, &avail);
+			if (n > avail)
+				n = avail;
+		}
+		for (i = 0; i < n; i++) {
+			if (p[i] != (uint32_t)(seq + i)) {
+				if (verbose || spsc_errors == 0)
+					printf("spsc: read %u expected %u\n",
+						p[i], (uint32_t)(seq + i));
+				spsc_errors++;
+			}
+		}
+		if (p != dst)
+			ring_read_commit(&spsc_ring, n);
+		seq += n;
+		if (n == 0)
+			sched_yield();
+	}
+	return NULL;
+}
+
+/* mp */
+
+struct mp_entry {
+	uint32_t producer;
+	uint32_t seq;
+};
+
+static struct ring mp_ring;
+static struct mp_entry mp_buf[RING_ENTRIES];
+static unsigned long mp_errors;
+static volatile int mp_done;
+
+static void *mp_producer(void *arg)
+{
+	struct mp_entry src[MAX_BATCH];
+	uint32_t id = (uintptr_t)arg;
+	unsigned long seq = 0;
+	unsigned long my_count = count / producers;
+	unsigned int seed = 3 + id, n, i, sent;
+
+	while (seq < my_count) {
+		n = batch(&seed);
+		if (n > my_count - seq)
+			n = my_count - seq;
+		for (i = 0; i < n; i++) {
+			src[i].producer = id;
+			src[i].seq = seq + i;
+		}
+		sent = ring_mp_enqueue(&mp_ring, src, n);
+		seq += sent;
+		if (sent == 0)
+			sched_yield();
+	}
+	__sync_fetch_and_add(&mp_done, 1);
+	return NULL;
+}
+
+static void *mp_consumer(void *arg)
+{
+	struct mp_entry dst[MAX_BATCH];
+	unsigned long next[MAX_PRODUCERS];
+	unsigned long total = (count / producers) * producers;
+	unsigned long got = 0;
+	unsigned int seed = 4, n, i;
+	int j;
+
+	(void)arg;
+	memset(next, 0, sizeof(next));
+	while (got < total) {
+		n = ring_dequeue(&mp_ring, dst, batch(&seed));
+		for (i = 0; i < n; i++) {
+			j = dst[i].producer;
+			if (j >= producers || dst[i].seq != next[j]) {
+				if (verbose || mp_errors == 0)
+					printf("mp: producer %u seq %u expected %lu\n",
+						dst[i].producer, dst[i].seq,
+						j < producers ? next[j] : 0);
+				mp_errors++;
+			}
+			if (j < producers)
+				next[j] = dst[i].seq + 1;
+		}
+		got += n;
+		if (n == 0) {
+			/* entries lost by the producers never come */
+			if (mp_done == producers && ring_empty(&mp_ring))
+				break;
+			sched_yield();
+		}
+	}
+	for (j = 0; j < producers; j++) {
+		if (next[j] != count / producers) {
+			printf("mp: producer %d ended at %lu of %lu\n",
+				j, next[j], count / producers);
+			mp_errors++;
+		}
+	}
+	return NULL;
+}
+
+int main(int argc, char *argv[])
+{
+	pthread_t prod[MAX_PRODUCERS], cons;
+	int c, i;
+
+	while ((c = getopt_long(argc, argv, short_opts, long_opts, NULL)) != -1) {
+		switch (c) {
+		case 'v':
+			verbose = 1;
+			break;
+		case 'n':
+			if (optarg) {
+				count = strtoul(optarg, NULL, 0);
+			}
+			break;
+		case 'p':
+			if (optarg) {
+				producers = atoi(optarg);
+			}
+			break;
+		case 'y':
+			if (optarg) {
+				c = atoi(optarg);
+				preempt_mask = c > 0 ? (1u << c) - 1 : 0;
+			}
+			break;
+		default:
+			print_usage(argv[0]);
+			return -1;
+		}
+	}
+	if (producers < 1 || producers > MAX_PRODUCERS) {
+		printf("1 to %d producers\n", MAX_PRODUCERS);
+		return -1;
+	}
+
+	ring_init(&spsc_ring, spsc_buf, RING_ENTRIES, sizeof(spsc_buf[0]));
+	pthread_create(&prod[0], NULL, spsc_producer, NULL);
+	pthread_create(&cons, NULL, spsc_consumer, NULL);
+	pthread_join(prod[0], NULL);
+	pthread_join(cons, NULL);
+	printf("spsc: %lu entries, %lu errors\n", count, spsc_errors);
+
+	ring_init(&mp_ring, mp_buf, RING_ENTRIES, sizeof(mp_buf[0]));
+	for (i = 0; i < producers; i++)
+		pthread_create(&prod[i], NULL, mp_producer, (void *)(uintptr_t)i);
+	pthread_create(&cons, NULL, mp_consumer, NULL);
+	for (i = 0; i < producers; i++)
+		pthread_join(prod[i], NULL);
+	pthread_join(cons, NULL);
+	printf("mp: %d producers, %lu entries, %lu errors\n", producers,
+		(count / producers) * producers, mp_errors);
+
+	if (spsc_errors || mp_errors) {
+		printf("ringtest: FAIL\n");
+		return 1;
+	}
+	printf("ringtest: PASS\n");
+	return 0;
+}